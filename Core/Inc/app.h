@@ -0,0 +1,35 @@
+/* =================================================================
+ * سیم‌کشی تسک‌های برنامه روی زمان‌بند
+ *
+ * جدا از main.c تا بیلد host هم دقیقاً همین تسک‌ها را اجرا کند.
+ * ================================================================= */
+
+#ifndef __APP_H
+#define __APP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+/* دوره و deadline تسک‌ها (ms) */
+#define TASK_KEYPAD_PERIOD      KEYPAD_SAMPLE_PERIOD
+#define TASK_KEYPAD_DEADLINE    5
+#define TASK_SENSORS_PERIOD     10
+#define TASK_SENSORS_DEADLINE   5
+#define TASK_LCD_PERIOD         10
+#define TASK_LCD_DEADLINE       20
+#define TASK_PROFILE_DEADLINE   50
+#define TASK_STORAGE_PERIOD     10
+#define TASK_STORAGE_DEADLINE   20
+#define TASK_INTEGRITY_PERIOD   20
+#define TASK_INTEGRITY_DEADLINE 50
+
+void App_StartTasks(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __APP_H */
@@ -0,0 +1,77 @@
+/* =================================================================
+ * بنچمارک تأخیر سرتاسری: ورودی -> متن جدید روی LCD
+ *
+ * - مسیرها: ورود رقم رمز، کارت مجاز، کارت غیرمجاز، آلارم PIR، رمز اشتباه
+ * - شروع: اولین مشاهده ورودی (وقفه ردیف کیپد، لبه حسگر در تسک حسگرها)
+ *   یا زمان دقیق ورودی در شبیه‌ساز host (Bench_StimulusAt)
+ * - پایان: وقتی بعد از رویداد متناظر، framebuffer کامل روی LCD نوشته شد
+ * - زمان‌ها با شمارنده سیکل (Timing_GetCycles)؛ روی host ساعت مجازی
+ * - گزارش: min، میانه، p99 و max به میکروثانیه
+ * - با BENCH_ENABLE=0 همه نقاط اندازه‌گیری حذف می‌شوند
+ * ================================================================= */
+
+#ifndef __BENCH_H
+#define __BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "security.h"
+
+#ifndef BENCH_ENABLE
+#define BENCH_ENABLE        0
+#endif
+
+#ifndef BENCH_MAX_SAMPLES
+#define BENCH_MAX_SAMPLES   64      /* پنجره آخرین نمونه‌ها برای میانه و p99 */
+#endif
+
+typedef enum {
+    BENCH_KEY_ENTRY,        /* فشردن رقم -> '*' روی LCD */
+    BENCH_CARD_GRANT,       /* کارت مجاز -> "System DISARMED" */
+    BENCH_CARD_DENY,        /* کارت غیرمجاز -> "!! ALARM !!" */
+    BENCH_PIR_ALARM,        /* لبه PIR -> "!! ALARM !!" */
+    BENCH_PIN_FAIL,         /* '=' بعد از رمز اشتباه -> "Wrong Password!" */
+    BENCH_PATH_COUNT
+} BenchPath_t;
+
+typedef enum {
+    BENCH_SRC_KEY,
+    BENCH_SRC_CARD,
+    BENCH_SRC_PIR,
+    BENCH_SRC_COUNT
+} BenchSource_t;
+
+typedef struct {
+    uint32_t count;         /* کل نمونه‌ها */
+    uint32_t minUs;
+    uint32_t medianUs;      /* میانه و p99 روی آخرین BENCH_MAX_SAMPLES نمونه */
+    uint32_t p99Us;
+    uint32_t maxUs;
+} BenchResult_t;
+
+void Bench_Reset(void);
+void Bench_Stimulus(BenchSource_t source);
+void Bench_StimulusAt(BenchSource_t source, uint32_t cycles);
+void Bench_EventHandled(SecurityEventType_t type, SystemState_t state);
+void Bench_DisplayDone(void);
+uint8_t Bench_GetResult(BenchPath_t path, BenchResult_t *result);
+const char* Bench_PathName(BenchPath_t path);
+
+#if BENCH_ENABLE
+#define BENCH_STIMULUS(source)      Bench_Stimulus(source)
+#define BENCH_EVENT(type, state)    Bench_EventHandled(type, state)
+#define BENCH_DISPLAY_DONE()        Bench_DisplayDone()
+#else
+#define BENCH_STIMULUS(source)      ((void)0)
+#define BENCH_EVENT(type, state)    ((void)0)
+#define BENCH_DISPLAY_DONE()        ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BENCH_H */
@@ -0,0 +1,40 @@
+/* =================================================================
+ * درایور غیرمسدودکننده بازر (PA11) با تایمر TIM3
+ *
+ * - هر بوق یک ورودی {فرکانس، مدت، فاصله} در صف است
+ * - وقفه update تایمر TIM3 پین را toggle می‌کند و مدت‌ها را می‌شمارد
+ * - فرکانس 0 یعنی بازر اکتیو: پین در تمام مدت HIGH می‌ماند
+ * - Buzzer_PlayLoop الگو را تا Buzzer_Stop تکرار می‌کند (آلارم)
+ * ================================================================= */
+
+#ifndef __BUZZER_H
+#define __BUZZER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+#define BUZZER_QUEUE_SIZE       16      /* باید توانی از 2 باشد */
+#define BUZZER_LOOP_MAX_TONES   8
+
+typedef struct {
+    uint16_t frequency;     /* Hz؛ 0 = DC برای بازر اکتیو */
+    uint16_t duration;      /* ms */
+    uint16_t gap;           /* سکوت بعد از بوق (ms) */
+} BuzzerTone_t;
+
+void Buzzer_Init(void);
+uint8_t Buzzer_Play(const BuzzerTone_t *tones, uint8_t count);
+uint8_t Buzzer_Beep(uint16_t duration);
+void Buzzer_PlayLoop(const BuzzerTone_t *tones, uint8_t count);
+void Buzzer_Stop(void);
+uint8_t Buzzer_IsBusy(void);
+void Buzzer_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BUZZER_H */
@@ -0,0 +1,161 @@
+/* =================================================================
+ * پایگاه کارت‌های RFID با جست‌وجوی O(1)
+ *
+ * - کلید: UID کارت 4، 7 یا 10 بایتی
+ * - جدول cuckoo سطل‌دار در flash: هر کارت در یکی از دو سطل 4 خانه‌ای
+ *   است، پس هر جست‌وجو حداکثر 8 خانه را می‌خواند
+ * - هر خانه: برچسب 32 بیتی از SipHash کلیددار UID و 16 بیت ویژگی
+ *   (6 بایت، حدود 6.7 بایت برای هر کارت با بار 90%). UID خودش ذخیره نمی‌شود؛ احتمال
+ *   پذیرش اشتباه یک کارت ناشناس حدود 8 / 2^32
+ * - جدول با Host/cards_gen ساخته می‌شود (Core/Src/cards_table.c)
+ *
+ * برای فهرست ثابت کارت‌ها (CARDS_STORE_PERFECT) به جای آن:
+ * - درهم‌سازی کامل کمینه به روش CHD: سطل = بخشی از h، هر سطل یک pilot
+ *   16 بیتی دارد و مکان = f(بخش دیگر h، pilot) در [0، n)
+ * - رکورد فشرده هر کارت (UID کامل + ویژگی‌ها، 14 بایت)؛ بدون برخورد،
+ *   بدون کاوش و بدون پذیرش اشتباه: یک درهم، یک خواندن، یک مقایسه
+ * - جدول در بخش .cards flash (Host/cards_mph_gen -> cards_mph_table.c)
+ *
+ * فشرده‌ترین قالب، حدود 34 تا 37 بیت برای هر کارت 4 یا 7 بایتی (CARDS_STORE_PACKED):
+ * - UID های 4 و 7 بایتی به کلید 64 بیتی (طول | UID) تبدیل و مرتب می‌شوند
+ * - هر بلوک CARDS_PACKED_BLOCK کلید با Elias-Fano کد می‌شود: فاصله از
+ *   کلید اول بلوک، l بیت پایین خام و بقیه به صورت یگانی
+ * - نمایه پراکنده (کلید اول و مکان هر بلوک) با جست‌وجوی دودویی؛ فقط
+ *   یک بلوک باز می‌شود و داخل آن فقط کلیدهای هم‌بخش بالا مقایسه می‌شوند
+ * - ویژگی‌ها با جدول رنگ (palette) چند بیتی؛ UID های 10 بایتی که در
+ *   کلید 64 بیتی جا نمی‌شوند در فهرست مرتب جدا (Host/cards_pack_gen)،
+ *   فشرده‌نشده با CardRecord_t 14 بایتی (112 بیت). همه اعداد ظرفیت زیر
+ *   فرض می‌کنند کارت‌ها 4 یا 7 بایتی‌اند؛ 100000 کارت که یک سومشان 10
+ *   بایتی باشند 731096 بایت (58.5 بیت برای هر کارت) می‌گیرند
+ *
+ * ظرفیت: جدول firmware (بخش .cards) با کد در S5 (128K) شریک است
+ * (flash_map.h) و حداکثر CARDS_FLASH_BUDGET می‌گیرد؛ linker و ابزارهای
+ * Host/cards_*_gen بیشتر از آن را نمی‌نویسند (خروج با خطا). پایگاه بزرگ‌تر با تصویر
+ * پیکربندی (config.h) می‌آید: کنار کاربران و فهرست باطل‌شده حدود 120K از
+ * slot 128K برای کارت‌ها می‌ماند و Cards_SetTable آن را هم‌زمان با آن دو
+ * فعال می‌کند.
+ *   قالب        firmware (64K)    تصویر پیکربندی (حدود 120K)
+ *   cuckoo      حدود 9800         حدود 18000
+ *   CHD         حدود 4400         حدود 8000
+ *   فشرده       حدود 14500        حدود 27000
+ * 50000 کارت cuckoo (حدود 335KB) یا 100000 کارت فشرده (حدود 416KB) با
+ * سه جفت sector پاک‌شدنی (EEPROM، گزارش، پیکربندی A/B) روی 512K جا نمی‌شوند.
+ * ================================================================= */
+
+#ifndef __CARDS_H
+#define __CARDS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "hash.h"
+#include "integrity.h"
+
+/* پایگاه فعال؛ فقط جدول تولیدشده همان نوع لینک می‌شود */
+#define CARDS_STORE_CUCKOO      0
+#define CARDS_STORE_PERFECT     1
+#define CARDS_STORE_PACKED      2
+
+#ifndef CARDS_STORE
+#define CARDS_STORE             CARDS_STORE_CUCKOO
+#endif
+
+#define CARDS_UID_MAX           10
+#define CARDS_SLOTS_PER_BUCKET  4
+#define CARDS_EMPTY_TAG         0
+#define CARDS_PACKED_BLOCK      128
+#define CARDS_PACKED_ATTR_MAX   16      /* مقدار متمایز ویژگی‌ها */
+
+/* ویژگی‌های کارت */
+#define CARD_ATTR_ACTIVE        0x0001  /* بدون این بیت کارت مسدود است */
+#define CARD_ATTR_NONE          0x0000  /* کارت در پایگاه نیست */
+
+typedef struct {
+    uint8_t length;                     /* 4، 7 یا 10 */
+    uint8_t bytes[CARDS_UID_MAX];
+} CardUid_t;
+
+typedef struct {
+    uint8_t key[HASH_KEY_SIZE];
+    uint32_t bucketCount;
+    uint32_t cardCount;
+    const uint32_t *tags;               /* bucketCount * CARDS_SLOTS_PER_BUCKET */
+    const uint16_t *attributes;
+} CardTable_t;
+
+typedef struct {
+    uint8_t length;
+    uint8_t uid[CARDS_UID_MAX];
+    uint8_t reserved;
+    uint16_t attributes;
+} CardRecord_t;
+
+typedef struct {
+    uint8_t key[HASH_KEY_SIZE];
+    uint32_t bucketCount;
+    uint32_t recordCount;               /* معمولاً برابر cardCount (کمینه) */
+    uint32_t cardCount;
+    const uint16_t *pilots;
+    const CardRecord_t *records;
+} CardPerfectTable_t;
+
+typedef struct {
+    uint64_t first;                     /* کلید اولین کارت بلوک */
+    uint32_t bitOffset;                 /* شروع بیت‌های پایین در bits */
+    uint16_t upperLength;               /* طول رشته یگانی بعد از بیت‌های پایین */
+    uint8_t lowBits;                    /* l */
+    uint8_t count;                      /* کارت‌های بلوک، با اولی */
+} CardBlock_t;
+
+typedef struct {
+    uint32_t cardCount;                 /* همه کارت‌ها، با فهرست 10 بایتی */
+    uint32_t blockCount;
+    const CardBlock_t *blocks;
+    const uint32_t *bits;               /* 2 کلمه اضافه در انتها برای خواندن بی‌مرز */
+    uint8_t attributeBits;              /* 0 یعنی همه ویژگی‌ها palette[0] */
+    const uint16_t *palette;
+    const uint32_t *attributeIndex;     /* attributeBits برای هر کارت به ترتیب کلید */
+    uint32_t overflowCount;
+    const CardRecord_t *overflow;       /* UID های 10 بایتی، مرتب */
+} CardPackedTable_t;
+
+/* نوع جدول پایگاهی که لینک شده؛ تصویر پیکربندی هم همین قالب را دارد */
+#if CARDS_STORE == CARDS_STORE_PACKED
+typedef CardPackedTable_t CardsStoreTable_t;
+#elif CARDS_STORE == CARDS_STORE_PERFECT
+typedef CardPerfectTable_t CardsStoreTable_t;
+#else
+typedef CardTable_t CardsStoreTable_t;
+#endif
+
+/* جدول‌های تولید شده در بخش جدای flash؛ همان عدد ASSERT در STM32F401VETX_*.ld */
+#define CARDS_SECTION           __attribute__((section(".cards")))
+#define CARDS_FLASH_BUDGET      0x10000UL       /* 64K از 128K سکتور S5؛ بقیه برای کد */
+
+/* cards_table.c، cards_mph_table.c و cards_packed_table.c (تولید شده) */
+extern const CardTable_t cardsTable;
+extern const CardPerfectTable_t cardsPerfectTable;
+extern const CardPackedTable_t cardsPackedTable;
+/* آرایه‌های همان پایگاهی که لینک شده؛ آرایه‌های 16 بیتی و رکوردها تا
+ * مضرب 4 بایت با عنصر صفر پر می‌شوند */
+extern const IntegrityImage_t cardsTableCrc;
+
+uint8_t Cards_Lookup(const CardUid_t *uid, uint16_t *attributes);
+uint8_t Cards_LookupIn(const CardTable_t *table, const CardUid_t *uid, uint16_t *attributes);
+void Cards_Locate(const CardTable_t *table, const CardUid_t *uid, uint32_t *tag, uint32_t *bucket1, uint32_t *bucket2);
+uint8_t Cards_PerfectLookupIn(const CardPerfectTable_t *table, const CardUid_t *uid, uint16_t *attributes);
+uint32_t Cards_PerfectPosition(const CardPerfectTable_t *table, uint64_t hash, uint16_t pilot);
+uint8_t Cards_PackedLookupIn(const CardPackedTable_t *table, const CardUid_t *uid, uint16_t *attributes);
+uint64_t Cards_PackedKey(const CardUid_t *uid);
+uint64_t Cards_Hash(const uint8_t key[HASH_KEY_SIZE], const CardUid_t *uid);
+uint32_t Cards_Count(void);
+void Cards_SetTable(const CardsStoreTable_t *table);
+uint8_t Cards_PackedIsValid(const CardPackedTable_t *table, uint32_t bitsWords, uint32_t attributeWords);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CARDS_H */
@@ -0,0 +1,126 @@
+/* =================================================================
+ * پیکربندی درب در flash با دو slot (A/B) و جابه‌جایی اتمی
+ *
+ * - sector های S6 و S7 (flash_map.h) دو slot اند؛ Security_* همیشه از
+ *   slot فعال (یا اگر هیچ slot معتبری نیست از جدول‌های firmware) می‌خواند
+ * - تصویر تازه با Config_Begin/Config_Write/Config_Commit(crc) در slot دیگر
+ *   نوشته می‌شود: Config_Write فقط در بافر RAM کپی می‌کند و Config_Task در
+ *   هر نوبت حداکثر CONFIG_PROGRAM_WORDS کلمه برنامه می‌کند
+ * - پاک کردن slot دیگر (حدود 1s) فقط در زمان سکون با Config_EraseInactive
+ * - سرآیند بعد از کل تصویر نوشته می‌شود و کلمه magic آخر از همه: همین یک
+ *   کلمه slot را معتبر می‌کند. قطع برق قبل از آن slot فعال قبلی را
+ *   دست‌نخورده می‌گذارد
+ * - موقع راه‌اندازی هر slot با magic، CRC و جدول محتوای سالم نامزد است و
+ *   version بزرگ‌تر برنده است؛ CRC با واحد سخت‌افزاری (crc.h) و slot فعال
+ *   بعد از آن در integrity.h دوره‌ای دوباره بررسی می‌شود
+ * - محتوا: جدول کاربران (رمزها)، فهرست کارت‌های باطل‌شده و در صورت
+ *   نیاز پایگاه کارت‌ها در همان قالب CARDS_STORE که firmware با آن ساخته
+ *   شده؛ هر سه با هم در یک جابه‌جایی عوض می‌شوند. تصویر بدون پایگاه کارت
+ *   (cardsFormat = CONFIG_CARDS_FIRMWARE) جدول firmware را نگه می‌دارد.
+ *   زمان‌ها در EEPROM اند
+ * ================================================================= */
+
+#ifndef __CONFIG_H
+#define __CONFIG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "hash.h"
+#include "cards.h"
+#include "flash_map.h"
+
+#define CONFIG_MAGIC            0x47464E43UL    /* "CNFG" */
+#define CONFIG_HEADER_SIZE      16
+#define CONFIG_MAX_LENGTH       (FLASH_MAP_CONFIG_SIZE - CONFIG_HEADER_SIZE)
+#define CONFIG_STAGE_SIZE       512             /* بافر RAM بین Config_Write و flash */
+#define CONFIG_PROGRAM_WORDS    64              /* در هر نوبت Config_Task، حدود 1ms */
+#define CONFIG_CARDS_FIRMWARE   0               /* تصویر پایگاه کارت ندارد */
+#define CONFIG_CARDS_FORMAT     (CARDS_STORE + 1)
+
+/* ابتدای slot؛ محتوا بلافاصله بعد از آن */
+typedef struct {
+    uint32_t version;                   /* بزرگ‌تر = تازه‌تر؛ 0 = جدول‌های firmware */
+    uint32_t length;                    /* بایت‌های محتوا، مضرب 4 */
+    uint32_t crc;                       /* CRC-32 (چندجمله‌ای STM32) روی کلمه‌های محتوا */
+    uint32_t magic;                     /* آخر برنامه می‌شود */
+} ConfigHeader_t;
+
+/* ابتدای محتوا؛ فاصله‌ها از ابتدای محتوا و هم‌تراز با نوع خودشان */
+typedef struct {
+    uint32_t usersCount;
+    uint32_t usersPepper;               /* USERS_PEPPER_SIZE بایت */
+    uint32_t usersIndex;                /* USERS_BUCKETS + 1 عدد 16 بیتی */
+    uint32_t usersRecords;              /* UserRecord_t، هم‌تراز 8 */
+    uint8_t revokeKey[HASH_KEY_SIZE];
+    uint32_t revokeFilterBits;
+    uint32_t revokeHashCount;
+    uint32_t revokeFilter;              /* (revokeFilterBits + 31) / 32 کلمه */
+    uint32_t revokeCount;
+    uint32_t revokeUids;                /* CardUid_t مرتب */
+    uint32_t cardsFormat;               /* CONFIG_CARDS_FIRMWARE یا CONFIG_CARDS_FORMAT */
+#if CARDS_STORE == CARDS_STORE_PACKED
+    uint32_t cardsCount;
+    uint32_t cardsBlockCount;
+    uint32_t cardsBlocks;               /* CardBlock_t، هم‌تراز 8 */
+    uint32_t cardsBitsWords;
+    uint32_t cardsBits;
+    uint32_t cardsAttributeBits;        /* حداکثر 4 */
+    uint32_t cardsPalette;              /* همیشه CARDS_PACKED_ATTR_MAX عدد 16 بیتی */
+    uint32_t cardsAttributeWords;
+    uint32_t cardsAttributeIndex;
+    uint32_t cardsOverflowCount;
+    uint32_t cardsOverflow;             /* CardRecord_t مرتب، هم‌تراز 2 */
+#elif CARDS_STORE == CARDS_STORE_PERFECT
+    uint8_t cardsKey[HASH_KEY_SIZE];
+    uint32_t cardsBucketCount;
+    uint32_t cardsRecordCount;
+    uint32_t cardsCount;
+    uint32_t cardsPilots;               /* cardsBucketCount عدد 16 بیتی */
+    uint32_t cardsRecords;              /* CardRecord_t، هم‌تراز 2 */
+#else
+    uint8_t cardsKey[HASH_KEY_SIZE];
+    uint32_t cardsBucketCount;
+    uint32_t cardsCount;
+    uint32_t cardsTags;                 /* cardsBucketCount * CARDS_SLOTS_PER_BUCKET کلمه */
+    uint32_t cardsAttributes;           /* همان تعداد عدد 16 بیتی */
+#endif
+} ConfigLayout_t;
+
+typedef enum {
+    CONFIG_IDLE = 0,
+    CONFIG_ERASING,                     /* منتظر سکون برای پاک کردن slot دیگر */
+    CONFIG_RECEIVING,
+    CONFIG_FAILED                       /* خطای برنامه کردن یا محتوای نامعتبر؛ slot فعال عوض نشد */
+} ConfigUpdateState_t;
+
+typedef struct {
+    uint32_t commits;
+    uint32_t rejected;                  /* CRC با فرستنده نخواند یا جدول محتوا نامعتبر بود */
+    uint32_t failed;                    /* خطای برنامه کردن */
+    uint32_t erases;
+    uint32_t maxEraseMs;
+    uint32_t maxProgramCycles;          /* یک نوبت Config_Task، بدون بررسی پایانی */
+    uint32_t verifyCycles;              /* CRC سخت‌افزاری محتوای نوشته‌شده در Config_Commit */
+    uint32_t bootCheckCycles;           /* بررسی CRC هر دو slot موقع راه‌اندازی */
+} ConfigStats_t;
+
+void Config_Init(void);
+uint8_t Config_Begin(uint32_t length);
+uint32_t Config_Write(const void *data, uint32_t length);
+uint8_t Config_Commit(uint32_t crc);
+void Config_Task(void);
+uint8_t Config_NeedsErase(void);
+void Config_EraseInactive(void);
+uint8_t Config_IsIdle(void);
+ConfigUpdateState_t Config_GetUpdateState(void);
+uint32_t Config_GetVersion(void);
+void Config_GetStats(ConfigStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CONFIG_H */
@@ -0,0 +1,41 @@
+/* =================================================================
+ * واحد CRC سخت‌افزاری با تغذیه DMA حافظه به حافظه
+ *
+ * - DMA2 Stream0 (فقط DMA2 حافظه به حافظه دارد) کلمه‌های flash را یکی
+ *   یکی در CRC->DR می‌نویسد؛ CPU در این مدت آزاد است
+ * - CRC-32 با چندجمله‌ای 0x04C11DB7، مقدار اولیه 0xFFFFFFFF، کلمه به
+ *   کلمه و بدون xor پایانی (همان Hash_Crc32)
+ * - مقدار اولیه دلخواه در F401 ممکن نیست: ادامه یک ناحیه فقط وقتی درست
+ *   است که از Crc_Start قبلی کسی واحد را به کار نبرده باشد
+ *   (Crc_Transfers را مقایسه کنید)
+ * - وقفه پایان انتقال زمان واقعی انتقال را با شمارنده سیکل ثبت می‌کند
+ * ================================================================= */
+
+#ifndef __CRC_H
+#define __CRC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "hash.h"
+
+#define CRC_MAX_WORDS       0xFFFFU     /* NDTR شانزده بیتی */
+#define CRC_INITIAL         HASH_CRC_INITIAL
+
+void Crc_Init(void);
+uint8_t Crc_Start(uintptr_t address, uint32_t words, uint8_t restart);
+uint8_t Crc_IsBusy(void);
+uint8_t Crc_LastFailed(void);
+uint32_t Crc_Value(void);
+uint32_t Crc_Transfers(void);
+uint32_t Crc_LastCycles(void);
+uint32_t Crc_Compute(uint32_t address, uint32_t words);
+void Crc_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CRC_H */
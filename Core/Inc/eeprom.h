@@ -0,0 +1,75 @@
+/* =================================================================
+ * شبیه‌سازی EEPROM روی دو sector کوچک flash (S1، S2)
+ *
+ * - مقدارها 32 بیتی با کلید 16 بیتی؛ Eeprom_Write فقط فهرست RAM را عوض
+ *   می‌کند و نوبت بعدی Eeprom_Task یک رکورد 8 بایتی به انتهای صفحه فعال
+ *   اضافه می‌کند (2 کلمه، حدود 32us)؛ هیچ پاک کردنی لازم نیست
+ * - موقع راه‌اندازی صفحه فعال یک بار خوانده و آخرین مقدار هر کلید در
+ *   فهرست RAM گذاشته می‌شود؛ Eeprom_Read فقط همان فهرست را می‌گردد
+ * - وقتی صفحه فعال نزدیک پر شدن است، Eeprom_Task مقدارهای فعلی را در
+ *   صفحه دیگر (از قبل پاک شده) کپی می‌کند و صفحه قدیمی در زمان سکون با
+ *   Eeprom_EraseSpare پاک می‌شود
+ * - وضعیت صفحه فقط با 0 کردن بیت‌ها جلو می‌رود:
+ *   پاک -> دریافت -> فعال -> منسوخ؛ قطع برق در هر مرحله صفحه فعال قبلی
+ *   را دست‌نخورده می‌گذارد
+ * ================================================================= */
+
+#ifndef __EEPROM_H
+#define __EEPROM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+#define EEPROM_MAX_KEYS         16
+#define EEPROM_RECORD_SIZE      8
+#define EEPROM_HEADER_SLOTS     2       /* سرآیند 16 بایتی */
+#define EEPROM_COMPACT_FREE     32      /* رکورد آزاد که فشرده‌سازی را لازم می‌کند */
+
+#define EEPROM_PAGE_ERASED      0xFFFFFFFFUL
+#define EEPROM_PAGE_RECEIVE     0xEEEEEEEEUL
+#define EEPROM_PAGE_ACTIVE      0xAAAAAAAAUL
+#define EEPROM_PAGE_OBSOLETE    0x00000000UL
+
+/* کلیدها؛ 0 و 0xFFFF رزرو */
+typedef enum {
+    EEPROM_KEY_PIN_SHOW_MS = 1,
+    EEPROM_KEY_GRANTED_SHOW_MS,
+    EEPROM_KEY_DENIED_SHOW_MS,
+    EEPROM_KEY_PIN_FAILURES,        /* رمز اشتباه پشت سر هم؛ با رمز صحیح صفر می‌شود */
+    EEPROM_KEY_ALARM_COUNT
+} EepromKey_t;
+
+typedef struct {
+    uint32_t state;
+    uint32_t eraseCount;
+    uint32_t generation;            /* با هر فشرده‌سازی یکی بیشتر */
+    uint32_t reserved;
+} EepromHeader_t;
+
+typedef struct {
+    uint32_t writes;
+    uint32_t unchanged;             /* مقدار تکراری، چیزی نوشته نشد */
+    uint32_t failed;                /* خطای برنامه کردن؛ در نوبت یا فشرده‌سازی بعدی دوباره */
+    uint32_t compactions;
+    uint32_t erases;
+    uint32_t maxPersistCycles;      /* یک نوبت Eeprom_Task بدون فشرده‌سازی */
+    uint32_t maxEraseMs;
+} EepromStats_t;
+
+void Eeprom_Init(void);
+uint32_t Eeprom_Read(uint16_t key, uint32_t fallback);
+uint8_t Eeprom_Write(uint16_t key, uint32_t value);
+void Eeprom_Task(void);
+uint8_t Eeprom_NeedsErase(void);
+void Eeprom_EraseSpare(void);
+uint8_t Eeprom_IsIdle(void);
+void Eeprom_GetStats(EepromStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __EEPROM_H */
@@ -0,0 +1,105 @@
+/* =================================================================
+ * گزارش رویدادهای درب در flash (فقط افزودنی، حلقوی)
+ *
+ * - sector S3 و 16K اول S4 (flash_map.h) یک حلقه‌اند؛ در هر لحظه یکی فعال است.
+ *   دو نیمه هم‌اندازه‌اند، پس بعد از پاک شدن هر کدام دست‌کم 1023 رکورد می‌ماند
+ * - ابتدای هر sector سرآیند 16 بایتی: امضا، تعداد پاک شدن، شماره
+ *   ترتیب اولین رکورد (تا باز شدن sector خالی می‌ماند)
+ * - بقیه sector رکوردهای 16 بایتی؛ شماره ترتیب رکورد = اولین شماره
+ *   sector + جای آن، پس بعد از reset با جست‌وجوی دودویی اولین خانه
+ *   خالی ادامه پیدا می‌کند
+ * - افزودن فقط رکورد را در بافر RAM می‌گذارد (چند میکروثانیه)؛ EventLog_Task
+ *   بافر را یک‌جا و کلمه به کلمه در flash می‌نویسد: وقتی پر شود، وقتی
+ *   قدیمی‌ترین رکوردش EVENTLOG_FLUSH_MS منتظر مانده باشد، یا فوراً برای
+ *   رویداد بحرانی. دو بافر: تا نوبت نوشتن بافر پر برسد، بعدی پر می‌شود
+ * - قطع برق حداکثر رکوردهای EVENTLOG_FLUSH_MS آخر را از بین می‌برد
+ * - نوشتن هرگز پاک نمی‌کند؛ sector بعدی با EventLog_EraseNext از قبل و در
+ *   زمان سکون پاک می‌شود و اگر آماده نباشد رکورد دور ریخته و شمرده می‌شود
+ * - sector ها به نوبت پاک می‌شوند پس فرسایش یکسان پخش می‌شود
+ * - وقتی آخرین خانه sector نوشته شد CRC همه رکوردهایش در سرآیند مهر
+ *   می‌شود و از آن پس integrity.h آن را در پس‌زمینه بررسی می‌کند
+ * ================================================================= */
+
+#ifndef __EVENTLOG_H
+#define __EVENTLOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+#define EVENTLOG_MAGIC              0x474F4C45UL    /* "ELOG" */
+#define EVENTLOG_SECTOR_COUNT       2
+#define EVENTLOG_RECORD_SIZE        16
+#define EVENTLOG_PREERASE_FREE      1024            /* فضای آزاد sector فعال که پاک کردن بعدی را لازم می‌کند */
+#define EVENTLOG_STAGE_RECORDS      8               /* ظرفیت هر یک از دو بافر RAM */
+#define EVENTLOG_FLUSH_MS           250             /* حداکثر انتظار رکورد در RAM */
+
+typedef enum {
+    EVENTLOG_BOOT = 1,
+    EVENTLOG_PIN_GRANTED,           /* detail: 1 مسلح شد، 0 غیرفعال شد؛ data: شماره کاربر */
+    EVENTLOG_PIN_DENIED,
+    EVENTLOG_CARD_GRANTED,          /* data: 4 بایت آخر UID */
+    EVENTLOG_CARD_DENIED,           /* detail: EventLogCardReason_t؛ data: 4 بایت آخر UID */
+    EVENTLOG_ALARM,                 /* detail: 0 کارت، 1 حرکت */
+    EVENTLOG_MOTION,
+    EVENTLOG_CONFIG,                /* پیکربندی تازه فعال شد؛ data: version */
+    EVENTLOG_INTEGRITY              /* CRC ناحیه flash نخواند؛ detail: IntegrityRegion_t، data: CRC خوانده‌شده */
+} EventLogType_t;
+
+/* این نوع‌ها بدون انتظار در نوبت بعدی EventLog_Task نوشته می‌شوند */
+#define EVENTLOG_CRITICAL_TYPES     ((1UL << EVENTLOG_BOOT) | (1UL << EVENTLOG_ALARM))
+
+typedef enum {
+    EVENTLOG_CARD_UNKNOWN,
+    EVENTLOG_CARD_BLOCKED,
+    EVENTLOG_CARD_REVOKED
+} EventLogCardReason_t;
+
+/* کلمه سوم (type/detail/check) آخر برنامه می‌شود: رکورد نیمه‌کاره نامعتبر است */
+typedef struct {
+    uint32_t sequence;
+    uint32_t time;                  /* HAL_GetTick */
+    uint8_t type;
+    uint8_t detail;
+    uint16_t check;
+    uint32_t data;
+} EventLogRecord_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t eraseCount;
+    uint32_t firstSequence;         /* 0xFFFFFFFF = پاک شده ولی هنوز باز نشده */
+    uint32_t sealedCrc;             /* CRC خانه‌های 1 تا آخر؛ 0xFFFFFFFF = هنوز پر نشده */
+} EventLogHeader_t;
+
+typedef struct {
+    uint32_t appended;              /* وارد بافر RAM شد */
+    uint32_t committed;             /* در flash نوشته شد */
+    uint32_t dropped;               /* sector بعدی پاک نبود یا برنامه کردن خطا داد */
+    uint32_t commits;               /* تعداد نوشتن‌های یک‌جای بافر */
+    uint32_t inlineCommits;         /* هر دو بافر پر بود و افزودن خودش نوشت */
+    uint32_t erases;
+    uint32_t seals;                 /* sector پر با CRC مهر شد */
+    uint32_t maxAppendCycles;
+    uint32_t maxCommitCycles;
+    uint32_t maxEraseMs;
+} EventLogStats_t;
+
+void EventLog_Init(void);
+uint8_t EventLog_Append(EventLogType_t type, uint8_t detail, uint32_t data);
+void EventLog_Task(void);
+void EventLog_Flush(void);
+uint8_t EventLog_IsIdle(void);
+uint8_t EventLog_Read(uint32_t back, EventLogRecord_t *record);
+uint32_t EventLog_NextSequence(void);
+uint8_t EventLog_NeedsErase(void);
+void EventLog_EraseNext(void);
+void EventLog_GetStats(EventLogStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __EVENTLOG_H */
@@ -0,0 +1,64 @@
+/* =================================================================
+ * نقشه sector های flash (STM32F401VE، 512KB)
+ *
+ *   S0      0x08000000   16K    جدول وقفه
+ *   S1      0x08004000   16K    شبیه‌سازی EEPROM (صفحه 0)
+ *   S2      0x08008000   16K    شبیه‌سازی EEPROM (صفحه 1)
+ *   S3      0x0800C000   16K    گزارش رویدادها (نیمه 0)
+ *   S4      0x08010000   64K    گزارش رویدادها (نیمه 1، فقط 16K اول)
+ *   S5      0x08020000   128K   کد، ثابت‌ها، جدول کارت‌ها
+ *   S6      0x08040000   128K   پیکربندی (slot 0)
+ *   S7      0x08060000   128K   پیکربندی (slot 1)
+ *
+ * EEPROM، گزارش و پیکربندی A/B هر کدام دو sector جدا لازم دارند (یکی
+ * پاک می‌شود و دیگری معتبر می‌ماند)، پس برای کد و جدول‌های کارت firmware
+ * فقط S5 می‌ماند؛ سهم جدول‌ها CARDS_FLASH_BUDGET در cards.h است. پایگاه
+ * کارت بزرگ‌تر در تصویر پیکربندی S6/S7 می‌آید (config.h).
+ * دو نیمه گزارش هم‌اندازه‌اند تا بعد از پاک شدن هر کدام همان مقدار
+ * سابقه بماند؛ 48K باقی S4 همراه گزارش پاک می‌شود و استفاده نمی‌شود.
+ *
+ * باید با MEMORY در STM32F401VETX_FLASH.ld یکی بماند.
+ * پاک کردن هر sector تا پایانش خواندن کل flash (و اجرای کد) را متوقف
+ * می‌کند: 16K حدود 250ms، 64K حدود 550ms، 128K حدود 1s (معمول).
+ * ================================================================= */
+
+#ifndef __FLASH_MAP_H
+#define __FLASH_MAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+#define FLASH_MAP_EEPROM_SECTOR0    FLASH_SECTOR_1
+#define FLASH_MAP_EEPROM_ADDR0      0x08004000UL
+#define FLASH_MAP_EEPROM_SECTOR1    FLASH_SECTOR_2
+#define FLASH_MAP_EEPROM_ADDR1      0x08008000UL
+#define FLASH_MAP_EEPROM_SIZE       0x4000UL
+
+#define FLASH_MAP_LOG_SECTOR0       FLASH_SECTOR_3
+#define FLASH_MAP_LOG_ADDR0         0x0800C000UL
+#define FLASH_MAP_LOG_SIZE0         0x4000UL
+#define FLASH_MAP_LOG_SECTOR1       FLASH_SECTOR_4
+#define FLASH_MAP_LOG_ADDR1         0x08010000UL
+#define FLASH_MAP_LOG_SIZE1         0x4000UL        /* هم‌اندازه S3؛ نه کل sector */
+
+#define FLASH_MAP_CONFIG_SECTOR0    FLASH_SECTOR_6
+#define FLASH_MAP_CONFIG_ADDR0      0x08040000UL
+#define FLASH_MAP_CONFIG_SECTOR1    FLASH_SECTOR_7
+#define FLASH_MAP_CONFIG_ADDR1      0x08060000UL
+#define FLASH_MAP_CONFIG_SIZE       0x20000UL
+
+/* flash حافظه‌نگاشته است؛ بیلد host آن را به آرایه ساختگی هدایت می‌کند */
+#ifndef FLASH_READ_PTR
+#define FLASH_READ_PTR(address)     ((const void *)(uintptr_t)(address))
+#endif
+
+HAL_StatusTypeDef FlashMap_EraseSector(uint32_t sector, uint32_t *elapsedMs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FLASH_MAP_H */
@@ -0,0 +1,31 @@
+/* =================================================================
+ * تابع درهم‌سازی کلیددار SipHash-2-4
+ *
+ * - خروجی 64 بیتی، کلید 128 بیتی (16 بایت)
+ * - زمان اجرا فقط به طول داده بستگی دارد، نه به محتوای آن
+ * - همان کد در ابزارهای host (تولید جدول کاربران) استفاده می‌شود
+ * - Hash_Crc32: همان CRC واحد سخت‌افزاری (crc.h)، برای CRC مرجعی که
+ *   ابزارهای تولید جدول کنار آرایه‌ها می‌نویسند
+ * ================================================================= */
+
+#ifndef __HASH_H
+#define __HASH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define HASH_KEY_SIZE       16
+#define HASH_CRC_INITIAL    0xFFFFFFFFUL
+
+uint64_t Hash_SipHash(const uint8_t key[HASH_KEY_SIZE], const void *data, size_t length);
+uint32_t Hash_Crc32(uint32_t crc, const void *data, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HASH_H */
@@ -0,0 +1,74 @@
+/* =================================================================
+ * درایور LCD کاراکتری HD44780 با بافر سایه (framebuffer)
+ *
+ * پین‌ها در main.h تعریف شده‌اند (PA0: RS، PA1: EN، PA2: R/W، PA4-PA7: D4-D7)
+ * ================================================================= */
+
+#ifndef __HD44780_H
+#define __HD44780_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+// #define LCD20x4              // برای LCD 20x4
+#define LCD16x2                 // برای LCD 16x2
+
+#if defined(LCD20x4)
+#define LCD_ROWS 4
+#define LCD_COLS 20
+#else
+#define LCD_ROWS 2
+#define LCD_COLS 16
+#endif
+
+/* فاصله‌ای (بر حسب خانه) که به جای جابجایی کرسر از رویش بازنویسی می‌شود */
+#define LCD_FLUSH_BRIDGE_GAP    1
+
+/* حداکثر بایت ارسالی در هر اجرای تسک flush */
+#define LCD_FLUSH_MAX_CELLS     16
+
+/* 1: خواندن busy flag از طریق R/W (PA2)
+ * 0: R/W به زمین وصل است؛ صبر با زمان ثابت (delay_us)
+ * LCD_Init یک بار شمارنده آدرس را می‌خواند و فقط اگر پنل جواب درست بدهد
+ * BF را به کار می‌گیرد؛ اگر بعداً BF هیچ‌وقت صفر نشود هم درایور خودکار به
+ * زمان ثابت برمی‌گردد.
+ * در حالت DMA فاصله‌ها با تایمر تأمین می‌شود و BF خوانده نمی‌شود. */
+#define LCD_USE_BUSY_FLAG       0
+#define LCD_BUSY_MAX_POLLS      1000
+
+/* زمان اجرای دستورها برای حالت بدون busy flag (us) */
+#define LCD_EXEC_US             50      /* اسمی 37us */
+#define LCD_EXEC_SLOW_US        2000    /* Clear / Return home، اسمی 1.52ms */
+
+/* 1: ارسال باس با TIM1 + DMA2 به GPIOA->BSRR؛ 0: ارسال با CPU
+ * (بیلد host با -DLCD_USE_DMA=0 بازنویسی می‌کند) */
+#ifndef LCD_USE_DMA
+#define LCD_USE_DMA             1
+#endif
+#define LCD_DMA_MAX_BYTES       40      /* ظرفیت بافر DMA بر حسب بایت LCD */
+#define LCD_DMA_WORDS_PER_BYTE  7
+#define LCD_DMA_WORD_US         10      /* فاصله کلمه‌ها؛ 7 x 10us = 70us برای هر بایت */
+
+void LCD_Init(void);
+void LCD_SendCommand(uint8_t cmd);
+void LCD_SendData(uint8_t data);
+
+void LCD_PutChar(char c);
+void LCD_Print(const char *str);
+void LCD_SetCursor(uint8_t row, uint8_t col);
+void LCD_Clear(void);
+uint8_t LCD_IsDirty(void);
+uint16_t LCD_FlushStep(uint16_t maxCells);
+void LCD_Flush(void);
+uint8_t LCD_IsBusy(void);
+void LCD_WaitIdle(void);
+void LCD_TransferCompleteCallback(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HD44780_H */
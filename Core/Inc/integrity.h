@@ -0,0 +1,86 @@
+/* =================================================================
+ * بررسی سلامت ناحیه‌های flash با واحد CRC سخت‌افزاری (crc.h)
+ *
+ * - هر ناحیه (slot فعال پیکربندی، sector های پرشده گزارش) با CRC مرجعی
+ *   که صاحبش در flash نوشته ثبت می‌شود (Integrity_Watch)
+ * - جدول‌های ثابت firmware (پایگاه کارت، کاربران و کارت‌های باطل‌شده
+ *   داخلی) با CRC که ابزار تولید کنار آرایه‌ها نوشته (IntegrityImage_t)
+ *   در Integrity_Init ثبت و در اولین سکون بررسی می‌شوند
+ * - Integrity_Task در هر نوبت حداکثر یک برش INTEGRITY_SLICE_WORDS کلمه‌ای
+ *   را به DMA می‌دهد؛ جای برش و CRC تا آنجا (checkpoint) در RAM می‌ماند،
+ *   پس ناحیه 128K در چند نوبت سکون بررسی می‌شود و CPU فقط شروع و پایان
+ *   برش را می‌بیند
+ * - ناحیه تازه ثبت‌شده فوراً و بقیه هر INTEGRITY_RECHECK_MS دوباره بررسی
+ *   می‌شوند؛ عدم تطابق در وضعیت ناحیه، آمار و گزارش رویدادها ثبت می‌شود
+ * - بررسی مسدودکننده (راه‌اندازی، بعد از نوشتن) مستقیم با Crc_Compute
+ * - سرعت واقعی DMA از زمان شروع تا وقفه پایان هر برش اندازه‌گیری می‌شود
+ * ================================================================= */
+
+#ifndef __INTEGRITY_H
+#define __INTEGRITY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+#define INTEGRITY_SLICE_WORDS   4096            /* 16KB در هر برش */
+#define INTEGRITY_RECHECK_MS    600000UL        /* هر ناحیه هر 10 دقیقه */
+#define INTEGRITY_ALIGNED       __attribute__((aligned(4)))     /* DMA کلمه به کلمه می‌خواند */
+
+typedef enum {
+    INTEGRITY_CONFIG = 0,                       /* محتوای slot فعال پیکربندی */
+    INTEGRITY_LOG0,                             /* sector های پرشده گزارش رویدادها */
+    INTEGRITY_LOG1,
+    INTEGRITY_CARDS,                            /* آرایه‌های پایگاه کارت فعال (cards.h) */
+    INTEGRITY_USERS,                            /* جدول کاربران داخلی */
+    INTEGRITY_REVOKE,                           /* فهرست باطل‌شده داخلی */
+    INTEGRITY_REGIONS
+} IntegrityRegion_t;
+
+typedef enum {
+    INTEGRITY_UNKNOWN = 0,                      /* ثبت نشده یا هنوز بررسی نشده */
+    INTEGRITY_OK,
+    INTEGRITY_CORRUPT
+} IntegrityStatus_t;
+
+/* یک آرایه؛ شروع هم‌تراز 4 بایت و طول مضرب 4 (INTEGRITY_ALIGNED، پر شده با صفر) */
+typedef struct {
+    const void *data;
+    uint32_t length;                            /* بایت */
+} IntegritySpan_t;
+
+/* آرایه‌های یک جدول تولیدشده به ترتیب، با CRC مرجع روی همان بایت‌ها
+ * (Hash_Crc32 در ابزار تولید) */
+typedef struct {
+    const IntegritySpan_t *spans;
+    uint8_t spanCount;
+    uint32_t crc;
+} IntegrityImage_t;
+
+typedef struct {
+    uint32_t checks;                            /* ناحیه کامل بررسی شد */
+    uint32_t mismatches;
+    uint32_t restarts;                          /* خطای DMA یا استفاده دیگری از واحد CRC بین دو برش */
+    uint32_t slices;
+    uint64_t bytes;                             /* فقط برش‌های پس‌زمینه */
+    uint64_t dmaCycles;                         /* جمع زمان برش‌ها از شروع تا وقفه پایان */
+    uint32_t maxTaskCycles;                     /* زمان CPU یک نوبت Integrity_Task */
+} IntegrityStats_t;
+
+void Integrity_Init(void);
+void Integrity_Watch(IntegrityRegion_t region, uint32_t address, uint32_t length, uint32_t expected, uint8_t verified);
+void Integrity_WatchImage(IntegrityRegion_t region, const IntegrityImage_t *image);
+void Integrity_Forget(IntegrityRegion_t region);
+void Integrity_Task(void);
+uint8_t Integrity_IsIdle(void);
+IntegrityStatus_t Integrity_GetStatus(IntegrityRegion_t region);
+uint32_t Integrity_ThroughputKBps(void);
+void Integrity_GetStats(IntegrityStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INTEGRITY_H */
@@ -0,0 +1,51 @@
+/* =================================================================
+ * درایور کیپد 4x4 با debounce و صف رویداد
+ *
+ * - ماتریس با تسک دوره‌ای زمان‌بند (هر KEYPAD_SAMPLE_PERIOD ms) نمونه‌برداری می‌شود
+ * - هر کلید ماشین حالت debounce خودش را دارد
+ * - رویدادهای فشردن/رها کردن/نگه‌داشتن/تکرار با زمان‌مهر در صف قرار می‌گیرند
+ * - هیچ تابعی منتظر رها شدن کلید نمی‌ماند
+ * ================================================================= */
+
+#ifndef __KEYPAD_H
+#define __KEYPAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+#define KEYPAD_SAMPLE_PERIOD      5      /* ms */
+#define KEYPAD_DEBOUNCE_SAMPLES   4      /* 4 x 5ms = 20ms پایداری */
+#define KEYPAD_SETTLE_US          5      /* نشست خطوط بعد از تغییر ستون */
+#define KEYPAD_LONGPRESS_MS       1000
+#define KEYPAD_REPEAT_MS          200
+#define KEYPAD_QUEUE_SIZE         16     /* باید توانی از 2 باشد */
+
+typedef enum {
+    KEY_EVENT_PRESS,
+    KEY_EVENT_RELEASE,
+    KEY_EVENT_LONGPRESS,
+    KEY_EVENT_REPEAT
+} KeyEventType_t;
+
+typedef struct {
+    char key;
+    KeyEventType_t type;
+    uint32_t timestamp;     /* HAL_GetTick() لحظه پایدار شدن */
+} KeyEvent_t;
+
+void Keypad_Init(void);
+void Keypad_Sample(void);
+uint8_t Keypad_GetEvent(KeyEvent_t *event);
+char Keypad_GetKey(void);
+uint8_t Keypad_IsIdle(void);
+uint32_t Keypad_GetDroppedEvents(void);
+void Keypad_RowInterrupt(uint16_t GPIO_Pin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __KEYPAD_H */
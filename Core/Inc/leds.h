@@ -0,0 +1,46 @@
+/* =================================================================
+ * موتور الگوی LED (سبز، قرمز 1، قرمز 2)
+ *
+ * - هر الگو جدولی از گام‌های {ماسک LEDها، مدت} است
+ * - الگوی پایه (حالت سیستم) تا تعویض بعدی تکرار می‌شود
+ * - الگوی overlay (مثلاً رمز اشتباه) چند بار پخش شده و به پایه برمی‌گردد
+ * - پیشروی در وقفه SysTick انجام می‌شود؛ هیچ تابعی block نمی‌کند
+ * ================================================================= */
+
+#ifndef __LEDS_H
+#define __LEDS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+#define LED_MASK_GREEN      0x01
+#define LED_MASK_RED1       0x02
+#define LED_MASK_RED2       0x04
+
+typedef struct {
+    uint8_t mask;           /* LED_MASK_* روشن در این گام */
+    uint16_t duration;      /* ms؛ 0 = تا تعویض الگو ثابت بماند */
+} LedStep_t;
+
+typedef struct {
+    const LedStep_t *steps;
+    uint8_t count;
+    uint8_t repeat;         /* فقط برای overlay: تعداد پخش (0 = 1 بار) */
+} LedPattern_t;
+
+void Leds_Init(void);
+void Leds_SetPattern(const LedPattern_t *pattern);
+void Leds_PlayOverlay(const LedPattern_t *pattern);
+void Leds_SetMask(uint8_t mask);
+uint8_t Leds_GetMask(void);
+uint8_t Leds_IsAnimating(void);
+void Leds_Tick(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LEDS_H */
@@ -59,6 +59,66 @@ void Error_Handler(void);
 /* Private defines -----------------------------------------------------------*/
 
 /* USER CODE BEGIN Private defines */
+/* تعریف پین‌های LCD */
+#define LCD_RS_Pin GPIO_PIN_0
+#define LCD_RS_GPIO_Port GPIOA
+#define LCD_EN_Pin GPIO_PIN_1
+#define LCD_EN_GPIO_Port GPIOA
+#define LCD_RW_Pin GPIO_PIN_2
+#define LCD_RW_GPIO_Port GPIOA
+#define LCD_D4_Pin GPIO_PIN_4
+#define LCD_D4_GPIO_Port GPIOA
+#define LCD_D5_Pin GPIO_PIN_5
+#define LCD_D5_GPIO_Port GPIOA
+#define LCD_D6_Pin GPIO_PIN_6
+#define LCD_D6_GPIO_Port GPIOA
+#define LCD_D7_Pin GPIO_PIN_7
+#define LCD_D7_GPIO_Port GPIOA
+
+/* تعریف پین‌های LED و Buzzer */
+#define LED_GREEN_Pin GPIO_PIN_8
+#define LED_GREEN_GPIO_Port GPIOA
+#define LED_RED1_Pin GPIO_PIN_9
+#define LED_RED1_GPIO_Port GPIOA
+#define LED_RED2_Pin GPIO_PIN_10
+#define LED_RED2_GPIO_Port GPIOA
+#define BUZZER_Pin GPIO_PIN_11
+#define BUZZER_GPIO_Port GPIOA
+
+/* تعریف پین‌های سنسورها */
+#define RFID_CARD1_Pin GPIO_PIN_0
+#define RFID_CARD1_GPIO_Port GPIOB
+#define RFID_CARD2_Pin GPIO_PIN_1
+#define RFID_CARD2_GPIO_Port GPIOB
+#define PIR_SENSOR_Pin GPIO_PIN_2
+#define PIR_SENSOR_GPIO_Port GPIOB
+#define RFID_CARD3_Pin GPIO_PIN_3
+#define RFID_CARD3_GPIO_Port GPIOB
+
+/* تعریف پین‌های کیپد */
+#define KEYPAD_ROW1_Pin GPIO_PIN_0
+#define KEYPAD_ROW1_GPIO_Port GPIOC
+#define KEYPAD_ROW2_Pin GPIO_PIN_1
+#define KEYPAD_ROW2_GPIO_Port GPIOC
+#define KEYPAD_ROW3_Pin GPIO_PIN_2
+#define KEYPAD_ROW3_GPIO_Port GPIOC
+#define KEYPAD_ROW4_Pin GPIO_PIN_3
+#define KEYPAD_ROW4_GPIO_Port GPIOC
+#define KEYPAD_COL1_Pin GPIO_PIN_4
+#define KEYPAD_COL1_GPIO_Port GPIOC
+#define KEYPAD_COL2_Pin GPIO_PIN_5
+#define KEYPAD_COL2_GPIO_Port GPIOC
+#define KEYPAD_COL3_Pin GPIO_PIN_6
+#define KEYPAD_COL3_GPIO_Port GPIOC
+#define KEYPAD_COL4_Pin GPIO_PIN_7
+#define KEYPAD_COL4_GPIO_Port GPIOC
+
+#define KEYPAD_ROW_PINS (KEYPAD_ROW1_Pin|KEYPAD_ROW2_Pin|KEYPAD_ROW3_Pin|KEYPAD_ROW4_Pin)
+#define KEYPAD_COL_PINS (KEYPAD_COL1_Pin|KEYPAD_COL2_Pin|KEYPAD_COL3_Pin|KEYPAD_COL4_Pin)
+
+/* 1: ستون‌ها LOW و ردیف‌ها EXTI؛ اسکن فقط بعد از وقفه ردیف
+ * 0: اسکن پیوسته ماتریس در هر فراخوانی */
+#define KEYPAD_USE_EXTI 1
 
 /* USER CODE END Private defines */
 
@@ -0,0 +1,44 @@
+/* =================================================================
+ * مدیریت توان در زمان بی‌کاری (Stop mode)
+ *
+ * - جایگزین Scheduler_Idle پیش‌فرض (WFI ساده)
+ * - وقتی همه ماژول‌ها بی‌کارند هسته به Stop می‌رود و SysTick می‌ایستد
+ * - بیدار شدن: EXTI ردیف‌های کیپد یا تایمر wakeup ساعت RTC (LSI)
+ * - حسگرها (PB0-PB3) در حالت مسلح با wakeup دوره‌ای RTC نمونه‌برداری می‌شوند
+ * - بعد از بیدار شدن PLL بازیابی و HAL_GetTick با زمان خواب جبران می‌شود
+ * ================================================================= */
+
+#ifndef __POWER_H
+#define __POWER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+#define POWER_USE_STOP          1
+#define POWER_STOP_MIN_MS       20      /* کمتر از این فقط WFI */
+#define POWER_STOP_MAX_MS       1000    /* سقف خواب در حالت غیرمسلح */
+#define POWER_SENSOR_POLL_MS    50      /* فاصله نمونه‌برداری حسگرها در حالت مسلح */
+#define POWER_LSI_HZ            32000   /* مقدار نامی LSI در STM32F401 */
+
+typedef struct {
+    uint32_t stopCount;
+    uint32_t sleepCount;            /* خواب سبک با WFI */
+    uint32_t stopTimeMs;            /* مجموع زمان Stop */
+    uint32_t lastRestoreUs;         /* بیدار شدن تا برگشت PLL */
+    uint32_t lastWakeLatencyUs;     /* بیدار شدن تا شروع پردازش ورودی */
+    uint32_t maxWakeLatencyUs;
+} PowerStats_t;
+
+void Power_Init(void);
+void Power_WakeHandled(void);
+const PowerStats_t* Power_GetStats(void);
+void Power_RtcWakeupIRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __POWER_H */
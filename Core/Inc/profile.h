@@ -0,0 +1,72 @@
+/* =================================================================
+ * پروفایلر سیکلی توابع داغ و وقفه‌ها
+ *
+ * - PROFILE_BEGIN() در ابتدای تابع و PROFILE_END(id) قبل از تنها خروجی آن
+ * - برای هر شناسه: تعداد فراخوانی، مجموع سیکل و بیشترین سیکل (DWT)
+ * - زمان وقفه‌های تو در تو در زمان تابع قطع‌شده هم حساب می‌شود
+ * - جدول هر PROFILE_REPORT_MS به صورت متن روی ITM پورت 0 (SWO) فرستاده
+ *   می‌شود؛ هر اجرای Profile_Task فقط تا جایی که FIFO جا دارد می‌نویسد
+ * - ITM/SWO باید از طرف دیباگر فعال شده باشد؛ وگرنه گزارش دور ریخته می‌شود
+ * - با PROFILE_ENABLE=0 همه نقاط اندازه‌گیری حذف می‌شوند
+ * ================================================================= */
+
+#ifndef __PROFILE_H
+#define __PROFILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+#ifndef PROFILE_ENABLE
+#define PROFILE_ENABLE          0
+#endif
+
+#define PROFILE_REPORT_MS       1000    /* فاصله شروع گزارش‌ها */
+#define PROFILE_TASK_PERIOD     5       /* ms */
+#define PROFILE_TX_BUDGET       32      /* حداکثر بایت در هر اجرای تسک */
+#define PROFILE_ITM_PORT        0
+
+typedef enum {
+    PROF_KEYPAD_SAMPLE,
+    PROF_KEYPAD_GETKEY,
+    PROF_LCD_SEND_DATA,
+    PROF_LCD_FLUSH,
+    PROF_SECURITY_SENSORS,
+    PROF_SECURITY_EVENTS,       /* ماشین حالت، شامل ورود به آلارم */
+    PROF_CARDS_LOOKUP,
+    PROF_ISR_SYSTICK,
+    PROF_ISR_EXTI,
+    PROF_ISR_TIM3,
+    PROF_ISR_RTC,
+    PROF_ISR_DMA,
+    PROF_COUNT
+} ProfileId_t;
+
+typedef struct {
+    uint32_t calls;
+    uint64_t totalCycles;
+    uint32_t maxCycles;
+} ProfileEntry_t;
+
+void Profile_Init(void);
+void Profile_Reset(void);
+void Profile_Record(ProfileId_t id, uint32_t cycles);
+uint8_t Profile_Get(ProfileId_t id, ProfileEntry_t *entry);
+void Profile_Task(void);
+uint8_t Profile_IsIdle(void);
+
+#if PROFILE_ENABLE
+#define PROFILE_BEGIN()         uint32_t profileStart = DWT->CYCCNT
+#define PROFILE_END(id)         Profile_Record((id), DWT->CYCCNT - profileStart)
+#else
+#define PROFILE_BEGIN()         ((void)0)
+#define PROFILE_END(id)         ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PROFILE_H */
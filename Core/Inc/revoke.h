@@ -0,0 +1,54 @@
+/* =================================================================
+ * فهرست کارت‌های باطل‌شده با فیلتر Bloom جلوی آن
+ *
+ * - فهرست: UID های باطل‌شده، مرتب (اول طول، بعد بایت‌ها)، با جست‌وجوی
+ *   دودویی
+ * - فیلتر: m بیت و k درهم از یک SipHash کلیددار (h1 + i*h2)؛ اگر حتی یک
+ *   بیت صفر باشد کارت قطعاً باطل نیست و فهرست اصلاً خوانده نمی‌شود
+ * - نرخ مثبت کاذب هنگام ساخت انتخاب می‌شود (Host/revoke_gen -p)
+ * - هر دو با تغییر فهرست از نو ساخته می‌شوند (Core/Src/revoke_table.c)؛
+ *   پیکربندی معتبر flash (config.h) جدول خودش را جایگزین می‌کند
+ * ================================================================= */
+
+#ifndef __REVOKE_H
+#define __REVOKE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "cards.h"
+#include "integrity.h"
+
+typedef struct {
+    uint8_t key[HASH_KEY_SIZE];
+    uint32_t filterBits;                /* m؛ صفر یعنی فهرست خالی */
+    uint8_t hashCount;                  /* k */
+    const uint32_t *filter;
+    uint32_t count;
+    const CardUid_t *uids;
+} RevokeTable_t;
+
+typedef struct {
+    uint32_t checks;
+    uint32_t filterHits;                /* فیلتر "شاید" گفت و فهرست خوانده شد */
+    uint32_t revoked;
+} RevokeStats_t;
+
+/* revoke_table.c (تولید شده) */
+extern const RevokeTable_t revokeTable;
+extern const IntegrityImage_t revokeTableCrc;           /* فیلتر و فهرست */
+
+uint8_t Revoke_IsRevoked(const CardUid_t *uid);
+void Revoke_SetTable(const RevokeTable_t *table);
+uint8_t Revoke_IsRevokedIn(const RevokeTable_t *table, const CardUid_t *uid, uint8_t *filterHit);
+uint8_t Revoke_FilterMayContain(const RevokeTable_t *table, const CardUid_t *uid);
+void Revoke_GetStats(RevokeStats_t *stats);
+void Revoke_ResetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __REVOKE_H */
@@ -0,0 +1,51 @@
+/* =================================================================
+ * زمان‌بند همکارانه (Cooperative Scheduler)
+ *
+ * - مبنای زمانی: SysTick (HAL_GetTick) با دقت 1ms
+ * - تسک‌های دوره‌ای و یک‌باره (one-shot)
+ * - برای هر تسک: دوره، deadline و آمار تأخیر ثبت می‌شود
+ * - وقتی هیچ تسکی آماده نیست، هسته با WFI می‌خوابد
+ * ================================================================= */
+
+#ifndef __SCHEDULER_H
+#define __SCHEDULER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+#define SCHEDULER_MAX_TASKS     12
+#define SCHEDULER_INVALID_ID    0xFF
+
+typedef void (*TaskFunction_t)(void);
+
+typedef struct {
+    TaskFunction_t function;
+    uint32_t period;          /* 0 = تسک یک‌باره */
+    uint32_t deadline;        /* حداکثر تأخیر مجاز شروع نسبت به زمان موعد (ms) */
+    uint32_t nextRun;         /* زمان موعد بعدی (tick) */
+    uint32_t runCount;
+    uint32_t deadlineMisses;
+    uint32_t maxLateness;     /* بیشترین تأخیر شروع مشاهده شده (ms) */
+    uint8_t  active;
+} Task_t;
+
+void Scheduler_Init(void);
+uint8_t Scheduler_AddTask(TaskFunction_t function, uint32_t period, uint32_t offset, uint32_t deadline);
+uint8_t Scheduler_AddOneShot(TaskFunction_t function, uint32_t delay, uint32_t deadline);
+void Scheduler_RemoveTask(uint8_t id);
+void Scheduler_Run(void);
+uint32_t Scheduler_TimeToNextTask(void);
+uint32_t Scheduler_TimeToNextOneShot(void);
+void Scheduler_Resume(void);
+void Scheduler_Realign(void);
+const Task_t* Scheduler_GetTask(uint8_t id);
+void Scheduler_Idle(uint32_t timeToNext);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SCHEDULER_H */
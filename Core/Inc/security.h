@@ -0,0 +1,74 @@
+/* =================================================================
+ * ماشین حالت سیستم امنیتی (جدول‌محور)
+ *
+ * - جدول انتقال [حالت][رویداد] = {guard، action، حالت بعدی}
+ * - هر حالت توابع entry/exit و timeout اختیاری دارد
+ * - رویدادها (کلید، کارت، حرکت، timeout) در صف قرار گرفته و
+ *   هر کدام با یک دسترسی به جدول (O(1)) پردازش می‌شوند
+ * - هیچ تابعی block نمی‌کند و هیچ انتقالی بازگشتی نیست
+ * ================================================================= */
+
+#ifndef __SECURITY_H
+#define __SECURITY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "cards.h"
+
+#define SECURITY_QUEUE_SIZE         16      /* باید توانی از 2 باشد */
+#define SECURITY_PIN_SHOW_MS        1500    /* مکث بعد از آخرین رقم (از حداقل طول) تا بررسی خودکار */
+#define SECURITY_GRANTED_SHOW_MS    2000
+#define SECURITY_DENIED_SHOW_MS     1800    /* 3 x (300 + 300) چشمک */
+
+typedef enum {
+    SYSTEM_ARMED,
+    SYSTEM_DISARMED,
+    SYSTEM_ALARM,
+    SYSTEM_PASSWORD_ENTRY,
+    SYSTEM_ACCESS_GRANTED,
+    SYSTEM_ACCESS_DENIED,
+    SYSTEM_STATE_COUNT
+} SystemState_t;
+
+typedef enum {
+    SEC_EVENT_KEY_DIGIT,
+    SEC_EVENT_KEY_CLEAR,
+    SEC_EVENT_KEY_ENTER,
+    SEC_EVENT_CARD_VALID,
+    SEC_EVENT_CARD_INVALID,
+    SEC_EVENT_MOTION,
+    SEC_EVENT_PIN_OK,
+    SEC_EVENT_PIN_BAD,
+    SEC_EVENT_TIMEOUT,
+    SEC_EVENT_COUNT
+} SecurityEventType_t;
+
+typedef struct {
+    SecurityEventType_t type;
+    char key;               /* فقط برای SEC_EVENT_KEY_DIGIT */
+    uint32_t timestamp;
+} SecurityEvent_t;
+
+void Security_Init(void);
+uint8_t Security_PostEvent(SecurityEventType_t type, char key);
+void Security_PostKey(char key);
+void Security_PresentCard(const CardUid_t *uid);
+void Security_CheckSensors(void);
+void Security_ProcessEvents(void);
+SystemState_t Security_GetState(void);
+uint8_t Security_IsIdle(void);
+uint8_t Security_NeedsSensors(void);
+uint32_t Security_GetMaxDispatchCycles(void);     /* DWT روی برد؛ ساعت مجازی Host داخل dispatch جلو نمی‌رود */
+uint32_t Security_GetDroppedEvents(void);
+uint16_t Security_GetLastUser(void);
+uint32_t Security_GetFailedAttempts(void);
+void Security_EventHandled(const SecurityEvent_t *event);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SECURITY_H */
@@ -0,0 +1,33 @@
+/* =================================================================
+ * سرویس زمان‌سنجی میکروثانیه با شمارنده سیکل DWT (Cortex-M4)
+ *
+ * - delay_us کالیبره شده بر اساس SystemCoreClock
+ * - زمان‌مهر 64 بیتی میکروثانیه (سرریز CYCCNT در SysTick جبران می‌شود)
+ * - توابع زمان سپری شده که سرریز 32 بیتی را درست حساب می‌کنند
+ * ================================================================= */
+
+#ifndef __TIMING_H
+#define __TIMING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+void Timing_Init(void);
+void Timing_Update(void);
+void delay_us(uint32_t us);
+uint32_t Timing_GetCycles(void);
+uint64_t Timing_GetMicros64(void);
+uint32_t Timing_ElapsedCycles(uint32_t startCycles);
+uint32_t Timing_ElapsedUs(uint32_t startCycles);
+uint32_t Timing_CyclesToUs(uint32_t cycles);
+uint32_t Timing_CyclesPerUs(void);
+void Timing_AddSleep(uint32_t us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIMING_H */
@@ -0,0 +1,65 @@
+/* =================================================================
+ * جدول کاربران با رمز درهم‌شده در flash
+ *
+ * - هر کاربر: شناسه، salt تصادفی 8 بایتی و SipHash(salt|pepper، رمز)
+ * - رمزها 4 تا 8 رقم؛ خود رمز و طولش ذخیره نمی‌شود
+ * - نمایه: سطل = SipHash(pepper، 4 رقم اول) % USERS_BUCKETS؛ رکوردها
+ *   بر اساس سطل مرتب‌اند و usersIndex شروع هر سطل را نگه می‌دارد
+ * - هر تلاش دقیقاً USERS_BUCKET_MAX درهم‌سازی و مقایسه انجام می‌دهد
+ *   (جای خالی سطل با کار ساختگی پر می‌شود)، پس زمان بررسی مستقل از
+ *   تعداد کاربران، محل تطابق و درستی رمز است
+ * - جدول با Host/users_gen ساخته می‌شود (Core/Src/users_table.c)؛ اگر
+ *   پیکربندی معتبری در flash باشد (config.h) جدول آن جایگزین می‌شود
+ * ================================================================= */
+
+#ifndef __USERS_H
+#define __USERS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "integrity.h"
+
+#define USERS_PIN_MIN_LENGTH    4
+#define USERS_PIN_MAX_LENGTH    8
+#define USERS_PREFIX_LENGTH     USERS_PIN_MIN_LENGTH
+#define USERS_BUCKETS           1024    /* برای چند هزار کاربر: میانگین چند رکورد در سطل */
+#define USERS_BUCKET_MAX        16      /* ابزار تولید جدول بیشتر از این را رد می‌کند */
+#define USERS_SALT_SIZE         8
+#define USERS_PEPPER_SIZE       8
+#define USERS_INVALID_ID        0xFFFF
+
+typedef struct {
+    uint16_t id;
+    uint16_t reserved;
+    uint8_t salt[USERS_SALT_SIZE];
+    uint64_t hash;
+} UserRecord_t;
+
+/* جدول قابل جایگزینی؛ ممکن است در slot پیکربندی flash باشد */
+typedef struct {
+    const uint8_t *pepper;              /* USERS_PEPPER_SIZE */
+    const uint16_t *index;              /* USERS_BUCKETS + 1 */
+    const UserRecord_t *records;
+    uint16_t count;
+} UsersTable_t;
+
+/* users_table.c (تولید شده) */
+extern const uint8_t usersPepper[USERS_PEPPER_SIZE];
+extern const uint16_t usersIndex[USERS_BUCKETS + 2];  /* یکی اضافه و صفر تا مضرب 4 بایت */
+extern const UserRecord_t usersRecords[];
+extern const uint16_t usersCount;
+extern const IntegrityImage_t usersTableCrc;            /* pepper، نمایه و رکوردها */
+
+uint8_t Users_Verify(const char *pin, uint8_t length, uint16_t *userId);
+uint8_t Users_VerifyIn(const UsersTable_t *table, const char *pin, uint8_t length, uint16_t *userId);
+void Users_SetTable(const UsersTable_t *table);
+uint16_t Users_Count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USERS_H */
@@ -0,0 +1,123 @@
+/* =================================================================
+ * تسک‌های برنامه
+ *
+ * ترتیب ثبت = اولویت:
+ *   حسگرها -> کیپد -> به‌روزرسانی LCD (-> گزارش پروفایلر اگر PROFILE_ENABLE)
+ *   -> نگه‌داری flash (بافر گزارش رویدادها، فشرده‌سازی EEPROM، نوشتن
+ *      پیکربندی تازه، پاک کردن‌ها)
+ * ================================================================= */
+
+#include "app.h"
+#include "scheduler.h"
+#include "keypad.h"
+#include "hd44780.h"
+#include "security.h"
+#include "power.h"
+#include "bench.h"
+#include "profile.h"
+#include "eventlog.h"
+#include "eeprom.h"
+#include "config.h"
+#include "integrity.h"
+
+static void Task_Keypad(void);
+static void Task_Sensors(void);
+static void Task_LcdFlush(void);
+static void Task_Storage(void);
+static void Task_Integrity(void);
+
+void App_StartTasks(void)
+{
+    Scheduler_Init();
+
+    /* ترتیب ثبت = اولویت */
+    Scheduler_AddTask(Task_Sensors, TASK_SENSORS_PERIOD, 0, TASK_SENSORS_DEADLINE);
+    Scheduler_AddTask(Task_Keypad, TASK_KEYPAD_PERIOD, 1, TASK_KEYPAD_DEADLINE);
+    Scheduler_AddTask(Task_LcdFlush, TASK_LCD_PERIOD, 2, TASK_LCD_DEADLINE);
+#if PROFILE_ENABLE
+    Scheduler_AddTask(Profile_Task, PROFILE_TASK_PERIOD, 3, TASK_PROFILE_DEADLINE);
+#endif
+    Scheduler_AddTask(Task_Storage, TASK_STORAGE_PERIOD, 4, TASK_STORAGE_DEADLINE);
+    Scheduler_AddTask(Task_Integrity, TASK_INTEGRITY_PERIOD, 5, TASK_INTEGRITY_DEADLINE);
+}
+
+static void Task_Keypad(void)
+{
+    KeyEvent_t event;
+
+    Power_WakeHandled();
+    Keypad_Sample();
+
+    /* فقط فشردن کلید وارد منطق رمز می‌شود؛ نگه‌داشتن کلید رقم تکراری نمی‌سازد */
+    while (Keypad_GetEvent(&event)) {
+        if (event.type == KEY_EVENT_PRESS) {
+            Security_PostKey(event.key);
+        }
+    }
+    Security_ProcessEvents();
+}
+
+static void Task_Sensors(void)
+{
+    Power_WakeHandled();
+    Security_CheckSensors();
+    Security_ProcessEvents();
+}
+
+static void Task_LcdFlush(void)
+{
+    if (LCD_IsDirty()) {
+        LCD_FlushStep(LCD_FLUSH_MAX_CELLS);
+    }
+    if (!LCD_IsDirty() && !LCD_IsBusy()) {
+        BENCH_DISPLAY_DONE(); // متن جدید کامل روی نمایشگر است
+    }
+}
+
+/* کسی پشت درب نیست: بدون کلید، رویداد، timeout یا آلارم */
+static uint8_t App_DoorIsQuiet(void)
+{
+    SystemState_t state = Security_GetState();
+
+    return Keypad_IsIdle() && Security_IsIdle()
+        && (state == SYSTEM_ARMED || state == SYSTEM_DISARMED);
+}
+
+/* نوشتن بافر گزارش، فشرده‌سازی EEPROM و یک تکه پیکربندی حداکثر چند ms است
+ * و در هر نوبت مجاز است. پاک کردن sector کل flash را چند صد ms متوقف می‌کند: فقط در سکون و
+ * حداکثر یکی در هر نوبت */
+static void Task_Storage(void)
+{
+    EventLog_Task();
+    Eeprom_Task();
+    Config_Task();
+
+    if (!App_DoorIsQuiet()) {
+        return;
+    }
+    if (EventLog_NeedsErase()) {
+        EventLog_EraseNext();
+    } else if (Eeprom_NeedsErase()) {
+        Eeprom_EraseSpare();
+    } else if (Config_NeedsErase()) {
+        Config_EraseInactive();
+    } else {
+        return;
+    }
+    Scheduler_Resume(); // توقف برنامه‌ریزی‌شده در آمار deadline حساب نمی‌شود
+}
+
+/* برش‌های DMA با CPU رقابتی ندارند ولی گذرگاه flash را با کد اجرایی شریک‌اند:
+ * فقط در سکون */
+static void Task_Integrity(void)
+{
+    if (App_DoorIsQuiet()) {
+        Integrity_Task();
+    }
+}
+
+/* وقفه ردیف‌های کیپد (EXTI0-3) */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+    Keypad_RowInterrupt(GPIO_Pin);
+}
@@ -0,0 +1,229 @@
+/* =================================================================
+ * بنچمارک تأخیر سرتاسری - پیاده‌سازی
+ *
+ * هر منبع (کیپد، کارت، PIR) یک زمان‌مهر در انتظار دارد. Bench_Stimulus
+ * فقط اولین مشاهده را نگه می‌دارد (لبه‌های بعدی همان فشردن نادیده
+ * گرفته می‌شوند)؛ Bench_StimulusAt زمان دقیق بیرونی است و جایگزین می‌شود.
+ * پردازش رویداد متناظر زمان‌مهر را مصرف و مسیر را «منتظر نمایش» می‌کند؛
+ * اولین باری که LCD کاملاً به‌روز شد نمونه ثبت می‌شود.
+ *
+ * اگر ورودی هسته را از Stop بیدار کند، CYCCNT از همان وقفه می‌شمارد؛
+ * تأخیر بیدار شدن جداگانه در Power_GetStats است.
+ * ================================================================= */
+
+#include "bench.h"
+
+static const char* const pathNames[BENCH_PATH_COUNT] = {
+    [BENCH_KEY_ENTRY]  = "key entry",
+    [BENCH_CARD_GRANT] = "card grant",
+    [BENCH_CARD_DENY]  = "card deny",
+    [BENCH_PIR_ALARM]  = "PIR alarm",
+    [BENCH_PIN_FAIL]   = "PIN fail",
+};
+
+#if BENCH_ENABLE
+
+#include "hd44780.h"
+#include "timing.h"
+
+typedef struct {
+    uint32_t samples[BENCH_MAX_SAMPLES];   /* سیکل */
+    uint32_t count;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint32_t start;                         /* شروع نمونه منتظر نمایش */
+    uint8_t waiting;
+} BenchPathData_t;
+
+static BenchPathData_t paths[BENCH_PATH_COUNT];
+static volatile uint32_t stimulusTime[BENCH_SRC_COUNT];
+static volatile uint8_t stimulusValid[BENCH_SRC_COUNT];
+static uint32_t enterTime = 0;          /* شروع مسیر رمز اشتباه: کلید '=' */
+static uint8_t enterValid = 0;
+
+void Bench_Reset(void)
+{
+    for (int p = 0; p < BENCH_PATH_COUNT; p++) {
+        paths[p].count = 0;
+        paths[p].minCycles = 0;
+        paths[p].maxCycles = 0;
+        paths[p].waiting = 0;
+    }
+    for (int s = 0; s < BENCH_SRC_COUNT; s++) {
+        stimulusValid[s] = 0;
+    }
+    enterValid = 0;
+}
+
+/* از وقفه هم صدا زده می‌شود */
+void Bench_Stimulus(BenchSource_t source)
+{
+    if (!stimulusValid[source]) {
+        stimulusTime[source] = Timing_GetCycles();
+        stimulusValid[source] = 1;
+    }
+}
+
+void Bench_StimulusAt(BenchSource_t source, uint32_t cycles)
+{
+    stimulusTime[source] = cycles;
+    stimulusValid[source] = 1;
+}
+
+/* زمان‌مهر ورودی را برمی‌دارد؛ 0 یعنی ورودی اندازه‌گیری نشده */
+static uint8_t Bench_Take(BenchSource_t source, uint32_t *start)
+{
+    if (!stimulusValid[source]) {
+        return 0;
+    }
+    *start = stimulusTime[source];
+    stimulusValid[source] = 0;
+    return 1;
+}
+
+static void Bench_Record(BenchPathData_t *p, uint32_t cycles)
+{
+    if (p->count == 0 || cycles < p->minCycles) p->minCycles = cycles;
+    p->samples[p->count % BENCH_MAX_SAMPLES] = cycles;
+    p->count++;
+    if (cycles > p->maxCycles) p->maxCycles = cycles;
+}
+
+static void Bench_Wait(BenchPath_t path, uint32_t start)
+{
+    paths[path].start = start;
+    paths[path].waiting = 1;
+}
+
+/* بعد از هر رویداد ماشین حالت؛ state حالت بعد از انتقال است */
+void Bench_EventHandled(SecurityEventType_t type, SystemState_t state)
+{
+    uint32_t start;
+
+    switch (type) {
+        case SEC_EVENT_KEY_DIGIT:
+            if (Bench_Take(BENCH_SRC_KEY, &start) && state == SYSTEM_PASSWORD_ENTRY) {
+                Bench_Wait(BENCH_KEY_ENTRY, start);
+            }
+            enterValid = 0;
+            break;
+        case SEC_EVENT_KEY_CLEAR:
+            Bench_Take(BENCH_SRC_KEY, &start);
+            enterValid = 0;
+            break;
+        case SEC_EVENT_KEY_ENTER:
+            enterValid = Bench_Take(BENCH_SRC_KEY, &enterTime);
+            break;
+        case SEC_EVENT_CARD_VALID:
+            if (Bench_Take(BENCH_SRC_CARD, &start) && state == SYSTEM_DISARMED) {
+                Bench_Wait(BENCH_CARD_GRANT, start);
+            }
+            break;
+        case SEC_EVENT_CARD_INVALID:
+            if (Bench_Take(BENCH_SRC_CARD, &start) && state == SYSTEM_ALARM) {
+                Bench_Wait(BENCH_CARD_DENY, start);
+            }
+            break;
+        case SEC_EVENT_MOTION:
+            if (Bench_Take(BENCH_SRC_PIR, &start) && state == SYSTEM_ALARM) {
+                Bench_Wait(BENCH_PIR_ALARM, start);
+            }
+            break;
+        case SEC_EVENT_PIN_BAD:
+            /* بررسی خودکار بعد از SECURITY_PIN_SHOW_MS مکث عمدی است، نه تأخیر: فقط با '=' */
+            if (enterValid && state == SYSTEM_ACCESS_DENIED) {
+                Bench_Wait(BENCH_PIN_FAIL, enterTime);
+            }
+            enterValid = 0;
+            break;
+        default:
+            break;
+    }
+
+    /* متن تغییری نکرده (framebuffer از قبل همین بود) */
+    if (!LCD_IsDirty() && !LCD_IsBusy()) {
+        Bench_DisplayDone();
+    }
+}
+
+/* LCD کاملاً با framebuffer یکسان است */
+void Bench_DisplayDone(void)
+{
+    uint32_t now = Timing_GetCycles();
+
+    for (int p = 0; p < BENCH_PATH_COUNT; p++) {
+        if (paths[p].waiting) {
+            paths[p].waiting = 0;
+            Bench_Record(&paths[p], now - paths[p].start);
+        }
+    }
+}
+
+#if LCD_USE_DMA
+/* پایان DMA: بدون انتظار برای دور بعدی تسک LCD */
+void LCD_TransferCompleteCallback(void)
+{
+    if (!LCD_IsDirty()) {
+        Bench_DisplayDone();
+    }
+}
+#endif
+
+/* نزدیک‌ترین رتبه: کوچک‌ترین نمونه‌ای که دست‌کم percent درصد نمونه‌ها از آن کوچک‌تر یا مساوی‌اند */
+static uint32_t Bench_Percentile(const uint32_t *sorted, uint32_t n, uint32_t percent)
+{
+    uint32_t rank = (n * percent + 99U) / 100U;
+    return sorted[(rank > 0) ? rank - 1 : 0];
+}
+
+uint8_t Bench_GetResult(BenchPath_t path, BenchResult_t *result)
+{
+    static uint32_t sorted[BENCH_MAX_SAMPLES];
+    const BenchPathData_t *p = &paths[path];
+    uint32_t n = (p->count < BENCH_MAX_SAMPLES) ? p->count : BENCH_MAX_SAMPLES;
+
+    result->count = p->count;
+    if (n == 0) {
+        result->minUs = result->medianUs = result->p99Us = result->maxUs = 0;
+        return 0;
+    }
+
+    /* مرتب‌سازی درجی روی کپی؛ فقط هنگام گزارش اجرا می‌شود */
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t value = p->samples[i];
+        uint32_t j = i;
+        while (j > 0 && sorted[j - 1] > value) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = value;
+    }
+
+    result->minUs = Timing_CyclesToUs(p->minCycles);
+    result->medianUs = Timing_CyclesToUs(Bench_Percentile(sorted, n, 50));
+    result->p99Us = Timing_CyclesToUs(Bench_Percentile(sorted, n, 99));
+    result->maxUs = Timing_CyclesToUs(p->maxCycles);
+    return 1;
+}
+
+#else /* !BENCH_ENABLE */
+
+void Bench_Reset(void) {}
+void Bench_Stimulus(BenchSource_t source) { (void)source; }
+void Bench_StimulusAt(BenchSource_t source, uint32_t cycles) { (void)source; (void)cycles; }
+void Bench_EventHandled(SecurityEventType_t type, SystemState_t state) { (void)type; (void)state; }
+void Bench_DisplayDone(void) {}
+
+uint8_t Bench_GetResult(BenchPath_t path, BenchResult_t *result)
+{
+    (void)path;
+    result->count = result->minUs = result->medianUs = result->p99Us = result->maxUs = 0;
+    return 0;
+}
+
+#endif /* BENCH_ENABLE */
+
+const char* Bench_PathName(BenchPath_t path)
+{
+    return pathNames[path];
+}
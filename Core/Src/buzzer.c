@@ -0,0 +1,193 @@
+/* =================================================================
+ * درایور بازر - پیاده‌سازی
+ *
+ * PA11 فقط به کانال 4 تایمر TIM1 وصل می‌شود که پالس‌دهی DMA نمایشگر
+ * را انجام می‌دهد؛ بنابراین خروجی به جای PWM سخت‌افزاری با وقفه update
+ * تایمر TIM3 (پایه 1us) ساخته می‌شود:
+ *   بوق با فرکانس f: ARR = نیم‌دوره، پین در هر update یک بار toggle
+ *   بوق DC و سکوت:   ARR = 1ms، فقط شمارش
+ * ================================================================= */
+
+#include "buzzer.h"
+
+typedef enum {
+    BUZZER_IDLE,
+    BUZZER_TONE,
+    BUZZER_GAP
+} BuzzerPhase_t;
+
+static BuzzerTone_t queue[BUZZER_QUEUE_SIZE];
+static volatile uint8_t queueHead = 0;
+static volatile uint8_t queueTail = 0;
+
+static BuzzerTone_t loopTones[BUZZER_LOOP_MAX_TONES];
+static volatile uint8_t loopCount = 0;
+
+static volatile BuzzerPhase_t phase = BUZZER_IDLE;
+static BuzzerTone_t current;
+static uint32_t remaining = 0;          /* update های باقی‌مانده در فاز فعلی */
+static uint8_t toggling = 0;
+
+static void Buzzer_NextTone(void);
+
+void Buzzer_Init(void)
+{
+    __HAL_RCC_TIM3_CLK_ENABLE();
+
+    /* کلاک تایمرهای APB1 اگر prescaler باس 1 نباشد دو برابر PCLK1 است */
+    uint32_t timerClock = HAL_RCC_GetPCLK1Freq();
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != 0) {
+        timerClock *= 2;
+    }
+
+    TIM3->CR1 = 0;                                  /* بدون preload: ARR جدید همان دوره اعمال می‌شود */
+    TIM3->PSC = timerClock / 1000000U - 1U;         /* 1 تیک = 1us */
+    TIM3->ARR = 999;
+    TIM3->EGR = TIM_EGR_UG;
+    TIM3->SR = 0;
+    TIM3->DIER = TIM_DIER_UIE;
+
+    HAL_NVIC_SetPriority(TIM3_IRQn, 7, 0);
+    HAL_NVIC_EnableIRQ(TIM3_IRQn);
+
+    HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin, GPIO_PIN_RESET);
+}
+
+/* اگر تایمر خاموش است، پخش را شروع کن (با وقفه‌های غیرفعال صدا زده می‌شود) */
+static void Buzzer_Kick(void)
+{
+    if (phase == BUZZER_IDLE) {
+        Buzzer_NextTone();
+    }
+}
+
+uint8_t Buzzer_Play(const BuzzerTone_t *tones, uint8_t count)
+{
+    uint8_t queued = 0;
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    while (queued < count) {
+        uint8_t next = (queueHead + 1) & (BUZZER_QUEUE_SIZE - 1);
+        if (next == queueTail) {
+            break; // صف پر است
+        }
+        queue[queueHead] = tones[queued++];
+        queueHead = next;
+    }
+    Buzzer_Kick();
+    __set_PRIMASK(primask);
+
+    return queued;
+}
+
+uint8_t Buzzer_Beep(uint16_t duration)
+{
+    BuzzerTone_t tone = {0, duration, 0};
+    return Buzzer_Play(&tone, 1);
+}
+
+/* الگو بعد از خالی شدن صف تا Buzzer_Stop تکرار می‌شود */
+void Buzzer_PlayLoop(const BuzzerTone_t *tones, uint8_t count)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    if (count > BUZZER_LOOP_MAX_TONES) {
+        count = BUZZER_LOOP_MAX_TONES;
+    }
+
+    __disable_irq();
+    for (uint8_t i = 0; i < count; i++) {
+        loopTones[i] = tones[i];
+    }
+    loopCount = count;
+    Buzzer_Kick();
+    __set_PRIMASK(primask);
+}
+
+void Buzzer_Stop(void)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    TIM3->CR1 &= ~TIM_CR1_CEN;
+    TIM3->SR = 0;
+    queueTail = queueHead;
+    loopCount = 0;
+    phase = BUZZER_IDLE;
+    HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin, GPIO_PIN_RESET);
+    __set_PRIMASK(primask);
+}
+
+uint8_t Buzzer_IsBusy(void)
+{
+    return phase != BUZZER_IDLE;
+}
+
+/* شروع فاز با ARR داده شده (us) و تعداد update */
+static void Buzzer_StartPhase(uint32_t periodUs, uint32_t updates)
+{
+    TIM3->CR1 &= ~TIM_CR1_CEN;
+    TIM3->ARR = periodUs - 1U;
+    TIM3->CNT = 0;
+    TIM3->SR = 0;
+    remaining = (updates > 0) ? updates : 1;
+    TIM3->CR1 |= TIM_CR1_CEN;
+}
+
+static void Buzzer_NextTone(void)
+{
+    if (queueTail != queueHead) {
+        current = queue[queueTail];
+        queueTail = (queueTail + 1) & (BUZZER_QUEUE_SIZE - 1);
+    } else if (loopCount > 0) {
+        /* صف خالی است: الگوی تکراری دوباره در صف */
+        for (uint8_t i = 1; i < loopCount; i++) {
+            queue[queueHead] = loopTones[i];
+            queueHead = (queueHead + 1) & (BUZZER_QUEUE_SIZE - 1);
+        }
+        current = loopTones[0];
+    } else {
+        TIM3->CR1 &= ~TIM_CR1_CEN;
+        HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin, GPIO_PIN_RESET);
+        phase = BUZZER_IDLE;
+        return;
+    }
+
+    phase = BUZZER_TONE;
+    HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin, GPIO_PIN_SET);
+
+    if (current.frequency == 0) {
+        toggling = 0;
+        Buzzer_StartPhase(1000, current.duration);
+    } else {
+        uint32_t halfPeriod = 500000U / current.frequency;
+        toggling = 1;
+        Buzzer_StartPhase(halfPeriod, (uint32_t)current.duration * 1000U / halfPeriod);
+    }
+}
+
+/* از TIM3_IRQHandler صدا زده می‌شود */
+void Buzzer_IRQHandler(void)
+{
+    if (!(TIM3->SR & TIM_SR_UIF)) {
+        return;
+    }
+    TIM3->SR = ~(uint32_t)TIM_SR_UIF;
+
+    if (phase == BUZZER_TONE && toggling) {
+        HAL_GPIO_TogglePin(BUZZER_GPIO_Port, BUZZER_Pin);
+    }
+
+    if (--remaining > 0) {
+        return;
+    }
+
+    if (phase == BUZZER_TONE && current.gap > 0) {
+        phase = BUZZER_GAP;
+        HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin, GPIO_PIN_RESET);
+        Buzzer_StartPhase(1000, current.gap);
+    } else {
+        Buzzer_NextTone();
+    }
+}
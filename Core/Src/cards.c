@@ -0,0 +1,135 @@
+/* =================================================================
+ * پایگاه کارت‌ها - جست‌وجو در جدول cuckoo
+ *
+ * h = SipHash(کلید جدول، طول | UID)
+ *   برچسب = 32 بیت بالای h (صفر یعنی خانه خالی، پس به 1 نگاشت می‌شود)
+ *   سطل 1 = 32 بیت پایین h در بازه [0، n)
+ *   سطل 2 = سطل 1 + 1 + (برچسب درهم‌شده در [0، n-1))، به پیمانه n
+ * سطل 2 همیشه با سطل 1 فرق دارد و فقط به سطل 1 و برچسب وابسته است.
+ *
+ * درهم‌سازی کامل: سطل = 32 بیت پایین h در [0، B)،
+ *   مکان = (32 بیت بالای h) XOR درهم(pilot سطل)، در بازه [0، n)
+ * ================================================================= */
+
+#include "cards.h"
+#include "profile.h"
+#include <string.h>
+
+#if CARDS_STORE == CARDS_STORE_PACKED
+#define CARDS_BUILTIN       cardsPackedTable
+#elif CARDS_STORE == CARDS_STORE_PERFECT
+#define CARDS_BUILTIN       cardsPerfectTable
+#else
+#define CARDS_BUILTIN       cardsTable
+#endif
+
+/* جدول firmware یا جدول تصویر پیکربندی فعال (Cards_SetTable) */
+static const CardsStoreTable_t *activeTable = &CARDS_BUILTIN;
+
+/* x در بازه [0، n) بدون تقسیم */
+static uint32_t Cards_Range(uint32_t x, uint32_t n)
+{
+    return (uint32_t)(((uint64_t)x * n) >> 32);
+}
+
+/* طول هم درهم می‌شود تا UID های هم‌پیشوند با طول متفاوت جدا بمانند */
+uint64_t Cards_Hash(const uint8_t key[HASH_KEY_SIZE], const CardUid_t *uid)
+{
+    uint8_t data[1 + CARDS_UID_MAX];
+
+    data[0] = uid->length;
+    memcpy(&data[1], uid->bytes, uid->length);
+    return Hash_SipHash(key, data, 1U + uid->length);
+}
+
+void Cards_Locate(const CardTable_t *table, const CardUid_t *uid, uint32_t *tag, uint32_t *bucket1, uint32_t *bucket2)
+{
+    uint32_t n = table->bucketCount;
+    uint64_t h = Cards_Hash(table->key, uid);
+
+    uint32_t t = (uint32_t)(h >> 32);
+    *tag = (t == CARDS_EMPTY_TAG) ? 1U : t;
+    *bucket1 = Cards_Range((uint32_t)h, n);
+    *bucket2 = (n > 1) ? (*bucket1 + 1U + Cards_Range(*tag * 0x9E3779B1U, n - 1U)) % n : *bucket1;
+}
+
+static uint8_t Cards_ValidLength(uint8_t length)
+{
+    return length == 4 || length == 7 || length == 10;
+}
+
+/* حداکثر 2 x CARDS_SLOTS_PER_BUCKET مقایسه؛ attributes برای کارت ناشناس CARD_ATTR_NONE */
+uint8_t Cards_LookupIn(const CardTable_t *table, const CardUid_t *uid, uint16_t *attributes)
+{
+    uint32_t tag, bucket[2];
+
+    *attributes = CARD_ATTR_NONE;
+    if (!Cards_ValidLength(uid->length) || table->bucketCount == 0) {
+        return 0;
+    }
+
+    Cards_Locate(table, uid, &tag, &bucket[0], &bucket[1]);
+
+    for (int b = 0; b < 2; b++) {
+        uint32_t base = bucket[b] * CARDS_SLOTS_PER_BUCKET;
+        for (uint32_t s = 0; s < CARDS_SLOTS_PER_BUCKET; s++) {
+            if (table->tags[base + s] == tag) {
+                *attributes = table->attributes[base + s];
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+uint32_t Cards_PerfectPosition(const CardPerfectTable_t *table, uint64_t hash, uint16_t pilot)
+{
+    uint32_t mix = (uint32_t)(((uint64_t)pilot + 1U) * 0x9E3779B97F4A7C15ULL >> 32);
+    return Cards_Range((uint32_t)(hash >> 32) ^ mix, table->recordCount);
+}
+
+/* یک درهم، یک pilot، یک رکورد؛ UID کامل مقایسه می‌شود پس پاسخ مثبت قطعی است */
+uint8_t Cards_PerfectLookupIn(const CardPerfectTable_t *table, const CardUid_t *uid, uint16_t *attributes)
+{
+    *attributes = CARD_ATTR_NONE;
+    if (!Cards_ValidLength(uid->length) || table->recordCount == 0) {
+        return 0;
+    }
+
+    uint64_t h = Cards_Hash(table->key, uid);
+    uint16_t pilot = table->pilots[Cards_Range((uint32_t)h, table->bucketCount)];
+    const CardRecord_t *record = &table->records[Cards_PerfectPosition(table, h, pilot)];
+
+    if (record->length != uid->length || memcmp(record->uid, uid->bytes, uid->length) != 0) {
+        return 0;
+    }
+    *attributes = record->attributes;
+    return 1;
+}
+
+uint8_t Cards_Lookup(const CardUid_t *uid, uint16_t *attributes)
+{
+    uint8_t found;
+
+    PROFILE_BEGIN();
+#if CARDS_STORE == CARDS_STORE_PACKED
+    found = Cards_PackedLookupIn(activeTable, uid, attributes);
+#elif CARDS_STORE == CARDS_STORE_PERFECT
+    found = Cards_PerfectLookupIn(activeTable, uid, attributes);
+#else
+    found = Cards_LookupIn(activeTable, uid, attributes);
+#endif
+    PROFILE_END(PROF_CARDS_LOOKUP);
+    return found;
+}
+
+uint32_t Cards_Count(void)
+{
+    return activeTable->cardCount;
+}
+
+/* NULL = جدول firmware */
+void Cards_SetTable(const CardsStoreTable_t *table)
+{
+    activeTable = (table != NULL) ? table : &CARDS_BUILTIN;
+}
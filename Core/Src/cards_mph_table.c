@@ -0,0 +1,35 @@
+/* =================================================================
+ * پایگاه کارت (درهم‌سازی کامل) - تولید شده با Host/cards_mph_gen از cards_demo.txt؛ دستی ویرایش نشود
+ * 5 کارت، 5 رکورد، 2 سطل
+ * ================================================================= */
+
+#include "cards.h"
+
+#if CARDS_STORE == CARDS_STORE_PERFECT
+
+CARDS_SECTION INTEGRITY_ALIGNED static const uint16_t pilots[2] = {
+    1, 2
+};
+
+CARDS_SECTION INTEGRITY_ALIGNED static const CardRecord_t records[6] = {
+    {4, {0x08, 0x9C, 0x33, 0x71, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, 0, 0x0000},
+    {7, {0x04, 0x5F, 0x11, 0x92, 0x3A, 0x6E, 0x80, 0x00, 0x00, 0x00}, 0, 0x0001},
+    {7, {0x04, 0x6B, 0x3E, 0x91, 0xC2, 0x55, 0x80, 0x00, 0x00, 0x00}, 0, 0x0001},
+    {4, {0x04, 0xA2, 0x2B, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, 0, 0x0001},
+    {10, {0x04, 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0x11}, 0, 0x0001},
+    {0, {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, 0, 0x0000},
+};
+
+CARDS_SECTION const CardPerfectTable_t cardsPerfectTable = {
+    {0xEB, 0x5E, 0x67, 0xA2, 0x8D, 0xB0, 0x7E, 0x24, 0x8D, 0xD2, 0x27, 0x1F, 0xE3, 0xD4, 0x7D, 0xE2},
+    2, 5, 5, pilots, records
+};
+
+static const IntegritySpan_t spans[2] = {
+    {pilots, 4},
+    {records, 72},
+};
+
+const IntegrityImage_t cardsTableCrc = {spans, 2, 0x6BB26517};
+
+#endif /* CARDS_STORE_PERFECT */
@@ -0,0 +1,206 @@
+/* =================================================================
+ * پایگاه کارت فشرده - Elias-Fano بلوکی
+ *
+ * کلید = (طول UID << 56) | UID به صورت big-endian (فقط 4 و 7 بایتی)
+ * بلوک b: کلید اول در نمایه؛ برای بقیه d = کلید - کلید اول:
+ *   بیت‌های پایین: l بیت پایین d هر کارت پشت سر هم
+ *   بیت‌های بالا : کارت i بیت (d >> l) + i را 1 می‌کند
+ * جست‌وجو: صفر شماره (d >> l) در رشته یگانی پیدا می‌شود؛ 1 های بعد از آن
+ * همان کارت‌هایی‌اند که بخش بالایشان برابر است و فقط آن‌ها مقایسه می‌شوند.
+ * ================================================================= */
+
+#include "cards.h"
+#include <string.h>
+
+/* width <= 63 بیت از مکان pos؛ جدول 2 کلمه اضافه دارد */
+static uint64_t Cards_ReadBits(const uint32_t *bits, uint32_t pos, uint8_t width)
+{
+    const uint32_t *word = &bits[pos >> 5];
+    uint32_t shift = pos & 31U;
+    uint64_t value;
+
+    if (width == 0) {
+        return 0;
+    }
+    value = (((uint64_t)word[1] << 32) | word[0]) >> shift;
+    if (shift + width > 64U) {
+        value |= (uint64_t)word[2] << (64U - shift);
+    }
+    return value & ((1ULL << width) - 1U);
+}
+
+uint64_t Cards_PackedKey(const CardUid_t *uid)
+{
+    uint64_t key = (uint64_t)uid->length << 56;
+
+    for (uint8_t i = 0; i < uid->length; i++) {
+        key |= (uint64_t)uid->bytes[i] << (8U * (uid->length - 1U - i));
+    }
+    return key;
+}
+
+/* آخرین بلوکی که کلید اولش <= key است؛ -1 اگر key از همه کوچک‌تر باشد */
+static int32_t Cards_FindBlock(const CardPackedTable_t *table, uint64_t key)
+{
+    int32_t low = 0, high = (int32_t)table->blockCount - 1, found = -1;
+
+    while (low <= high) {
+        int32_t mid = (low + high) / 2;
+        if (table->blocks[mid].first <= key) {
+            found = mid;
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return found;
+}
+
+/* مکان صفر شماره n (از 1) در رشته‌ای که از بیت pos شروع می‌شود؛ کلمه به کلمه */
+static uint32_t Cards_SelectZero(const uint32_t *bits, uint32_t pos, uint32_t n)
+{
+    uint32_t w = pos >> 5;
+    uint32_t zeros = ~bits[w] & (0xFFFFFFFFU << (pos & 31U));
+    uint32_t count;
+
+    while ((count = (uint32_t)__builtin_popcount(zeros)) < n) {
+        n -= count;
+        zeros = ~bits[++w];
+    }
+    while (--n > 0) {
+        zeros &= zeros - 1U;                    /* حذف کم‌ارزش‌ترین صفر */
+    }
+    return (w << 5) + (uint32_t)__builtin_ctz(zeros);
+}
+
+/* رتبه کارت در بلوک (0 = کلید اول)؛ -1 اگر نباشد */
+static int32_t Cards_FindInBlock(const CardPackedTable_t *table, const CardBlock_t *block, uint64_t d)
+{
+    uint8_t l = block->lowBits;
+    uint64_t high = d >> l;
+    uint64_t low = d & ((1ULL << l) - 1U);
+    uint32_t lowStart = block->bitOffset;
+    uint32_t upper = lowStart + (uint32_t)(block->count - 1U) * l;
+    uint32_t end = upper + block->upperLength;
+
+    if (d == 0) {
+        return 0;
+    }
+    /* رشته یگانی count-1 یک و (upperLength - count + 1) صفر دارد */
+    if (high > (uint64_t)(block->upperLength - (block->count - 1U))) {
+        return -1;
+    }
+
+    /* بعد از صفر شماره high، یک‌ها کارت‌های هم‌بخش بالا هستند */
+    uint32_t pos = (high == 0) ? upper : Cards_SelectZero(table->bits, upper, (uint32_t)high) + 1U;
+    uint32_t ones = pos - upper - (uint32_t)high;
+
+    while (pos < end && Cards_ReadBits(table->bits, pos, 1)) {
+        uint64_t value = Cards_ReadBits(table->bits, lowStart + ones * l, l);
+        if (value == low) {
+            return (int32_t)ones + 1;
+        }
+        if (value > low) {
+            break;
+        }
+        ones++;
+        pos++;
+    }
+    return -1;
+}
+
+static uint8_t Cards_OverflowLookup(const CardPackedTable_t *table, const CardUid_t *uid, uint16_t *attributes)
+{
+    int32_t low = 0, high = (int32_t)table->overflowCount - 1;
+
+    while (low <= high) {
+        int32_t mid = (low + high) / 2;
+        int cmp = memcmp(table->overflow[mid].uid, uid->bytes, CARDS_UID_MAX);
+        if (cmp == 0) {
+            *attributes = table->overflow[mid].attributes;
+            return 1;
+        }
+        if (cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return 0;
+}
+
+uint8_t Cards_PackedLookupIn(const CardPackedTable_t *table, const CardUid_t *uid, uint16_t *attributes)
+{
+    *attributes = CARD_ATTR_NONE;
+
+    if (uid->length == CARDS_UID_MAX) {
+        return Cards_OverflowLookup(table, uid, attributes);
+    }
+    if (uid->length != 4 && uid->length != 7) {
+        return 0;
+    }
+
+    uint64_t key = Cards_PackedKey(uid);
+    int32_t b = Cards_FindBlock(table, key);
+    if (b < 0) {
+        return 0;
+    }
+
+    int32_t rank = Cards_FindInBlock(table, &table->blocks[b], key - table->blocks[b].first);
+    if (rank < 0) {
+        return 0;
+    }
+
+    uint32_t index = (uint32_t)b * CARDS_PACKED_BLOCK + (uint32_t)rank;
+    *attributes = table->palette[Cards_ReadBits(table->attributeIndex, index * table->attributeBits, table->attributeBits)];
+    return 1;
+}
+
+/* یک‌های بازه [start، end) */
+static uint32_t Cards_CountOnes(const uint32_t *bits, uint32_t start, uint32_t end)
+{
+    uint32_t ones = 0;
+
+    while (start < end) {
+        uint32_t width = 32U - (start & 31U);
+        if (width > end - start) {
+            width = end - start;
+        }
+        ones += (uint32_t)__builtin_popcount((uint32_t)Cards_ReadBits(bits, start, (uint8_t)width));
+        start += width;
+    }
+    return ones;
+}
+
+/* جدولی که بیرون firmware ساخته شده (تصویر پیکربندی): هر بلوک جز آخری
+ * پر، کلید اول‌ها صعودی، بیت‌های هر بلوک با 2 کلمه بعدش داخل bitsWords و
+ * رشته یگانی دقیقاً count-1 یک؛ پس Cards_PackedLookupIn بیرون آرایه‌ها
+ * نمی‌خواند. palette باید CARDS_PACKED_ATTR_MAX عنصر داشته باشد */
+uint8_t Cards_PackedIsValid(const CardPackedTable_t *table, uint32_t bitsWords, uint32_t attributeWords)
+{
+    uint32_t packed = 0;
+
+    if (table->attributeBits > 4U || table->overflowCount > table->cardCount) {
+        return 0;
+    }
+    for (uint32_t b = 0; b < table->blockCount; b++) {
+        const CardBlock_t *block = &table->blocks[b];
+
+        if (block->count == 0 || block->count > CARDS_PACKED_BLOCK
+            || (b + 1U < table->blockCount && block->count != CARDS_PACKED_BLOCK)
+            || (b > 0 && block->first <= table->blocks[b - 1U].first)
+            || block->lowBits > 63U || block->upperLength < block->count - 1U
+            || block->bitOffset > bitsWords * 32U) {
+            return 0;
+        }
+
+        uint32_t upper = block->bitOffset + (uint32_t)(block->count - 1U) * block->lowBits;
+        uint32_t end = upper + block->upperLength;
+        if (end + 64U > bitsWords * 32U || Cards_CountOnes(table->bits, upper, end) != block->count - 1U) {
+            return 0;
+        }
+        packed += block->count;
+    }
+    return packed == table->cardCount - table->overflowCount
+        && (uint64_t)packed * table->attributeBits + 64U <= (uint64_t)attributeWords * 32U;
+}
@@ -0,0 +1,46 @@
+/* =================================================================
+ * پایگاه کارت فشرده - تولید شده با Host/cards_pack_gen از cards_demo.txt؛ دستی ویرایش نشود
+ * 5 کارت، 1 بلوک، 78 بایت
+ * ================================================================= */
+
+#include "cards.h"
+
+#if CARDS_STORE == CARDS_STORE_PACKED
+
+CARDS_SECTION static const CardBlock_t blocks[1] = {
+    {0x0400000004A22B1CULL, 0, 6, 56, 4},
+};
+
+CARDS_SECTION static const uint32_t bits[8] = {
+    0x03FA0855, 0x64000000, 0x118D9843, 0x2A64045F, 0x6B3E8D20, 0x00003104,
+    0x00000000, 0x00000000
+};
+
+CARDS_SECTION INTEGRITY_ALIGNED static const uint16_t palette[2] = {0x0001, 0x0000};
+
+CARDS_SECTION static const uint32_t attributeIndex[3] = {
+    0x00000002, 0x00000000, 0x00000000
+};
+
+CARDS_SECTION INTEGRITY_ALIGNED static const CardRecord_t overflow[2] = {
+    {10, {0x04, 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0x11}, 0, 0x0001},
+    {0, {0}, 0, CARD_ATTR_NONE},
+};
+
+CARDS_SECTION const CardPackedTable_t cardsPackedTable = {
+    5, 1, blocks, bits,
+    1, palette, attributeIndex,
+    1, overflow
+};
+
+static const IntegritySpan_t spans[5] = {
+    {blocks, 16},
+    {bits, sizeof(bits)},
+    {palette, 4},
+    {attributeIndex, sizeof(attributeIndex)},
+    {overflow, 16},
+};
+
+const IntegrityImage_t cardsTableCrc = {spans, 5, 0xA5A8E346};
+
+#endif /* CARDS_STORE_PACKED */
@@ -0,0 +1,31 @@
+/* =================================================================
+ * پایگاه کارت‌ها - تولید شده با Host/cards_gen از cards_demo.txt؛ دستی ویرایش نشود
+ * 5 کارت، 2 سطل
+ * ================================================================= */
+
+#include "cards.h"
+
+#if CARDS_STORE == CARDS_STORE_CUCKOO
+
+CARDS_SECTION static const uint32_t tags[8] = {
+    0x437EB790, 0xEB5F652D, 0x00000000, 0x00000000,
+    0xC19D222F, 0x682D67CF, 0x02CCE027, 0x00000000
+};
+
+CARDS_SECTION INTEGRITY_ALIGNED static const uint16_t attributes[8] = {
+    0x0001, 0x0001, 0x0000, 0x0000, 0x0001, 0x0000, 0x0001, 0x0000
+};
+
+CARDS_SECTION const CardTable_t cardsTable = {
+    {0xAB, 0xEC, 0xBD, 0xD9, 0x34, 0xE9, 0x17, 0x73, 0x3A, 0x6E, 0x10, 0x88, 0xFF, 0xDB, 0xC8, 0xD1},
+    2, 5, tags, attributes
+};
+
+static const IntegritySpan_t spans[2] = {
+    {tags, sizeof(tags)},
+    {attributes, sizeof(attributes)},
+};
+
+const IntegrityImage_t cardsTableCrc = {spans, 2, 0x07D33548};
+
+#endif /* CARDS_STORE_CUCKOO */
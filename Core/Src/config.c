@@ -0,0 +1,462 @@
+/* =================================================================
+ * پیکربندی A/B - پیاده‌سازی
+ *
+ * به‌روزرسانی:
+ *   Config_Begin     slot دیگر انتخاب می‌شود؛ اگر ناحیه لازم پاک نیست
+ *                    تا زمان سکون منتظر پاک کردن می‌ماند
+ *   Config_Write     فقط کپی در بافر حلقوی RAM (بقیه جا برگردانده می‌شود)
+ *   Config_Task      حداکثر CONFIG_PROGRAM_WORDS کلمه در flash
+ *   Config_Commit    بعد از آخرین کلمه: CRC آنچه واقعاً در flash نشسته با
+ *                    واحد CRC سخت‌افزاری با CRC فرستنده مقایسه، جدول محتوا
+ *                    بررسی، سرآیند نوشته و magic آخر از همه برنامه می‌شود؛
+ *                    جدول‌های Users، Revoke و Cards در همان نوبت تسک به
+ *                    slot تازه اشاره می‌کنند
+ * slot قبلی تا به‌روزرسانی بعدی دست نمی‌خورد، پس قطع برق در هر لحظه یا
+ * تصویر قبلی یا تصویر کامل تازه را باقی می‌گذارد.
+ * ================================================================= */
+
+#include "config.h"
+#include "flash_map.h"
+#include "users.h"
+#include "revoke.h"
+#include "cards.h"
+#include "eventlog.h"
+#include "crc.h"
+#include "integrity.h"
+#include "timing.h"
+#include <string.h>
+
+#define CONFIG_SLOTS        2
+#define CONFIG_BLANK        0xFFFFFFFFUL
+
+typedef struct {
+    uint32_t sector;
+    uint32_t address;
+} ConfigSlot_t;
+
+static const ConfigSlot_t slots[CONFIG_SLOTS] = {
+    {FLASH_MAP_CONFIG_SECTOR0, FLASH_MAP_CONFIG_ADDR0},
+    {FLASH_MAP_CONFIG_SECTOR1, FLASH_MAP_CONFIG_ADDR1},
+};
+
+static int8_t active = -1;              /* -1 = جدول‌های firmware */
+static uint32_t activeVersion = 0;
+static UsersTable_t users;              /* توصیف‌گرهای RAM که به slot فعال اشاره می‌کنند */
+static RevokeTable_t revoke;
+static CardsStoreTable_t cards;
+static ConfigStats_t stats;
+
+/* به‌روزرسانی در جریان */
+static ConfigUpdateState_t state = CONFIG_IDLE;
+static uint8_t target = 0;
+static uint32_t total = 0;
+static uint32_t received = 0;
+static uint32_t programmed = 0;
+static uint32_t expectedCrc = 0;        /* از فرستنده، با Config_Commit */
+static uint8_t commitRequested = 0;
+
+static uint8_t stage[CONFIG_STAGE_SIZE];
+static uint32_t stageHead = 0;
+static uint32_t stageCount = 0;
+
+/* ================================================
+ * دسترسی به slot ها
+ * ================================================ */
+static const ConfigHeader_t* Config_Header(uint8_t s)
+{
+    return (const ConfigHeader_t *)FLASH_READ_PTR(slots[s].address);
+}
+
+static const uint8_t* Config_Payload(uint8_t s)
+{
+    return (const uint8_t *)FLASH_READ_PTR(slots[s].address + CONFIG_HEADER_SIZE);
+}
+
+/* سرآیند و length بایت اول محتوا پاک‌اند */
+static uint8_t Config_IsBlank(uint8_t s, uint32_t length)
+{
+    const uint32_t *words = (const uint32_t *)FLASH_READ_PTR(slots[s].address);
+
+    for (uint32_t i = 0; i < (CONFIG_HEADER_SIZE + length) / 4U; i++) {
+        if (words[i] != CONFIG_BLANK) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* ================================================
+ * جدول محتوا
+ * ================================================ */
+static uint8_t Config_InRange(uint32_t offset, uint32_t size, uint32_t align, uint32_t length)
+{
+    return (offset % align) == 0 && offset <= length && size <= length - offset;
+}
+
+/* پایگاه کارت به قالب CARDS_STORE؛ هر خواندن Cards_*LookupIn داخل محتوا */
+static uint8_t Config_ParseCards(const uint8_t *payload, uint32_t length, CardsStoreTable_t *c)
+{
+    const ConfigLayout_t *layout = (const ConfigLayout_t *)payload;
+
+    memset(c, 0, sizeof(*c));
+    if (layout->cardsFormat == CONFIG_CARDS_FIRMWARE) {
+        return 1;
+    }
+    if (layout->cardsFormat != CONFIG_CARDS_FORMAT) {
+        return 0;
+    }
+
+#if CARDS_STORE == CARDS_STORE_PACKED
+    if (layout->cardsBlockCount > length || layout->cardsBitsWords > length
+        || layout->cardsAttributeWords > length || layout->cardsOverflowCount > length
+        || !Config_InRange(layout->cardsBlocks, layout->cardsBlockCount * sizeof(CardBlock_t), 8, length)
+        || !Config_InRange(layout->cardsBits, layout->cardsBitsWords * sizeof(uint32_t), sizeof(uint32_t), length)
+        || !Config_InRange(layout->cardsPalette, CARDS_PACKED_ATTR_MAX * sizeof(uint16_t), sizeof(uint16_t), length)
+        || !Config_InRange(layout->cardsAttributeIndex, layout->cardsAttributeWords * sizeof(uint32_t), sizeof(uint32_t), length)
+        || !Config_InRange(layout->cardsOverflow, layout->cardsOverflowCount * sizeof(CardRecord_t), sizeof(uint16_t), length)) {
+        return 0;
+    }
+    c->cardCount = layout->cardsCount;
+    c->blockCount = layout->cardsBlockCount;
+    c->blocks = (const CardBlock_t *)(payload + layout->cardsBlocks);
+    c->bits = (const uint32_t *)(payload + layout->cardsBits);
+    c->attributeBits = (uint8_t)layout->cardsAttributeBits;
+    c->palette = (const uint16_t *)(payload + layout->cardsPalette);
+    c->attributeIndex = (const uint32_t *)(payload + layout->cardsAttributeIndex);
+    c->overflowCount = layout->cardsOverflowCount;
+    c->overflow = (const CardRecord_t *)(payload + layout->cardsOverflow);
+    return layout->cardsAttributeBits <= 4U
+        && Cards_PackedIsValid(c, layout->cardsBitsWords, layout->cardsAttributeWords);
+#elif CARDS_STORE == CARDS_STORE_PERFECT
+    if (layout->cardsBucketCount > length || layout->cardsRecordCount > length
+        || (layout->cardsRecordCount != 0 && layout->cardsBucketCount == 0)
+        || !Config_InRange(layout->cardsPilots, layout->cardsBucketCount * sizeof(uint16_t), sizeof(uint16_t), length)
+        || !Config_InRange(layout->cardsRecords, layout->cardsRecordCount * sizeof(CardRecord_t), sizeof(uint16_t), length)) {
+        return 0;
+    }
+    memcpy(c->key, layout->cardsKey, sizeof(c->key));
+    c->bucketCount = layout->cardsBucketCount;
+    c->recordCount = layout->cardsRecordCount;
+    c->cardCount = layout->cardsCount;
+    c->pilots = (const uint16_t *)(payload + layout->cardsPilots);
+    c->records = (const CardRecord_t *)(payload + layout->cardsRecords);
+    return 1;
+#else
+    uint32_t slots = layout->cardsBucketCount * CARDS_SLOTS_PER_BUCKET;
+    if (layout->cardsBucketCount > length
+        || !Config_InRange(layout->cardsTags, slots * sizeof(uint32_t), sizeof(uint32_t), length)
+        || !Config_InRange(layout->cardsAttributes, slots * sizeof(uint16_t), sizeof(uint16_t), length)) {
+        return 0;
+    }
+    memcpy(c->key, layout->cardsKey, sizeof(c->key));
+    c->bucketCount = layout->cardsBucketCount;
+    c->cardCount = layout->cardsCount;
+    c->tags = (const uint32_t *)(payload + layout->cardsTags);
+    c->attributes = (const uint16_t *)(payload + layout->cardsAttributes);
+    return 1;
+#endif
+}
+
+/* فاصله‌ها و اندازه‌ها داخل محتوا؛ نمایه کاربران صعودی و تا usersCount */
+static uint8_t Config_Parse(const uint8_t *payload, uint32_t length, UsersTable_t *u, RevokeTable_t *r,
+                            CardsStoreTable_t *c)
+{
+    const ConfigLayout_t *layout = (const ConfigLayout_t *)payload;
+
+    if (length < sizeof(ConfigLayout_t) || layout->usersCount > 0xFFFFU
+        || layout->revokeCount > length || layout->revokeFilterBits > length * 8U
+        || (layout->revokeFilterBits != 0 && layout->revokeHashCount == 0)
+        || layout->revokeHashCount > 0xFFU) {
+        return 0;
+    }
+
+    uint32_t filterWords = (layout->revokeFilterBits + 31U) / 32U;
+    if (!Config_InRange(layout->usersPepper, USERS_PEPPER_SIZE, 1, length)
+        || !Config_InRange(layout->usersIndex, (USERS_BUCKETS + 1) * sizeof(uint16_t), sizeof(uint16_t), length)
+        || !Config_InRange(layout->usersRecords, layout->usersCount * sizeof(UserRecord_t), 8, length)
+        || !Config_InRange(layout->revokeFilter, filterWords * sizeof(uint32_t), sizeof(uint32_t), length)
+        || !Config_InRange(layout->revokeUids, layout->revokeCount * sizeof(CardUid_t), 1, length)) {
+        return 0;
+    }
+
+    const uint16_t *index = (const uint16_t *)(payload + layout->usersIndex);
+    if (index[0] != 0 || index[USERS_BUCKETS] != layout->usersCount) {
+        return 0;
+    }
+    for (uint32_t b = 0; b < USERS_BUCKETS; b++) {
+        if (index[b + 1] < index[b] || index[b + 1] - index[b] > USERS_BUCKET_MAX) {
+            return 0;
+        }
+    }
+
+    u->pepper = payload + layout->usersPepper;
+    u->index = index;
+    u->records = (const UserRecord_t *)(payload + layout->usersRecords);
+    u->count = (uint16_t)layout->usersCount;
+
+    memcpy(r->key, layout->revokeKey, sizeof(r->key));
+    r->filterBits = layout->revokeFilterBits;
+    r->hashCount = (uint8_t)layout->revokeHashCount;
+    r->filter = (const uint32_t *)(payload + layout->revokeFilter);
+    r->count = layout->revokeCount;
+    r->uids = (const CardUid_t *)(payload + layout->revokeUids);
+    return Config_ParseCards(payload, length, c);
+}
+
+/* magic، طول، CRC کل محتوا و جدول محتوا */
+static uint8_t Config_SlotIsValid(uint8_t s)
+{
+    const ConfigHeader_t *header = Config_Header(s);
+    UsersTable_t u;
+    RevokeTable_t r;
+    CardsStoreTable_t c;
+
+    if (header->magic != CONFIG_MAGIC || header->version == 0 || header->version == CONFIG_BLANK
+        || header->length % 4U != 0 || header->length > CONFIG_MAX_LENGTH) {
+        return 0;
+    }
+    if (Crc_Compute(slots[s].address + CONFIG_HEADER_SIZE, header->length / 4U) != header->crc) {
+        return 0;
+    }
+    return Config_Parse(Config_Payload(s), header->length, &u, &r, &c);
+}
+
+/* بین دو نوبت تسک؛ بررسی بعدی رمز یا کارت از slot تازه است */
+static void Config_Activate(uint8_t s)
+{
+    const ConfigLayout_t *layout = (const ConfigLayout_t *)Config_Payload(s);
+
+    Config_Parse(Config_Payload(s), Config_Header(s)->length, &users, &revoke, &cards);
+    Users_SetTable(&users);
+    Revoke_SetTable(&revoke);
+    Cards_SetTable(layout->cardsFormat == CONFIG_CARDS_FIRMWARE ? NULL : &cards);
+    active = (int8_t)s;
+    activeVersion = Config_Header(s)->version;
+    Integrity_Watch(INTEGRITY_CONFIG, slots[s].address + CONFIG_HEADER_SIZE,
+                    Config_Header(s)->length, Config_Header(s)->crc, 1);
+}
+
+/* ================================================
+ * راه‌اندازی
+ * ================================================ */
+void Config_Init(void)
+{
+    int8_t chosen = -1;
+    uint32_t start = Timing_GetCycles();
+
+    memset(&stats, 0, sizeof(stats));
+    state = CONFIG_IDLE;
+    stageHead = 0;
+    stageCount = 0;
+    commitRequested = 0;
+    active = -1;
+    activeVersion = 0;
+    Users_SetTable(NULL);
+    Revoke_SetTable(NULL);
+    Cards_SetTable(NULL);
+    Integrity_Forget(INTEGRITY_CONFIG);
+
+    for (uint8_t s = 0; s < CONFIG_SLOTS; s++) {
+        if (Config_SlotIsValid(s) && (chosen < 0
+            || Config_Header(s)->version > Config_Header((uint8_t)chosen)->version)) {
+            chosen = (int8_t)s;
+        }
+    }
+    stats.bootCheckCycles = Timing_ElapsedCycles(start);
+
+    if (chosen >= 0) {
+        Config_Activate((uint8_t)chosen);
+    }
+}
+
+/* ================================================
+ * به‌روزرسانی
+ * ================================================ */
+/* length بایت محتوا (با ConfigLayout_t در ابتدا)، مضرب 4 */
+uint8_t Config_Begin(uint32_t length)
+{
+    if (state == CONFIG_ERASING || state == CONFIG_RECEIVING
+        || length < sizeof(ConfigLayout_t) || length % 4U != 0 || length > CONFIG_MAX_LENGTH) {
+        return 0;
+    }
+
+    target = (active < 0) ? 0 : (uint8_t)(active ^ 1);
+    total = length;
+    received = 0;
+    programmed = 0;
+    commitRequested = 0;
+    stageHead = 0;
+    stageCount = 0;
+    state = Config_IsBlank(target, length) ? CONFIG_RECEIVING : CONFIG_ERASING;
+    return 1;
+}
+
+/* تعداد بایت پذیرفته‌شده؛ بقیه بعد از خالی شدن بافر دوباره فرستاده شود */
+uint32_t Config_Write(const void *data, uint32_t length)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+
+    if (state != CONFIG_ERASING && state != CONFIG_RECEIVING) {
+        return 0;
+    }
+    if (length > CONFIG_STAGE_SIZE - stageCount) {
+        length = CONFIG_STAGE_SIZE - stageCount;
+    }
+    if (length > total - received) {
+        length = total - received;
+    }
+
+    for (uint32_t i = 0; i < length; i++) {
+        stage[(stageHead + stageCount) % CONFIG_STAGE_SIZE] = bytes[i];
+        stageCount++;
+    }
+    received += length;
+    return length;
+}
+
+/* جابه‌جایی بعد از برنامه شدن آخرین کلمه، اگر CRC محتوای flash برابر crc
+ * فرستنده باشد؛ 0 اگر همه بایت‌ها نرسیده‌اند */
+uint8_t Config_Commit(uint32_t crc)
+{
+    if ((state != CONFIG_ERASING && state != CONFIG_RECEIVING) || received != total) {
+        return 0;
+    }
+    expectedCrc = crc;
+    commitRequested = 1;
+    return 1;
+}
+
+static uint32_t Config_PopWord(void)
+{
+    uint8_t bytes[4];
+    uint32_t word;
+
+    for (uint8_t i = 0; i < 4; i++) {
+        bytes[i] = stage[stageHead];
+        stageHead = (stageHead + 1U) % CONFIG_STAGE_SIZE;
+    }
+    stageCount -= 4U;
+    memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+
+static uint8_t Config_ProgramWord(uint32_t address, uint32_t value)
+{
+    return HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address, value) == HAL_OK;
+}
+
+/* بررسی بعد از نوشتن و سرآیند؛ magic آخر (flash باید unlock باشد) */
+static void Config_Finish(void)
+{
+    UsersTable_t u;
+    RevokeTable_t r;
+    CardsStoreTable_t c;
+    uint32_t address = slots[target].address;
+    uint32_t version = activeVersion + 1U;
+    uint32_t start = Timing_GetCycles();
+    uint32_t crc = Crc_Compute(address + CONFIG_HEADER_SIZE, total / 4U);
+
+    stats.verifyCycles = Timing_ElapsedCycles(start);
+    if (crc != expectedCrc || !Config_Parse(Config_Payload(target), total, &u, &r, &c)) {
+        stats.rejected++;
+        state = CONFIG_FAILED;
+        return;
+    }
+    if (!Config_ProgramWord(address, version)
+        || !Config_ProgramWord(address + 4U, total)
+        || !Config_ProgramWord(address + 8U, crc)
+        || !Config_ProgramWord(address + 12U, CONFIG_MAGIC)) {
+        stats.failed++;
+        state = CONFIG_FAILED;
+        return;
+    }
+
+    Config_Activate(target);
+    stats.commits++;
+    state = CONFIG_IDLE;
+    EventLog_Append(EVENTLOG_CONFIG, 0, version);
+}
+
+void Config_Task(void)
+{
+    if (state != CONFIG_RECEIVING) {
+        return;
+    }
+
+    uint32_t start = Timing_GetCycles();
+    uint32_t words = stageCount / 4U;
+    if (words > CONFIG_PROGRAM_WORDS) {
+        words = CONFIG_PROGRAM_WORDS;
+    }
+
+    HAL_FLASH_Unlock();
+    for (uint32_t i = 0; i < words; i++) {
+        uint32_t address = slots[target].address + CONFIG_HEADER_SIZE + programmed;
+        if (!Config_ProgramWord(address, Config_PopWord())) {
+            stats.failed++;
+            state = CONFIG_FAILED;
+            break;
+        }
+        programmed += 4U;
+    }
+    uint32_t cycles = Timing_ElapsedCycles(start);
+    if (state == CONFIG_RECEIVING && commitRequested && programmed == total) {
+        Config_Finish();
+    }
+    HAL_FLASH_Lock();
+
+    if (cycles > stats.maxProgramCycles) {
+        stats.maxProgramCycles = cycles;
+    }
+}
+
+uint8_t Config_NeedsErase(void)
+{
+    return state == CONFIG_ERASING;
+}
+
+/* حدود 1s توقف (sector 128K)؛ فقط در زمان سکون صدا زده شود */
+void Config_EraseInactive(void)
+{
+    uint32_t elapsedMs;
+
+    HAL_FLASH_Unlock();
+    HAL_StatusTypeDef status = FlashMap_EraseSector(slots[target].sector, &elapsedMs);
+    HAL_FLASH_Lock();
+
+    stats.erases++;
+    if (elapsedMs > stats.maxEraseMs) {
+        stats.maxEraseMs = elapsedMs;
+    }
+    if (status == HAL_OK) {
+        state = CONFIG_RECEIVING;
+    } else {
+        stats.failed++;
+        state = CONFIG_FAILED;
+    }
+}
+
+/* کلمه‌ای در بافر یا پاک کردنی منتظر نیست؛ انتظار برای داده بعدی بیکاری است */
+uint8_t Config_IsIdle(void)
+{
+    if (state == CONFIG_ERASING) {
+        return 0;
+    }
+    return state != CONFIG_RECEIVING || (stageCount < 4U && !commitRequested);
+}
+
+ConfigUpdateState_t Config_GetUpdateState(void)
+{
+    return state;
+}
+
+/* 0 = جدول‌های firmware */
+uint32_t Config_GetVersion(void)
+{
+    return activeVersion;
+}
+
+void Config_GetStats(ConfigStats_t *out)
+{
+    *out = stats;
+}
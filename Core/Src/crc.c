@@ -0,0 +1,122 @@
+/* =================================================================
+ * واحد CRC + DMA2 Stream0 - پیاده‌سازی در سطح رجیستر
+ *
+ * حالت حافظه به حافظه: درگاه «پریفرال» مبدأ است (PAR = آدرس flash، با
+ * افزایش) و درگاه حافظه مقصد (M0AR = CRC->DR، ثابت). این حالت بدون
+ * FIFO مجاز نیست؛ آستانه FIFO کامل است.
+ * ================================================================= */
+
+#include "crc.h"
+#include "timing.h"
+
+#define CRC_DMA_STREAM      DMA2_Stream0
+#define CRC_DMA_CLEAR       (DMA_LIFCR_CFEIF0 | DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CTEIF0 \
+                             | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTCIF0)
+
+static volatile uint8_t busy = 0;
+static volatile uint8_t failed = 0;
+static volatile uint32_t lastCycles = 0;
+static uint32_t startCycles = 0;
+static uint32_t transfers = 0;
+
+void Crc_Init(void)
+{
+    __HAL_RCC_CRC_CLK_ENABLE();
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    CRC_DMA_STREAM->CR = 0;
+    while (CRC_DMA_STREAM->CR & DMA_SxCR_EN) {
+    }
+    DMA2->LIFCR = CRC_DMA_CLEAR;
+    CRC->CR = CRC_CR_RESET;
+    busy = 0;
+
+    HAL_NVIC_SetPriority(DMA2_Stream0_IRQn, 7, 0);
+    HAL_NVIC_EnableIRQ(DMA2_Stream0_IRQn);
+}
+
+/* words کلمه از address؛ restart مقدار CRC را به 0xFFFFFFFF برمی‌گرداند */
+uint8_t Crc_Start(uintptr_t address, uint32_t words, uint8_t restart)
+{
+    if (busy || words == 0 || words > CRC_MAX_WORDS) {
+        return 0;
+    }
+    if (restart) {
+        CRC->CR = CRC_CR_RESET;
+    }
+
+    DMA2->LIFCR = CRC_DMA_CLEAR;
+    CRC_DMA_STREAM->PAR = address;
+    CRC_DMA_STREAM->M0AR = (uint32_t)&CRC->DR;
+    CRC_DMA_STREAM->NDTR = words;
+    CRC_DMA_STREAM->FCR = DMA_SxFCR_DMDIS | DMA_SxFCR_FTH;
+
+    busy = 1;
+    failed = 0;
+    transfers++;
+    startCycles = Timing_GetCycles();
+    CRC_DMA_STREAM->CR = DMA_SxCR_DIR_1                         /* حافظه به حافظه */
+                       | DMA_SxCR_PINC
+                       | DMA_SxCR_PSIZE_1 | DMA_SxCR_MSIZE_1    /* کلمه */
+                       | DMA_SxCR_TCIE | DMA_SxCR_TEIE
+                       | DMA_SxCR_EN;
+    return 1;
+}
+
+/* وقفه DMA2 Stream0 */
+void Crc_IRQHandler(void)
+{
+    uint32_t flags = DMA2->LISR;
+
+    DMA2->LIFCR = CRC_DMA_CLEAR;
+    if (flags & (DMA_LISR_TCIF0 | DMA_LISR_TEIF0)) {
+        lastCycles = Timing_ElapsedCycles(startCycles);
+        failed = (flags & DMA_LISR_TEIF0) != 0;
+        busy = 0;
+    }
+}
+
+uint8_t Crc_IsBusy(void)
+{
+    return busy;
+}
+
+uint8_t Crc_LastFailed(void)
+{
+    return failed;
+}
+
+uint32_t Crc_Value(void)
+{
+    return CRC->DR;
+}
+
+uint32_t Crc_Transfers(void)
+{
+    return transfers;
+}
+
+/* سیکل‌های آخرین انتقال، از شروع تا وقفه پایان */
+uint32_t Crc_LastCycles(void)
+{
+    return lastCycles;
+}
+
+/* مسدودکننده (راه‌اندازی و بعد از نوشتن)؛ انتقال در جریان اول تمام می‌شود */
+uint32_t Crc_Compute(uint32_t address, uint32_t words)
+{
+    uint8_t restart = 1;
+
+    while (words > 0) {
+        uint32_t chunk = (words > CRC_MAX_WORDS) ? CRC_MAX_WORDS : words;
+        while (busy) {
+        }
+        Crc_Start(address, chunk, restart);
+        while (busy) {
+        }
+        address += chunk * 4U;
+        words -= chunk;
+        restart = 0;
+    }
+    return restart ? CRC_INITIAL : CRC->DR;
+}
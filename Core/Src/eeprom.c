@@ -0,0 +1,342 @@
+/* =================================================================
+ * شبیه‌سازی EEPROM - پیاده‌سازی
+ *
+ * رکورد 8 بایتی: کلمه 0 مقدار، کلمه 1 = کلید | (check << 16)؛ کلمه کلید
+ * آخر برنامه می‌شود پس رکورد نیمه‌نوشته check نادرست دارد و نادیده
+ * گرفته می‌شود. خانه‌ای که هر دو کلمه‌اش 0xFFFFFFFF است انتهای صفحه است.
+ *
+ * فشرده‌سازی (حداکثر 2 + 2 x EEPROM_MAX_KEYS کلمه، کمتر از 1ms):
+ *   صفحه پاک: generation -> دریافت -> مقدارهای فهرست RAM -> فعال
+ *   صفحه قبلی: منسوخ (بعداً در زمان سکون پاک می‌شود)
+ * اگر بعد از «فعال» و پیش از «منسوخ» برق برود، دو صفحه فعال داریم و
+ * generation بزرگ‌تر برنده است.
+ * ================================================================= */
+
+#include "eeprom.h"
+#include "flash_map.h"
+#include "timing.h"
+#include <string.h>
+
+#define EEPROM_PAGES        2
+#define EEPROM_BLANK        0xFFFFFFFFUL
+#define EEPROM_SLOTS        (FLASH_MAP_EEPROM_SIZE / EEPROM_RECORD_SIZE)
+
+typedef struct {
+    uint32_t sector;
+    uint32_t address;
+} EepromPage_t;
+
+typedef struct {
+    uint16_t key;
+    uint8_t dirty;                      /* فقط در RAM؛ با فشرده‌سازی بعدی ذخیره می‌شود */
+    uint32_t value;
+} EepromEntry_t;
+
+static const EepromPage_t pages[EEPROM_PAGES] = {
+    {FLASH_MAP_EEPROM_SECTOR0, FLASH_MAP_EEPROM_ADDR0},
+    {FLASH_MAP_EEPROM_SECTOR1, FLASH_MAP_EEPROM_ADDR1},
+};
+
+static EepromEntry_t entries[EEPROM_MAX_KEYS];
+static uint8_t entryCount = 0;
+static uint8_t ready = 0;
+static uint8_t active = 0;
+static uint32_t nextSlot = 0;
+static uint8_t spareDirty = 0;          /* صفحه دیگر قبل از فشرده‌سازی بعدی باید پاک شود */
+static EepromStats_t stats;
+
+/* ================================================
+ * دسترسی به صفحه‌ها
+ * ================================================ */
+static const EepromHeader_t* Eeprom_Header(uint8_t p)
+{
+    return (const EepromHeader_t *)FLASH_READ_PTR(pages[p].address);
+}
+
+static const uint32_t* Eeprom_Slot(uint8_t p, uint32_t slot)
+{
+    return (const uint32_t *)FLASH_READ_PTR(pages[p].address + slot * EEPROM_RECORD_SIZE);
+}
+
+static uint16_t Eeprom_Check(uint16_t key, uint32_t value)
+{
+    uint32_t x = value ^ ((uint32_t)key * 0x9E3779B1UL) ^ 0xA5A5A5A5UL;
+    return (uint16_t)(x ^ (x >> 16));
+}
+
+static uint8_t Eeprom_ValidKey(uint16_t key)
+{
+    return key != 0 && key != 0xFFFF;
+}
+
+/* صفحه از slot به بعد کاملاً پاک است */
+static uint8_t Eeprom_IsBlankFrom(uint8_t p, uint32_t slot)
+{
+    const uint32_t *words = Eeprom_Slot(p, slot);
+
+    for (uint32_t i = 0; i < (EEPROM_SLOTS - slot) * 2U; i++) {
+        if (words[i] != EEPROM_BLANK) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static EepromEntry_t* Eeprom_Find(uint16_t key)
+{
+    for (uint8_t i = 0; i < entryCount; i++) {
+        if (entries[i].key == key) {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+static EepromEntry_t* Eeprom_FindOrAdd(uint16_t key)
+{
+    EepromEntry_t *entry = Eeprom_Find(key);
+
+    if (entry == NULL && entryCount < EEPROM_MAX_KEYS) {
+        entry = &entries[entryCount++];
+        entry->key = key;
+        entry->dirty = 0;
+        entry->value = EEPROM_BLANK;
+    }
+    return entry;
+}
+
+/* ================================================
+ * نوشتن (flash باید unlock باشد)
+ * ================================================ */
+static uint8_t Eeprom_ProgramWord(uint32_t address, uint32_t value)
+{
+    return HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address, value) == HAL_OK;
+}
+
+static uint8_t Eeprom_ProgramRecord(uint8_t p, uint32_t slot, uint16_t key, uint32_t value)
+{
+    uint32_t address = pages[p].address + slot * EEPROM_RECORD_SIZE;
+
+    return Eeprom_ProgramWord(address, value)
+        && Eeprom_ProgramWord(address + 4U, key | ((uint32_t)Eeprom_Check(key, value) << 16));
+}
+
+/* پاک کردن و ثبت تعداد پاک شدن؛ وضعیت صفحه پاک (0xFFFFFFFF) می‌ماند */
+static uint8_t Eeprom_ErasePage(uint8_t p)
+{
+    uint32_t eraseCount = Eeprom_Header(p)->eraseCount;
+    uint32_t elapsedMs;
+    HAL_StatusTypeDef status = FlashMap_EraseSector(pages[p].sector, &elapsedMs);
+
+    eraseCount = (eraseCount == EEPROM_BLANK) ? 1U : eraseCount + 1U;
+    stats.erases++;
+    if (elapsedMs > stats.maxEraseMs) {
+        stats.maxEraseMs = elapsedMs;
+    }
+    return status == HAL_OK && Eeprom_ProgramWord(pages[p].address + 4U, eraseCount);
+}
+
+/* رکورد فهرست در انتهای صفحه فعال؛ خانه حتی با خطا مصرف شده حساب می‌شود */
+static void Eeprom_Persist(EepromEntry_t *entry)
+{
+    uint8_t ok = 0;
+
+    if (nextSlot < EEPROM_SLOTS) {
+        HAL_FLASH_Unlock();
+        ok = Eeprom_ProgramRecord(active, nextSlot++, entry->key, entry->value);
+        HAL_FLASH_Lock();
+    }
+    if (ok) {
+        entry->dirty = 0;
+        stats.writes++;
+    } else {
+        stats.failed++;
+    }
+}
+
+/* مقدارهای فعلی همه کلیدها به صفحه دیگر */
+static void Eeprom_Compact(void)
+{
+    uint8_t spare = active ^ 1U;
+    uint32_t address = pages[spare].address;
+    uint32_t slot = EEPROM_HEADER_SLOTS;
+
+    HAL_FLASH_Unlock();
+    uint8_t ok = Eeprom_ProgramWord(address + 8U, Eeprom_Header(active)->generation + 1U)
+              && Eeprom_ProgramWord(address, EEPROM_PAGE_RECEIVE);
+    for (uint8_t i = 0; ok && i < entryCount; i++) {
+        ok = Eeprom_ProgramRecord(spare, slot++, entries[i].key, entries[i].value);
+    }
+    ok = ok && Eeprom_ProgramWord(address, EEPROM_PAGE_ACTIVE);
+    if (ok) {
+        Eeprom_ProgramWord(pages[active].address, EEPROM_PAGE_OBSOLETE);
+        active = spare;
+        nextSlot = slot;
+        for (uint8_t i = 0; i < entryCount; i++) {
+            entries[i].dirty = 0;
+        }
+        stats.compactions++;
+    }
+    HAL_FLASH_Lock();
+
+    /* صفحه منسوخ، یا صفحه‌ای که فشرده‌سازی در آن شکست خورد */
+    spareDirty = 1;
+}
+
+static uint8_t Eeprom_NeedsCompaction(void)
+{
+    return EEPROM_SLOTS - nextSlot < EEPROM_COMPACT_FREE;
+}
+
+/* ================================================
+ * راه‌اندازی: انتخاب صفحه فعال و ساخت فهرست
+ * ================================================ */
+static void Eeprom_Load(void)
+{
+    uint32_t slot;
+
+    entryCount = 0;
+    for (slot = EEPROM_HEADER_SLOTS; slot < EEPROM_SLOTS; slot++) {
+        const uint32_t *words = Eeprom_Slot(active, slot);
+        if ((words[0] & words[1]) == EEPROM_BLANK) {
+            break;
+        }
+
+        uint16_t key = (uint16_t)words[1];
+        if (Eeprom_ValidKey(key) && (uint16_t)(words[1] >> 16) == Eeprom_Check(key, words[0])) {
+            EepromEntry_t *entry = Eeprom_FindOrAdd(key);
+            if (entry != NULL) {
+                entry->value = words[0];
+            }
+        }
+    }
+    nextSlot = slot;
+}
+
+void Eeprom_Init(void)
+{
+    int8_t chosen = -1;
+
+    memset(&stats, 0, sizeof(stats));
+    entryCount = 0;
+    spareDirty = 0;
+    ready = 0;
+
+    for (uint8_t p = 0; p < EEPROM_PAGES; p++) {
+        if (Eeprom_Header(p)->state == EEPROM_PAGE_ACTIVE && (chosen < 0
+            || Eeprom_Header(p)->generation > Eeprom_Header((uint8_t)chosen)->generation)) {
+            chosen = (int8_t)p;
+        }
+    }
+
+    if (chosen < 0) {
+        /* flash تازه: تنها پاک کردن خارج از Eeprom_EraseSpare، قبل از شروع تسک‌ها */
+        HAL_FLASH_Unlock();
+        uint8_t blank = Eeprom_Header(0)->state == EEPROM_PAGE_ERASED && Eeprom_IsBlankFrom(0, 1);
+        uint8_t ok = (blank || Eeprom_ErasePage(0))
+                  && Eeprom_ProgramWord(pages[0].address + 8U, 1U)
+                  && Eeprom_ProgramWord(pages[0].address, EEPROM_PAGE_ACTIVE);
+        HAL_FLASH_Lock();
+        if (!ok) {
+            return;                     /* Eeprom_Read مقدار پیش‌فرض برمی‌گرداند */
+        }
+        chosen = 0;
+    }
+
+    active = (uint8_t)chosen;
+    Eeprom_Load();
+
+    uint8_t spare = active ^ 1U;
+    spareDirty = !(Eeprom_Header(spare)->state == EEPROM_PAGE_ERASED && Eeprom_IsBlankFrom(spare, EEPROM_HEADER_SLOTS));
+    ready = 1;
+}
+
+/* ================================================
+ * رابط
+ * ================================================ */
+uint32_t Eeprom_Read(uint16_t key, uint32_t fallback)
+{
+    const EepromEntry_t *entry = Eeprom_Find(key);
+
+    return (entry != NULL) ? entry->value : fallback;
+}
+
+/* فقط فهرست RAM؛ نوبت بعدی Eeprom_Task رکورد را برنامه می‌کند.
+ * 0 فقط اگر کلید نامعتبر یا فهرست پر باشد */
+uint8_t Eeprom_Write(uint16_t key, uint32_t value)
+{
+    if (!ready || !Eeprom_ValidKey(key)) {
+        return 0;
+    }
+
+    EepromEntry_t *entry = Eeprom_Find(key);
+    if (entry != NULL && entry->value == value) {
+        stats.unchanged++;
+        return 1;
+    }
+    if (entry == NULL && (entry = Eeprom_FindOrAdd(key)) == NULL) {
+        return 0;
+    }
+
+    entry->value = value;
+    entry->dirty = 1;
+    return 1;
+}
+
+/* ذخیره مقدارهای تغییرکرده؛ فشرده‌سازی وقتی صفحه فعال نزدیک پر شدن است و
+ * صفحه دیگر پاک است (مقدارهای تغییرکرده هم با همان کپی ذخیره می‌شوند) */
+void Eeprom_Task(void)
+{
+    if (!ready) {
+        return;
+    }
+    if (Eeprom_NeedsCompaction() && !spareDirty) {
+        Eeprom_Compact();
+        return;
+    }
+
+    uint32_t start = Timing_GetCycles();
+    uint8_t persisted = 0;
+    for (uint8_t i = 0; i < entryCount && nextSlot < EEPROM_SLOTS; i++) {
+        if (entries[i].dirty) {
+            Eeprom_Persist(&entries[i]);
+            persisted = 1;
+        }
+    }
+
+    uint32_t cycles = Timing_ElapsedCycles(start);
+    if (persisted && cycles > stats.maxPersistCycles) {
+        stats.maxPersistCycles = cycles;
+    }
+}
+
+uint8_t Eeprom_NeedsErase(void)
+{
+    return ready && spareDirty;
+}
+
+/* چند صد ms توقف؛ فقط در زمان سکون صدا زده شود */
+void Eeprom_EraseSpare(void)
+{
+    HAL_FLASH_Unlock();
+    if (Eeprom_ErasePage(active ^ 1U)) {
+        spareDirty = 0;
+    }
+    HAL_FLASH_Lock();
+}
+
+/* کار معوقی (مقدار ذخیره‌نشده، فشرده‌سازی یا پاک کردن) نمانده */
+uint8_t Eeprom_IsIdle(void)
+{
+    for (uint8_t i = 0; i < entryCount; i++) {
+        if (entries[i].dirty) {
+            return 0;
+        }
+    }
+    return !ready || (!spareDirty && !Eeprom_NeedsCompaction());
+}
+
+void Eeprom_GetStats(EepromStats_t *out)
+{
+    *out = stats;
+}
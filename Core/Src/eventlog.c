@@ -0,0 +1,453 @@
+/* =================================================================
+ * گزارش رویدادها در flash - پیاده‌سازی
+ *
+ * رکورد: کلمه‌های 0، 1 و 3 و در آخر کلمه 2 (type/detail/check) برنامه
+ * می‌شوند. خانه‌ای که همه بیت‌هایش 1 است خالی است؛ خانه نیمه‌نوشته
+ * (قطع برق) خالی نیست ولی check آن نمی‌خواند و موقع خواندن رد می‌شود.
+ *
+ * sector فعال = sector باز با بزرگ‌ترین شماره اولین رکورد.
+ *
+ * دو بافر RAM: رکورد در بافر «در حال پر شدن» می‌نشیند؛ بافر پر اگر
+ * بافر دیگر خالی باشد «منتظر نوشتن» می‌شود و جا عوض می‌کنند. شماره ترتیب
+ * و check موقع نوشتن پر می‌شوند، چون شماره از جای رکورد در flash می‌آید.
+ * برنامه کردن flash اجرای کد از flash را هم متوقف می‌کند (یک bank)، پس
+ * نوشتن پس‌زمینه با وقفه سودی ندارد؛ نوشتن یک‌جا در EventLog_Task انجام
+ * می‌شود و یک unlock/lock برای کل بافر کافی است.
+ * ================================================================= */
+
+#include "eventlog.h"
+#include "flash_map.h"
+#include "crc.h"
+#include "integrity.h"
+#include "timing.h"
+#include <string.h>
+
+#define EVENTLOG_BLANK      0xFFFFFFFFUL
+
+typedef struct {
+    uint32_t sector;
+    uint32_t address;
+    uint32_t size;
+} EventLogSector_t;
+
+static const EventLogSector_t sectors[EVENTLOG_SECTOR_COUNT] = {
+    {FLASH_MAP_LOG_SECTOR0, FLASH_MAP_LOG_ADDR0, FLASH_MAP_LOG_SIZE0},
+    {FLASH_MAP_LOG_SECTOR1, FLASH_MAP_LOG_ADDR1, FLASH_MAP_LOG_SIZE1},
+};
+
+static uint8_t ready = 0;
+static uint8_t active = 0;
+static uint32_t firstSequence = 0;
+static uint32_t nextSlot = 0;           /* خانه 0 سرآیند است */
+static EventLogStats_t stats;
+
+typedef struct {
+    EventLogRecord_t records[EVENTLOG_STAGE_RECORDS];
+    uint8_t count;
+    uint32_t firstTick;                 /* زمان ورود قدیمی‌ترین رکورد */
+} EventLogStage_t;
+
+static EventLogStage_t stages[2];
+static uint8_t filling = 0;
+static uint8_t pending = 0;             /* stages[filling ^ 1] پر و منتظر نوشتن است */
+static uint8_t urgent = 0;              /* رویداد بحرانی در بافر */
+
+/* ================================================
+ * دسترسی به sector ها
+ * ================================================ */
+static const EventLogHeader_t* EventLog_Header(uint8_t s)
+{
+    return (const EventLogHeader_t *)FLASH_READ_PTR(sectors[s].address);
+}
+
+static const EventLogRecord_t* EventLog_Slot(uint8_t s, uint32_t slot)
+{
+    return (const EventLogRecord_t *)FLASH_READ_PTR(sectors[s].address + slot * EVENTLOG_RECORD_SIZE);
+}
+
+static uint32_t EventLog_Slots(uint8_t s)
+{
+    return sectors[s].size / EVENTLOG_RECORD_SIZE;
+}
+
+static uint8_t EventLog_IsOpen(uint8_t s)
+{
+    const EventLogHeader_t *header = EventLog_Header(s);
+    return header->magic == EVENTLOG_MAGIC && header->firstSequence != EVENTLOG_BLANK;
+}
+
+/* پاک شده و آماده باز شدن */
+static uint8_t EventLog_IsSpare(uint8_t s)
+{
+    const EventLogHeader_t *header = EventLog_Header(s);
+    return header->magic == EVENTLOG_MAGIC && header->firstSequence == EVENTLOG_BLANK;
+}
+
+static uint8_t EventLog_IsBlank(const EventLogRecord_t *record)
+{
+    const uint32_t *words = (const uint32_t *)record;
+    return (words[0] & words[1] & words[2] & words[3]) == EVENTLOG_BLANK;
+}
+
+static uint16_t EventLog_Check(const EventLogRecord_t *record)
+{
+    uint32_t x = record->sequence ^ record->time ^ record->data
+               ^ ((uint32_t)record->type << 8) ^ record->detail ^ 0x5A5AU;
+    return (uint16_t)(x ^ (x >> 16));
+}
+
+static uint8_t EventLog_IsValid(const EventLogRecord_t *record)
+{
+    return record->type != 0xFF && record->check == EventLog_Check(record);
+}
+
+/* خانه‌ها به ترتیب پر می‌شوند: اولین خانه خالی با جست‌وجوی دودویی */
+static uint32_t EventLog_FindEnd(uint8_t s)
+{
+    uint32_t low = 1, high = EventLog_Slots(s);
+
+    while (low < high) {
+        uint32_t mid = (low + high) / 2;
+        if (EventLog_IsBlank(EventLog_Slot(s, mid))) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return low;
+}
+
+/* ================================================
+ * نوشتن (flash باید unlock باشد)
+ * ================================================ */
+static uint8_t EventLog_ProgramWord(uint32_t address, uint32_t value)
+{
+    return HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address, value) == HAL_OK;
+}
+
+/* پاک کردن و نوشتن امضا و تعداد پاک شدن؛ CPU تا پایان پاک شدن متوقف است */
+static uint8_t EventLog_EraseSector(uint8_t s)
+{
+    const EventLogHeader_t *header = EventLog_Header(s);
+    uint32_t eraseCount = (header->magic == EVENTLOG_MAGIC) ? header->eraseCount + 1U : 1U;
+    uint32_t elapsedMs;
+
+    Integrity_Forget((IntegrityRegion_t)(INTEGRITY_LOG0 + s));
+    HAL_StatusTypeDef status = FlashMap_EraseSector(sectors[s].sector, &elapsedMs);
+
+    stats.erases++;
+    if (elapsedMs > stats.maxEraseMs) {
+        stats.maxEraseMs = elapsedMs;
+    }
+
+    return status == HAL_OK
+        && EventLog_ProgramWord(sectors[s].address, EVENTLOG_MAGIC)
+        && EventLog_ProgramWord(sectors[s].address + 4U, eraseCount);
+}
+
+static uint8_t EventLog_Open(uint8_t s, uint32_t sequence)
+{
+    if (!EventLog_ProgramWord(sectors[s].address + 8U, sequence)) {
+        return 0;
+    }
+    active = s;
+    firstSequence = sequence;
+    nextSlot = 1;
+    return 1;
+}
+
+/* sector پر: CRC سخت‌افزاری رکوردها در سرآیند (حدود 0.3ms برای 16K، یک بار
+ * در هر دور حلقه) و از این پس بررسی دوره‌ای */
+static void EventLog_Seal(uint8_t s)
+{
+    uint32_t address = sectors[s].address + EVENTLOG_RECORD_SIZE;
+    uint32_t length = sectors[s].size - EVENTLOG_RECORD_SIZE;
+    uint32_t crc = Crc_Compute(address, length / 4U);
+
+    if (EventLog_ProgramWord(sectors[s].address + 12U, crc)) {
+        Integrity_Watch((IntegrityRegion_t)(INTEGRITY_LOG0 + s), address, length, crc, 1);
+        stats.seals++;
+    }
+}
+
+/* یک رکورد در خانه بعدی؛ 4 کلمه (5 با باز کردن sector بعدی)، هرگز پاک نمی‌کند */
+static uint8_t EventLog_Write(EventLogRecord_t *record)
+{
+    if (nextSlot >= EventLog_Slots(active)) {
+        uint8_t next = (uint8_t)((active + 1U) % EVENTLOG_SECTOR_COUNT);
+        if (EventLog_IsSpare(next)) {
+            EventLog_Open(next, firstSequence + nextSlot - 1U);
+        }
+    }
+    if (nextSlot >= EventLog_Slots(active)) {
+        return 0;
+    }
+
+    uint32_t address = sectors[active].address + nextSlot * EVENTLOG_RECORD_SIZE;
+    const uint32_t *words = (const uint32_t *)record;
+
+    record->sequence = firstSequence + nextSlot - 1U;
+    record->check = EventLog_Check(record);
+
+    /* خانه حتی با خطای برنامه کردن مصرف شده حساب می‌شود */
+    nextSlot++;
+    uint8_t ok = EventLog_ProgramWord(address, words[0])
+              && EventLog_ProgramWord(address + 4U, words[1])
+              && EventLog_ProgramWord(address + 12U, words[3])
+              && EventLog_ProgramWord(address + 8U, words[2]);
+    if (nextSlot == EventLog_Slots(active)) {
+        EventLog_Seal(active);
+    }
+    return ok;
+}
+
+/* کل بافر با یک unlock، به ترتیب ورود */
+static void EventLog_Commit(EventLogStage_t *stage)
+{
+    if (stage->count == 0) {
+        return;
+    }
+
+    uint32_t start = Timing_GetCycles();
+    HAL_FLASH_Unlock();
+    for (uint8_t i = 0; i < stage->count; i++) {
+        if (EventLog_Write(&stage->records[i])) {
+            stats.committed++;
+        } else {
+            stats.dropped++;
+        }
+    }
+    HAL_FLASH_Lock();
+    stage->count = 0;
+
+    stats.commits++;
+    uint32_t cycles = Timing_ElapsedCycles(start);
+    if (cycles > stats.maxCommitCycles) {
+        stats.maxCommitCycles = cycles;
+    }
+}
+
+/* ================================================
+ * رابط
+ * ================================================ */
+void EventLog_Init(void)
+{
+    int8_t newest = -1;
+
+    memset(&stats, 0, sizeof(stats));
+    memset(stages, 0, sizeof(stages));
+    filling = 0;
+    pending = 0;
+    urgent = 0;
+    ready = 0;
+
+    for (uint8_t s = 0; s < EVENTLOG_SECTOR_COUNT; s++) {
+        if (EventLog_IsOpen(s) && (newest < 0
+            || EventLog_Header(s)->firstSequence > EventLog_Header((uint8_t)newest)->firstSequence)) {
+            newest = (int8_t)s;
+        }
+    }
+
+    /* sector های مهرشده در پس‌زمینه بررسی می‌شوند؛ پرِ بی‌مهر (قطع برق
+     * بین آخرین رکورد و مهر) همین‌جا مهر می‌شود */
+    HAL_FLASH_Unlock();
+    for (uint8_t s = 0; s < EVENTLOG_SECTOR_COUNT; s++) {
+        const EventLogHeader_t *header = EventLog_Header(s);
+        if (!EventLog_IsOpen(s)) {
+            continue;
+        }
+        if (header->sealedCrc != EVENTLOG_BLANK) {
+            Integrity_Watch((IntegrityRegion_t)(INTEGRITY_LOG0 + s), sectors[s].address + EVENTLOG_RECORD_SIZE,
+                            sectors[s].size - EVENTLOG_RECORD_SIZE, header->sealedCrc, 0);
+        } else if (EventLog_FindEnd(s) == EventLog_Slots(s)) {
+            EventLog_Seal(s);
+        }
+    }
+    HAL_FLASH_Lock();
+
+    if (newest >= 0) {
+        active = (uint8_t)newest;
+        firstSequence = EventLog_Header(active)->firstSequence;
+        nextSlot = EventLog_FindEnd(active);
+        ready = 1;
+    } else {
+        /* flash تازه: تنها پاک کردن خارج از EventLog_EraseNext، قبل از شروع تسک‌ها */
+        HAL_FLASH_Unlock();
+        ready = (EventLog_IsSpare(0) || EventLog_EraseSector(0)) && EventLog_Open(0, 1);
+        HAL_FLASH_Lock();
+    }
+
+    EventLog_Append(EVENTLOG_BOOT, 0, 0);
+}
+
+/* فقط کپی در RAM؛ فقط وقتی بافر در حال پر شدن پر است همین‌جا نوشته
+ * می‌شود: اگر بافر دیگر هم منتظر است اول همان (قدیمی‌تر)، وگرنه خودش */
+uint8_t EventLog_Append(EventLogType_t type, uint8_t detail, uint32_t data)
+{
+    if (!ready) {
+        stats.dropped++;
+        return 0;
+    }
+
+    uint32_t start = Timing_GetCycles();
+    EventLogStage_t *stage = &stages[filling];
+
+    if (stage->count == EVENTLOG_STAGE_RECORDS) {
+        stats.inlineCommits++;
+        if (pending) {
+            EventLog_Commit(&stages[filling ^ 1U]);
+            filling ^= 1U;              /* بافر پر حالا منتظر نوشتن است */
+            stage = &stages[filling];
+        } else {
+            EventLog_Commit(stage);
+        }
+    }
+
+    EventLogRecord_t *record = &stage->records[stage->count];
+    record->time = HAL_GetTick();
+    record->type = (uint8_t)type;
+    record->detail = detail;
+    record->data = data;
+    if (stage->count++ == 0) {
+        stage->firstTick = record->time;
+    }
+    stats.appended++;
+
+    if (EVENTLOG_CRITICAL_TYPES & (1UL << type)) {
+        urgent = 1;
+    }
+    if (stage->count == EVENTLOG_STAGE_RECORDS && !pending) {
+        pending = 1;
+        filling ^= 1U;
+    }
+
+    uint32_t cycles = Timing_ElapsedCycles(start);
+    if (cycles > stats.maxAppendCycles) {
+        stats.maxAppendCycles = cycles;
+    }
+    return 1;
+}
+
+/* بافر پر همیشه؛ بافر در حال پر شدن بعد از EVENTLOG_FLUSH_MS یا برای رویداد بحرانی */
+void EventLog_Task(void)
+{
+    EventLogStage_t *stage = &stages[filling];
+
+    if (pending) {
+        EventLog_Commit(&stages[filling ^ 1U]);
+        pending = 0;
+    }
+    if (stage->count > 0 && (urgent || HAL_GetTick() - stage->firstTick >= EVENTLOG_FLUSH_MS)) {
+        EventLog_Commit(stage);
+    } else if (stage->count == EVENTLOG_STAGE_RECORDS) {
+        /* وقتی بافر دیگر منتظر بود پر شد؛ نوبت بعدی تسک */
+        pending = 1;
+        filling ^= 1U;
+    }
+    urgent = 0;
+}
+
+/* همه رکوردهای RAM همین حالا (مثلاً پیش از reset عمدی) */
+void EventLog_Flush(void)
+{
+    urgent = 1;
+    EventLog_Task();
+}
+
+/* رکوردی در RAM منتظر نیست */
+uint8_t EventLog_IsIdle(void)
+{
+    return !pending && stages[filling].count == 0;
+}
+
+/* شماره بعدی در flash؛ رکوردهای RAM به همین ترتیب پشت آن می‌آیند */
+static uint32_t EventLog_CommittedSequence(void)
+{
+    return firstSequence + nextSlot - 1U;
+}
+
+/* رکورد شماره back از آخر در بافرهای RAM (جدیدترین اول) */
+static uint8_t EventLog_ReadStaged(uint32_t *back, EventLogRecord_t *record)
+{
+    const EventLogStage_t *stage = &stages[filling];
+    const EventLogStage_t *older = &stages[filling ^ 1U];
+    uint32_t olderCount = pending ? older->count : 0;
+    uint32_t sequence;
+
+    if (*back < stage->count) {
+        *record = stage->records[stage->count - 1U - *back];
+        sequence = EventLog_CommittedSequence() + olderCount + stage->count - 1U - *back;
+    } else if (*back < stage->count + olderCount) {
+        uint32_t index = olderCount - 1U - (*back - stage->count);
+        *record = older->records[index];
+        sequence = EventLog_CommittedSequence() + index;
+    } else {
+        *back -= stage->count + olderCount;
+        return 0;
+    }
+    record->sequence = sequence;
+    record->check = EventLog_Check(record);
+    return 1;
+}
+
+/* back = 0 جدیدترین رکورد (RAM یا flash)؛ 0 اگر به این عمق رکوردی نباشد */
+uint8_t EventLog_Read(uint32_t back, EventLogRecord_t *record)
+{
+    uint8_t s = active;
+    uint32_t slot = nextSlot;
+
+    if (!ready) {
+        return 0;
+    }
+    if (EventLog_ReadStaged(&back, record)) {
+        return 1;
+    }
+
+    for (uint8_t n = 0; n < EVENTLOG_SECTOR_COUNT; n++) {
+        while (slot > 1) {
+            const EventLogRecord_t *candidate = EventLog_Slot(s, --slot);
+            if (EventLog_IsValid(candidate) && back-- == 0) {
+                *record = *candidate;
+                return 1;
+            }
+        }
+
+        /* sector قبلی در حلقه فقط اگر قدیمی‌تر باشد (نه پاک شده یا رونویسی‌شده) */
+        uint32_t newer = EventLog_Header(s)->firstSequence;
+        s = (uint8_t)((s + EVENTLOG_SECTOR_COUNT - 1U) % EVENTLOG_SECTOR_COUNT);
+        if (!EventLog_IsOpen(s) || EventLog_Header(s)->firstSequence >= newer) {
+            break;
+        }
+        slot = EventLog_FindEnd(s);
+    }
+    return 0;
+}
+
+uint32_t EventLog_NextSequence(void)
+{
+    return EventLog_CommittedSequence() + (pending ? stages[filling ^ 1U].count : 0U) + stages[filling].count;
+}
+
+/* sector فعال نزدیک پر شدن است و بعدی هنوز پاک نشده */
+uint8_t EventLog_NeedsErase(void)
+{
+    uint8_t next = (uint8_t)((active + 1U) % EVENTLOG_SECTOR_COUNT);
+
+    return ready && !EventLog_IsSpare(next)
+        && (EventLog_Slots(active) - nextSlot) * EVENTLOG_RECORD_SIZE < EVENTLOG_PREERASE_FREE;
+}
+
+/* قدیمی‌ترین رکوردها (sector بعدی) از بین می‌روند؛ فقط در زمان سکون صدا زده شود */
+void EventLog_EraseNext(void)
+{
+    uint8_t next = (uint8_t)((active + 1U) % EVENTLOG_SECTOR_COUNT);
+
+    HAL_FLASH_Unlock();
+    EventLog_EraseSector(next);
+    HAL_FLASH_Lock();
+}
+
+void EventLog_GetStats(EventLogStats_t *out)
+{
+    *out = stats;
+}
@@ -0,0 +1,33 @@
+/* =================================================================
+ * پاک کردن sector های داده (گزارش رویدادها، EEPROM، پیکربندی)
+ *
+ * در مدت پاک کردن خواندن flash متوقف است و SysTick فقط یک بار pending
+ * می‌شود؛ میلی‌ثانیه‌های گم‌شده از شمارنده سیکل DWT جبران می‌شوند تا
+ * HAL_GetTick عقب نماند. flash باید unlock باشد.
+ * ================================================================= */
+
+#include "flash_map.h"
+#include "timing.h"
+
+HAL_StatusTypeDef FlashMap_EraseSector(uint32_t sector, uint32_t *elapsedMs)
+{
+    FLASH_EraseInitTypeDef erase;
+    uint32_t sectorError = 0;
+    uint32_t startTick = HAL_GetTick();
+    uint32_t startCycles = Timing_GetCycles();
+
+    erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+    erase.Banks = FLASH_BANK_1;
+    erase.Sector = sector;
+    erase.NbSectors = 1;
+    erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+    HAL_StatusTypeDef status = HAL_FLASHEx_Erase(&erase, &sectorError);
+
+    uint32_t elapsed = Timing_ElapsedUs(startCycles) / 1000U;
+    uint32_t counted = HAL_GetTick() - startTick;
+    while (counted++ < elapsed) {
+        HAL_IncTick();
+    }
+    *elapsedMs = elapsed;
+    return status;
+}
@@ -0,0 +1,490 @@
+/* =================================================================
+ * درایور LCD کاراکتری HD44780 (4 بیتی) با بافر سایه
+ *
+ * LCD_Print / LCD_SetCursor / LCD_Clear فقط در بافر سایه (RAM) می‌نویسند.
+ * LCD_FlushStep (تسک پس‌زمینه) بافر سایه را با محتوای فعلی پنل مقایسه
+ * کرده و فقط خانه‌های تغییر کرده را با کمترین جابجایی کرسر ارسال می‌کند.
+ *
+ * در حالت LCD_USE_DMA هر بایت به 7 کلمه BSRR پورت GPIOA تبدیل می‌شود
+ * (داده+RS، EN=1، EN=0 برای هر نیم‌بایت و یک کلمه خالی برای زمان اجرا)
+ * و TIM1 با هر update یک درخواست DMA2 Stream5 / Channel6 می‌دهد تا
+ * کلمه بعدی را در GPIOA->BSRR بنویسد.
+ * ================================================================= */
+
+#include "hd44780.h"
+#include "timing.h"
+#include "profile.h"
+#include <string.h>
+
+#if defined(LCD20x4)
+static const uint8_t LCD_RowAddress[4] = {0x00, 0x40, 0x14, 0x54};
+#else
+static const uint8_t LCD_RowAddress[4] = {0x00, 0x40, 0x10, 0x50};
+#endif
+
+static char shadow[LCD_ROWS][LCD_COLS];   /* آنچه باید نمایش داده شود */
+static char panel[LCD_ROWS][LCD_COLS];    /* آنچه الان روی پنل است */
+static uint8_t dirtyRows = 0;             /* بیت r = سطر r احتمالاً تغییر کرده */
+static uint8_t cursorRow = 0;
+static uint8_t cursorCol = 0;
+static uint8_t panelAddr = 0xFF;          /* آدرس DDRAM فعلی پنل؛ 0xFF = نامعلوم */
+
+#if LCD_USE_DMA
+DMA_HandleTypeDef hdma_tim1_up;
+
+static uint32_t dmaBuffer[LCD_DMA_MAX_BYTES * LCD_DMA_WORDS_PER_BYTE];
+static uint16_t dmaWords = 0;
+static volatile uint8_t dmaBusy = 0;
+static uint32_t nibbleBsrr[16];           /* کلمه BSRR هر نیم‌بایت روی PA4-PA7 */
+
+static void LCD_DMA_Init(void);
+static void LCD_DMA_Start(void);
+static void LCD_DMA_XferCplt(DMA_HandleTypeDef *hdma);
+#endif
+
+static void LCD_Emit(uint8_t isData, uint8_t value);
+static void LCD_WriteNibble(uint8_t nibble);
+static void LCD_WaitReady(uint32_t fallbackUs);
+#if LCD_USE_BUSY_FLAG
+static void LCD_SetDataInput(uint8_t input);
+static uint8_t LCD_ReadStatus(void);
+static uint8_t LCD_ProbeBusyFlag(void);
+static uint8_t busyFlagUsable = 0;        /* فقط بعد از آزمون LCD_Init */
+#endif
+static uint16_t LCD_CollectChanges(uint16_t maxCells);
+
+/* ================================================
+ * ارسال روی باس
+ * ================================================ */
+void LCD_Init(void)
+{
+#if LCD_USE_BUSY_FLAG
+    busyFlagUsable = 0;
+#endif
+    HAL_Delay(20);  // delay ضروری برای power-up
+
+    /* مراحل اولیه initialization */
+    HAL_GPIO_WritePin(LCD_RS_GPIO_Port, LCD_RS_Pin, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(LCD_RW_GPIO_Port, LCD_RW_Pin, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(LCD_EN_GPIO_Port, LCD_EN_Pin, GPIO_PIN_RESET);
+
+    /* ارسال 0x03 سه بار برای تضمین 4-bit mode */
+    for(int i = 0; i < 3; i++) {
+        HAL_GPIO_WritePin(LCD_D4_GPIO_Port, LCD_D4_Pin, GPIO_PIN_SET);
+        HAL_GPIO_WritePin(LCD_D5_GPIO_Port, LCD_D5_Pin, GPIO_PIN_SET);
+        HAL_GPIO_WritePin(LCD_D6_GPIO_Port, LCD_D6_Pin, GPIO_PIN_RESET);
+        HAL_GPIO_WritePin(LCD_D7_GPIO_Port, LCD_D7_Pin, GPIO_PIN_RESET);
+
+        HAL_GPIO_WritePin(LCD_EN_GPIO_Port, LCD_EN_Pin, GPIO_PIN_SET);
+        delay_us(1);
+        HAL_GPIO_WritePin(LCD_EN_GPIO_Port, LCD_EN_Pin, GPIO_PIN_RESET);
+        HAL_Delay(5);
+    }
+
+    /* تنظیم 4-bit mode */
+    HAL_GPIO_WritePin(LCD_D4_GPIO_Port, LCD_D4_Pin, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(LCD_D5_GPIO_Port, LCD_D5_Pin, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(LCD_D6_GPIO_Port, LCD_D6_Pin, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(LCD_D7_GPIO_Port, LCD_D7_Pin, GPIO_PIN_RESET);
+
+    HAL_GPIO_WritePin(LCD_EN_GPIO_Port, LCD_EN_Pin, GPIO_PIN_SET);
+    delay_us(1);
+    HAL_GPIO_WritePin(LCD_EN_GPIO_Port, LCD_EN_Pin, GPIO_PIN_RESET);
+    HAL_Delay(5);
+
+    /* حالا از توابع عادی استفاده کنیم؛ تا آزمون BF با زمان ثابت */
+    LCD_SendCommand(0x28); // 4-bit mode, 2 lines, 5x8 dots
+    LCD_SendCommand(0x0C); // Display ON, Cursor OFF
+    LCD_SendCommand(0x06); // Auto increment cursor
+#if LCD_USE_BUSY_FLAG
+    busyFlagUsable = LCD_ProbeBusyFlag();
+#endif
+    LCD_SendCommand(0x01); // Clear display
+
+    /* پنل و بافر سایه هر دو خالی */
+    memset(panel, ' ', sizeof(panel));
+    memset(shadow, ' ', sizeof(shadow));
+    dirtyRows = 0;
+    cursorRow = cursorCol = 0;
+    panelAddr = LCD_RowAddress[0];
+
+#if LCD_USE_DMA
+    LCD_DMA_Init();
+#endif
+}
+
+void LCD_SendCommand(uint8_t cmd)
+{
+    LCD_WaitIdle();
+
+    /* RS = 0 برای دستور */
+    HAL_GPIO_WritePin(LCD_RS_GPIO_Port, LCD_RS_Pin, GPIO_PIN_RESET);
+    LCD_WriteNibble(cmd >> 4);
+    LCD_WriteNibble(cmd & 0x0F);
+
+    /* Clear و Return home طولانی هستند، بقیه دستورها حدود 37us */
+    LCD_WaitReady((cmd < 0x04) ? LCD_EXEC_SLOW_US : LCD_EXEC_US);
+}
+
+void LCD_SendData(uint8_t data)
+{
+    PROFILE_BEGIN();
+    LCD_WaitIdle();
+
+    /* RS = 1 برای داده */
+    HAL_GPIO_WritePin(LCD_RS_GPIO_Port, LCD_RS_Pin, GPIO_PIN_SET);
+    LCD_WriteNibble(data >> 4);
+    LCD_WriteNibble(data & 0x0F);
+
+    LCD_WaitReady(LCD_EXEC_US);
+    PROFILE_END(PROF_LCD_SEND_DATA);
+}
+
+static void LCD_WriteNibble(uint8_t nibble)
+{
+    HAL_GPIO_WritePin(LCD_D4_GPIO_Port, LCD_D4_Pin, (nibble & 0x01) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(LCD_D5_GPIO_Port, LCD_D5_Pin, (nibble & 0x02) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(LCD_D6_GPIO_Port, LCD_D6_Pin, (nibble & 0x04) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(LCD_D7_GPIO_Port, LCD_D7_Pin, (nibble & 0x08) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+
+    /* پالس Enable؛ داده روی لبه پایین‌رونده خوانده می‌شود */
+    HAL_GPIO_WritePin(LCD_EN_GPIO_Port, LCD_EN_Pin, GPIO_PIN_SET);
+    delay_us(1);
+    HAL_GPIO_WritePin(LCD_EN_GPIO_Port, LCD_EN_Pin, GPIO_PIN_RESET);
+    delay_us(1);
+}
+
+/* صبر تا پایان اجرای بایت قبلی: با busy flag یا زمان ثابت کالیبره شده */
+static void LCD_WaitReady(uint32_t fallbackUs)
+{
+#if LCD_USE_BUSY_FLAG
+    if (busyFlagUsable) {
+        uint32_t polls = 0;
+
+        LCD_SetDataInput(1);
+        HAL_GPIO_WritePin(LCD_RS_GPIO_Port, LCD_RS_Pin, GPIO_PIN_RESET);
+        HAL_GPIO_WritePin(LCD_RW_GPIO_Port, LCD_RW_Pin, GPIO_PIN_SET);
+
+        while (LCD_ReadStatus() & 0x80) {
+            if (++polls >= LCD_BUSY_MAX_POLLS) {
+                /* BF هرگز صفر نشد: احتمالاً R/W وصل نیست، از این به بعد زمان ثابت */
+                busyFlagUsable = 0;
+                break;
+            }
+        }
+
+        HAL_GPIO_WritePin(LCD_RW_GPIO_Port, LCD_RW_Pin, GPIO_PIN_RESET);
+        LCD_SetDataInput(0);
+        if (busyFlagUsable) {
+            return;
+        }
+    }
+#endif
+    delay_us(fallbackUs);
+}
+
+#if LCD_USE_BUSY_FLAG
+static void LCD_SetDataInput(uint8_t input)
+{
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+    GPIO_InitStruct.Pin = LCD_D4_Pin|LCD_D5_Pin|LCD_D6_Pin|LCD_D7_Pin;
+    GPIO_InitStruct.Mode = input ? GPIO_MODE_INPUT : GPIO_MODE_OUTPUT_PP;
+    GPIO_InitStruct.Pull = input ? GPIO_PULLUP : GPIO_NOPULL;  /* باس شناور BF=1 خوانده شود نه 0 */
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+    HAL_GPIO_Init(LCD_D4_GPIO_Port, &GPIO_InitStruct);
+}
+
+/* خواندن ثبات وضعیت (BF در بیت 7، آدرس در بیت‌های 0-6) در دو نیم‌بایت */
+static uint8_t LCD_ReadStatus(void)
+{
+    uint8_t status = 0;
+
+    for (int half = 0; half < 2; half++) {
+        HAL_GPIO_WritePin(LCD_EN_GPIO_Port, LCD_EN_Pin, GPIO_PIN_SET);
+        delay_us(1);
+        status = (uint8_t)(status << 4);
+        if (HAL_GPIO_ReadPin(LCD_D4_GPIO_Port, LCD_D4_Pin) == GPIO_PIN_SET) status |= 0x01;
+        if (HAL_GPIO_ReadPin(LCD_D5_GPIO_Port, LCD_D5_Pin) == GPIO_PIN_SET) status |= 0x02;
+        if (HAL_GPIO_ReadPin(LCD_D6_GPIO_Port, LCD_D6_Pin) == GPIO_PIN_SET) status |= 0x04;
+        if (HAL_GPIO_ReadPin(LCD_D7_GPIO_Port, LCD_D7_Pin) == GPIO_PIN_SET) status |= 0x08;
+        HAL_GPIO_WritePin(LCD_EN_GPIO_Port, LCD_EN_Pin, GPIO_PIN_RESET);
+        delay_us(1);
+    }
+    return status;
+}
+
+/* آدرس DDRAM 0x05 و خواندن شمارنده آدرس: فقط اگر پنل واقعاً جواب دهد AC=5 و
+ * BF=0 است. اگر R/W به زمین وصل باشد دو پالس خواندن یک بایت فرمان از باس
+ * (با pull-up همان 0xFF، یعنی آدرس 0x7F) می‌نویسند که Clear بعدی پاکش می‌کند */
+static uint8_t LCD_ProbeBusyFlag(void)
+{
+    uint8_t status;
+
+    LCD_SendCommand(0x80 | 0x05);
+    LCD_SetDataInput(1);
+    HAL_GPIO_WritePin(LCD_RS_GPIO_Port, LCD_RS_Pin, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(LCD_RW_GPIO_Port, LCD_RW_Pin, GPIO_PIN_SET);
+    status = LCD_ReadStatus();
+    HAL_GPIO_WritePin(LCD_RW_GPIO_Port, LCD_RW_Pin, GPIO_PIN_RESET);
+    LCD_SetDataInput(0);
+    delay_us(LCD_EXEC_US);
+
+    return status == 0x05;
+}
+#endif
+
+/* ================================================
+ * بافر سایه
+ * ================================================ */
+void LCD_PutChar(char c)
+{
+    if (cursorRow >= LCD_ROWS || cursorCol >= LCD_COLS) {
+        return; // خارج از صفحه: مثل پنل واقعی دیده نمی‌شود
+    }
+    if (shadow[cursorRow][cursorCol] != c) {
+        shadow[cursorRow][cursorCol] = c;
+        dirtyRows |= (uint8_t)(1u << cursorRow);
+    }
+    cursorCol++;
+}
+
+void LCD_Print(const char *str)
+{
+    while (*str) {
+        LCD_PutChar(*str++);
+    }
+}
+
+void LCD_SetCursor(uint8_t row, uint8_t col)
+{
+    cursorRow = row;
+    cursorCol = col;
+}
+
+/* به جای فرمان 0x01 (2ms و چشمک) فقط بافر سایه با فاصله پر می‌شود */
+void LCD_Clear(void)
+{
+    for (uint8_t row = 0; row < LCD_ROWS; row++) {
+        for (uint8_t col = 0; col < LCD_COLS; col++) {
+            if (shadow[row][col] != ' ') {
+                shadow[row][col] = ' ';
+                dirtyRows |= (uint8_t)(1u << row);
+            }
+        }
+    }
+    cursorRow = cursorCol = 0;
+}
+
+uint8_t LCD_IsDirty(void)
+{
+    return dirtyRows != 0;
+}
+
+/* ارسال حداکثر maxCells خانه تغییر کرده؛ تعداد بایت‌های ارسالی را برمی‌گرداند */
+uint16_t LCD_FlushStep(uint16_t maxCells)
+{
+    uint16_t sent;
+
+#if LCD_USE_DMA
+    if (dmaBusy) {
+        return 0; // انتقال قبلی هنوز تمام نشده
+    }
+    if (maxCells > LCD_DMA_MAX_BYTES) {
+        maxCells = LCD_DMA_MAX_BYTES;
+    }
+
+    PROFILE_BEGIN();
+    dmaWords = 0;
+    sent = LCD_CollectChanges(maxCells);
+    if (dmaWords > 0) {
+        LCD_DMA_Start();
+    }
+#else
+    PROFILE_BEGIN();
+    sent = LCD_CollectChanges(maxCells);
+#endif
+    PROFILE_END(PROF_LCD_FLUSH);
+    return sent;
+}
+
+static uint16_t LCD_CollectChanges(uint16_t maxCells)
+{
+    uint16_t sent = 0;
+
+    for (uint8_t row = 0; row < LCD_ROWS && dirtyRows; row++) {
+        if (!(dirtyRows & (1u << row))) {
+            continue;
+        }
+
+        uint8_t col = 0;
+        while (col < LCD_COLS) {
+            if (shadow[row][col] == panel[row][col]) {
+                col++;
+                continue;
+            }
+            /* فاصله کوتاه در همین سطر: بازنویسی خانه‌های سالم بین راه
+             * هزینه‌ای بیشتر از فرمان جابجایی کرسر ندارد */
+            uint8_t addr = LCD_RowAddress[row] + col;
+            uint8_t rowStart = LCD_RowAddress[row];
+            uint8_t bridge = panelAddr >= rowStart && panelAddr < addr &&
+                             (uint8_t)(addr - panelAddr) <= LCD_FLUSH_BRIDGE_GAP;
+            uint16_t needed = 1U + (panelAddr == addr ? 0U : bridge ? (uint16_t)(addr - panelAddr) : 1U);
+
+            /* جابجایی یا پل و خود خانه با هم؛ بافر DMA هرگز از maxCells بایت بیشتر نمی‌گیرد */
+            if (sent + needed > maxCells) {
+                return sent; // بقیه سطر در فراخوانی بعدی
+            }
+
+            if (panelAddr != addr) {
+                if (bridge) {
+                    while (panelAddr < addr) {
+                        LCD_Emit(1, (uint8_t)panel[row][panelAddr - rowStart]);
+                        panelAddr++;
+                        sent++;
+                    }
+                } else {
+                    LCD_Emit(0, 0x80 | addr);
+                    panelAddr = addr;
+                    sent++;
+                }
+            }
+
+            LCD_Emit(1, (uint8_t)shadow[row][col]);
+            panel[row][col] = shadow[row][col];
+            panelAddr++;
+            sent++;
+            col++;
+        }
+        dirtyRows &= (uint8_t)~(1u << row);
+    }
+    return sent;
+}
+
+/* ارسال کامل و همزمان؛ برای جاهایی که بلافاصله بعدش block می‌شویم */
+void LCD_Flush(void)
+{
+    while (dirtyRows) {
+        LCD_WaitIdle();
+        LCD_FlushStep(LCD_ROWS * LCD_COLS);
+    }
+    LCD_WaitIdle();
+}
+
+uint8_t LCD_IsBusy(void)
+{
+#if LCD_USE_DMA
+    return dmaBusy;
+#else
+    return 0;
+#endif
+}
+
+void LCD_WaitIdle(void)
+{
+#if LCD_USE_DMA
+    while (dmaBusy) {
+    }
+#endif
+}
+
+/* یک بایت فرمان یا داده: در حالت CPU فوراً ارسال، در حالت DMA به بافر اضافه می‌شود */
+static void LCD_Emit(uint8_t isData, uint8_t value)
+{
+#if LCD_USE_DMA
+    uint32_t rs = isData ? LCD_RS_Pin : ((uint32_t)LCD_RS_Pin << 16);
+    uint32_t *w = &dmaBuffer[dmaWords];
+
+    w[0] = nibbleBsrr[value >> 4] | rs;             /* داده و RS، EN=0 */
+    w[1] = LCD_EN_Pin;                              /* EN=1 */
+    w[2] = (uint32_t)LCD_EN_Pin << 16;              /* EN=0: لبه پایین‌رونده داده را می‌گیرد */
+    w[3] = nibbleBsrr[value & 0x0F] | rs;
+    w[4] = LCD_EN_Pin;
+    w[5] = (uint32_t)LCD_EN_Pin << 16;
+    w[6] = 0;                                       /* بدون تغییر: لبه گرفتن بایت بعدی 40us بعد از w[5] */
+    dmaWords += LCD_DMA_WORDS_PER_BYTE;
+#else
+    if (isData) {
+        LCD_SendData(value);
+    } else {
+        LCD_SendCommand(value);
+    }
+#endif
+}
+
+#if LCD_USE_DMA
+/* ================================================
+ * TIM1 + DMA2
+ * ================================================ */
+static void LCD_DMA_Init(void)
+{
+    /* جدول BSRR: بیت‌های 1 نیم‌بایت set و بیت‌های 0 آن reset می‌شوند */
+    for (uint32_t n = 0; n < 16; n++) {
+        uint32_t set = 0, reset = 0;
+        if (n & 0x1) set |= LCD_D4_Pin; else reset |= LCD_D4_Pin;
+        if (n & 0x2) set |= LCD_D5_Pin; else reset |= LCD_D5_Pin;
+        if (n & 0x4) set |= LCD_D6_Pin; else reset |= LCD_D6_Pin;
+        if (n & 0x8) set |= LCD_D7_Pin; else reset |= LCD_D7_Pin;
+        nibbleBsrr[n] = set | (reset << 16);
+    }
+
+    __HAL_RCC_DMA2_CLK_ENABLE();
+    __HAL_RCC_TIM1_CLK_ENABLE();
+
+    /* TIM1_UP -> DMA2 Stream5 Channel6، حافظه به GPIOA->BSRR */
+    hdma_tim1_up.Instance = DMA2_Stream5;
+    hdma_tim1_up.Init.Channel = DMA_CHANNEL_6;
+    hdma_tim1_up.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_tim1_up.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_tim1_up.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_tim1_up.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+    hdma_tim1_up.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+    hdma_tim1_up.Init.Mode = DMA_NORMAL;
+    hdma_tim1_up.Init.Priority = DMA_PRIORITY_LOW;
+    hdma_tim1_up.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_tim1_up) != HAL_OK) {
+        Error_Handler();
+    }
+    HAL_DMA_RegisterCallback(&hdma_tim1_up, HAL_DMA_XFER_CPLT_CB_ID, LCD_DMA_XferCplt);
+
+    HAL_NVIC_SetPriority(DMA2_Stream5_IRQn, 6, 0);
+    HAL_NVIC_EnableIRQ(DMA2_Stream5_IRQn);
+
+    /* فاصله هر کلمه LCD_DMA_WORD_US؛ EN بایت بعد 3 کلمه (30us) بعد از لبه پایین‌رونده آخر
+     * بایت قبل بالا می‌رود و نیم‌بایت اولش 4 کلمه (40us) بعد، بیش از 37us اجرا، گرفته می‌شود */
+    uint32_t timerClock = HAL_RCC_GetPCLK2Freq();
+    if ((RCC->CFGR & RCC_CFGR_PPRE2) != 0) {
+        timerClock *= 2;
+    }
+    TIM1->CR1 = 0;
+    TIM1->PSC = 0;
+    TIM1->ARR = (timerClock / 1000000U) * LCD_DMA_WORD_US - 1U;
+    TIM1->EGR = TIM_EGR_UG;
+    TIM1->SR = 0;
+}
+
+static void LCD_DMA_Start(void)
+{
+    dmaBusy = 1;
+    if (HAL_DMA_Start_IT(&hdma_tim1_up, (uint32_t)dmaBuffer, (uint32_t)&GPIOA->BSRR, dmaWords) != HAL_OK) {
+        dmaBusy = 0;
+        return;
+    }
+    TIM1->CNT = 0;
+    TIM1->SR = 0;
+    TIM1->DIER |= TIM_DIER_UDE;
+    TIM1->CR1 |= TIM_CR1_CEN;
+}
+
+static void LCD_DMA_XferCplt(DMA_HandleTypeDef *hdma)
+{
+    TIM1->DIER &= ~TIM_DIER_UDE;
+    TIM1->CR1 &= ~TIM_CR1_CEN;
+    dmaBusy = 0;
+    LCD_TransferCompleteCallback();
+}
+
+__weak void LCD_TransferCompleteCallback(void)
+{
+}
+#endif /* LCD_USE_DMA */
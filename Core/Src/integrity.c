@@ -0,0 +1,234 @@
+/* =================================================================
+ * بررسی سلامت flash - پیاده‌سازی
+ *
+ * کار جاری (job) یک ناحیه است با checkpoint = {کلمه‌های انجام‌شده، CRC تا
+ * آنجا}. برش بعدی همان CRC->DR را ادامه می‌دهد؛ اگر در این فاصله کس
+ * دیگری واحد را به کار برده باشد (Crc_Transfers عوض شده) یا DMA خطا
+ * داده باشد، ناحیه از اول شروع می‌شود. ناحیه می‌تواند چند آرایه جدا
+ * باشد (span)؛ CRC از یکی به بعدی ادامه پیدا می‌کند و برش از مرز آرایه
+ * رد نمی‌شود.
+ * ================================================================= */
+
+#include "integrity.h"
+#include "crc.h"
+#include "eventlog.h"
+#include "timing.h"
+#include "cards.h"
+#include "users.h"
+#include "revoke.h"
+#include <string.h>
+
+typedef struct {
+    IntegritySpan_t single;             /* ناحیه یک‌تکه Integrity_Watch */
+    const IntegritySpan_t *spans;
+    uint8_t spanCount;
+    uint32_t words;                     /* جمع همه span ها */
+    uint32_t expected;
+    uint32_t lastCheck;                 /* HAL_GetTick آخرین بررسی کامل */
+    uint8_t watched;
+    uint8_t pending;                    /* در اولین فرصت */
+    IntegrityStatus_t status;
+} IntegrityRegionState_t;
+
+static IntegrityRegionState_t regions[INTEGRITY_REGIONS];
+static IntegrityStats_t stats;
+
+static int8_t job = -1;
+static uint32_t jobDone = 0;            /* کلمه */
+static uint32_t jobSlice = 0;           /* کلمه‌های برش در جریان؛ 0 = برشی در جریان نیست */
+static uint32_t jobTransfer = 0;        /* Crc_Transfers بعد از شروع برش */
+
+/* جدول‌های ثابت firmware از همان ابتدا زیر نظرند */
+void Integrity_Init(void)
+{
+    Crc_Init();
+    memset(regions, 0, sizeof(regions));
+    memset(&stats, 0, sizeof(stats));
+    job = -1;
+    jobSlice = 0;
+
+    Integrity_WatchImage(INTEGRITY_CARDS, &cardsTableCrc);
+    Integrity_WatchImage(INTEGRITY_USERS, &usersTableCrc);
+    Integrity_WatchImage(INTEGRITY_REVOKE, &revokeTableCrc);
+}
+
+/* ================================================
+ * ثبت ناحیه‌ها
+ * ================================================ */
+static void Integrity_Abort(IntegrityRegion_t region)
+{
+    if (job == (int8_t)region) {
+        job = -1;
+        jobSlice = 0;                   /* نتیجه برش در جریان دور ریخته می‌شود */
+    }
+}
+
+static void Integrity_Register(IntegrityRegion_t region, const IntegritySpan_t *spans, uint8_t count,
+                               uint32_t expected, uint8_t verified)
+{
+    IntegrityRegionState_t *r = &regions[region];
+
+    Integrity_Abort(region);
+    r->spans = spans;
+    r->spanCount = count;
+    r->words = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        r->words += spans[i].length / 4U;
+    }
+    r->expected = expected;
+    r->lastCheck = HAL_GetTick();
+    r->watched = 1;
+    r->pending = !verified;
+    r->status = verified ? INTEGRITY_OK : INTEGRITY_UNKNOWN;
+}
+
+/* length بایت (مضرب 4) با CRC مرجع expected؛ verified = همین الان با
+ * Crc_Compute بررسی شده و بررسی بعدی INTEGRITY_RECHECK_MS بعد است */
+void Integrity_Watch(IntegrityRegion_t region, uint32_t address, uint32_t length, uint32_t expected, uint8_t verified)
+{
+    IntegrityRegionState_t *r = &regions[region];
+
+    r->single.data = (const void *)(uintptr_t)address;
+    r->single.length = length;
+    Integrity_Register(region, &r->single, 1, expected, verified);
+}
+
+/* جدول تولیدشده؛ در اولین فرصت بررسی می‌شود */
+void Integrity_WatchImage(IntegrityRegion_t region, const IntegrityImage_t *image)
+{
+    Integrity_Register(region, image->spans, image->spanCount, image->crc, 0);
+}
+
+/* پیش از پاک کردن یا کنار گذاشتن ناحیه */
+void Integrity_Forget(IntegrityRegion_t region)
+{
+    Integrity_Abort(region);
+    regions[region].watched = 0;
+    regions[region].pending = 0;
+    regions[region].status = INTEGRITY_UNKNOWN;
+}
+
+/* ================================================
+ * برش‌ها
+ * ================================================ */
+static int8_t Integrity_Next(void)
+{
+    uint32_t now = HAL_GetTick();
+
+    for (uint8_t i = 0; i < INTEGRITY_REGIONS; i++) {
+        if (regions[i].watched && regions[i].pending) {
+            return (int8_t)i;
+        }
+    }
+    for (uint8_t i = 0; i < INTEGRITY_REGIONS; i++) {
+        if (regions[i].watched && now - regions[i].lastCheck >= INTEGRITY_RECHECK_MS) {
+            return (int8_t)i;
+        }
+    }
+    return -1;
+}
+
+static void Integrity_Finish(IntegrityRegionState_t *r, uint32_t crc)
+{
+    r->lastCheck = HAL_GetTick();
+    r->pending = 0;
+    stats.checks++;
+    if (crc == r->expected) {
+        r->status = INTEGRITY_OK;
+        return;
+    }
+    if (r->status != INTEGRITY_CORRUPT) {
+        EventLog_Append(EVENTLOG_INTEGRITY, (uint8_t)(r - regions), crc);
+    }
+    r->status = INTEGRITY_CORRUPT;
+    stats.mismatches++;
+}
+
+/* نتیجه برش قبلی را برمی‌دارد و برش بعدی را شروع می‌کند؛ هرگز منتظر DMA نمی‌ماند */
+void Integrity_Task(void)
+{
+    uint32_t start = Timing_GetCycles();
+
+    if (Crc_IsBusy()) {
+        return;
+    }
+
+    if (job >= 0 && jobSlice > 0) {
+        IntegrityRegionState_t *r = &regions[job];
+        if (Crc_LastFailed() || Crc_Transfers() != jobTransfer) {
+            stats.restarts++;
+            jobDone = 0;
+        } else {
+            jobDone += jobSlice;
+            stats.slices++;
+            stats.bytes += jobSlice * 4U;
+            stats.dmaCycles += Crc_LastCycles();
+            if (jobDone >= r->words) {
+                Integrity_Finish(r, Crc_Value());
+                job = -1;
+            }
+        }
+        jobSlice = 0;
+    }
+
+    if (job < 0) {
+        job = Integrity_Next();
+        jobDone = 0;
+        if (job < 0) {
+            return;
+        }
+        if (regions[job].words == 0) {
+            Integrity_Finish(&regions[job], CRC_INITIAL);
+            job = -1;
+            return;
+        }
+    }
+
+    /* آرایه‌ای که کلمه jobDone در آن است؛ آرایه‌های خالی رد می‌شوند */
+    const IntegritySpan_t *span = regions[job].spans;
+    uint32_t offset = jobDone;
+    while (offset >= span->length / 4U) {
+        offset -= span->length / 4U;
+        span++;
+    }
+    uint32_t slice = span->length / 4U - offset;
+    if (slice > INTEGRITY_SLICE_WORDS) {
+        slice = INTEGRITY_SLICE_WORDS;
+    }
+    if (Crc_Start((uintptr_t)span->data + offset * 4U, slice, jobDone == 0)) {
+        jobSlice = slice;
+        jobTransfer = Crc_Transfers();
+    }
+
+    uint32_t cycles = Timing_ElapsedCycles(start);
+    if (cycles > stats.maxTaskCycles) {
+        stats.maxTaskCycles = cycles;
+    }
+}
+
+/* DMA در جریان نیست (Stop کلاک DMA را هم متوقف می‌کند) و ناحیه‌ای نیمه‌کاره
+ * یا موعدرسیده نمانده؛ بررسی دوره‌ای که در Stop موعدش رسیده در بیداری بعدی
+ * انجام می‌شود */
+uint8_t Integrity_IsIdle(void)
+{
+    return !Crc_IsBusy() && job < 0 && Integrity_Next() < 0;
+}
+
+IntegrityStatus_t Integrity_GetStatus(IntegrityRegion_t region)
+{
+    return regions[region].status;
+}
+
+/* سرعت اندازه‌گیری‌شده DMA + CRC در برش‌های پس‌زمینه */
+uint32_t Integrity_ThroughputKBps(void)
+{
+    if (stats.dmaCycles == 0) {
+        return 0;
+    }
+    return (uint32_t)(stats.bytes * Timing_CyclesPerUs() * 1000000ULL / stats.dmaCycles / 1024U);
+}
+
+void Integrity_GetStats(IntegrityStats_t *out)
+{
+    *out = stats;
+}
@@ -0,0 +1,258 @@
+/* =================================================================
+ * درایور کیپد 4x4 - پیاده‌سازی
+ *
+ * ماشین حالت هر کلید:
+ *   IDLE -> PRESS_DEBOUNCE -> PRESSED -> RELEASE_DEBOUNCE -> IDLE
+ * در حالت PRESSED بعد از KEYPAD_LONGPRESS_MS رویداد LONGPRESS و
+ * سپس هر KEYPAD_REPEAT_MS یک رویداد REPEAT تولید می‌شود.
+ * ================================================================= */
+
+#include "keypad.h"
+#include "timing.h"
+#include "bench.h"
+#include "profile.h"
+
+typedef enum {
+    KEY_STATE_IDLE,
+    KEY_STATE_PRESS_DEBOUNCE,
+    KEY_STATE_PRESSED,
+    KEY_STATE_RELEASE_DEBOUNCE
+} KeyState_t;
+
+typedef struct {
+    KeyState_t state;
+    uint8_t count;          /* نمونه‌های پایدار متوالی */
+    uint32_t pressTime;
+    uint32_t nextRepeat;
+    uint8_t longSent;
+} KeyDebounce_t;
+
+/* کیپد Calculator layout */
+static const char keypadLayout[4][4] = {
+    {'1', '2', '3', '+'},
+    {'4', '5', '6', '-'},
+    {'7', '8', '9', '*'},
+    {'C', '0', '=', '/'}
+};
+
+static const uint16_t rowPins[4] = {KEYPAD_ROW1_Pin, KEYPAD_ROW2_Pin, KEYPAD_ROW3_Pin, KEYPAD_ROW4_Pin};
+static const uint16_t colPins[4] = {KEYPAD_COL1_Pin, KEYPAD_COL2_Pin, KEYPAD_COL3_Pin, KEYPAD_COL4_Pin};
+
+static KeyDebounce_t keys[16];
+static uint8_t activeKeys = 0;      /* تعداد کلیدهایی که IDLE نیستند */
+
+static KeyEvent_t eventQueue[KEYPAD_QUEUE_SIZE];
+static volatile uint8_t queueHead = 0;
+static volatile uint8_t queueTail = 0;
+static uint32_t droppedEvents = 0;
+
+static volatile uint8_t keypadIrqPending = 0;
+
+static void Keypad_ArmInterrupt(void);
+
+static void Keypad_PushEvent(uint8_t index, KeyEventType_t type, uint32_t now)
+{
+    uint8_t next = (queueHead + 1) & (KEYPAD_QUEUE_SIZE - 1);
+    if (next == queueTail) {
+        droppedEvents++; // صف پر است؛ رویداد جدید دور ریخته می‌شود
+        return;
+    }
+    eventQueue[queueHead].key = keypadLayout[index >> 2][index & 3];
+    eventQueue[queueHead].type = type;
+    eventQueue[queueHead].timestamp = now;
+    queueHead = next;
+}
+
+void Keypad_Init(void)
+{
+    for (int i = 0; i < 16; i++) {
+        keys[i].state = KEY_STATE_IDLE;
+        keys[i].count = 0;
+    }
+    activeKeys = 0;
+    queueHead = queueTail = 0;
+
+#if KEYPAD_USE_EXTI
+    Keypad_ArmInterrupt();
+#else
+    HAL_GPIO_WritePin(GPIOC, KEYPAD_COL_PINS, GPIO_PIN_SET);
+#endif
+}
+
+/* یک بار خواندن کامل ماتریس؛ بیت (row*4 + col) = کلید پایین است */
+static uint16_t Keypad_ReadMatrix(void)
+{
+    uint16_t pressed = 0;
+
+    for (int col = 0; col < 4; col++) {
+        /* فقط ستون جاری LOW */
+        HAL_GPIO_WritePin(GPIOC, KEYPAD_COL_PINS, GPIO_PIN_SET);
+        HAL_GPIO_WritePin(GPIOC, colPins[col], GPIO_PIN_RESET);
+
+        delay_us(KEYPAD_SETTLE_US); // زمان نشست خطوط
+
+        uint32_t idr = GPIOC->IDR;
+        for (int row = 0; row < 4; row++) {
+            if ((idr & rowPins[row]) == 0) {
+                pressed |= (uint16_t)(1u << (row * 4 + col));
+            }
+        }
+    }
+
+#if KEYPAD_USE_EXTI
+    HAL_GPIO_WritePin(GPIOC, KEYPAD_COL_PINS, GPIO_PIN_RESET);
+#else
+    HAL_GPIO_WritePin(GPIOC, KEYPAD_COL_PINS, GPIO_PIN_SET);
+#endif
+    return pressed;
+}
+
+static void Keypad_UpdateKey(uint8_t index, uint8_t isDown, uint32_t now)
+{
+    KeyDebounce_t *k = &keys[index];
+
+    switch (k->state) {
+        case KEY_STATE_IDLE:
+            if (isDown) {
+                k->state = KEY_STATE_PRESS_DEBOUNCE;
+                k->count = 1;
+                activeKeys++;
+#if !KEYPAD_USE_EXTI
+                BENCH_STIMULUS(BENCH_SRC_KEY);
+#endif
+            }
+            break;
+
+        case KEY_STATE_PRESS_DEBOUNCE:
+            if (!isDown) {
+                k->state = KEY_STATE_IDLE; // نویز
+                activeKeys--;
+            } else if (++k->count >= KEYPAD_DEBOUNCE_SAMPLES) {
+                k->state = KEY_STATE_PRESSED;
+                k->pressTime = now;
+                k->longSent = 0;
+                Keypad_PushEvent(index, KEY_EVENT_PRESS, now);
+            }
+            break;
+
+        case KEY_STATE_PRESSED:
+            if (!isDown) {
+                k->state = KEY_STATE_RELEASE_DEBOUNCE;
+                k->count = 1;
+            } else if (!k->longSent) {
+                if (now - k->pressTime >= KEYPAD_LONGPRESS_MS) {
+                    k->longSent = 1;
+                    k->nextRepeat = now + KEYPAD_REPEAT_MS;
+                    Keypad_PushEvent(index, KEY_EVENT_LONGPRESS, now);
+                }
+            } else if ((int32_t)(now - k->nextRepeat) >= 0) {
+                k->nextRepeat += KEYPAD_REPEAT_MS;
+                Keypad_PushEvent(index, KEY_EVENT_REPEAT, now);
+            }
+            break;
+
+        case KEY_STATE_RELEASE_DEBOUNCE:
+            if (isDown) {
+                k->state = KEY_STATE_PRESSED; // لرزش هنگام رها کردن
+            } else if (++k->count >= KEYPAD_DEBOUNCE_SAMPLES) {
+                k->state = KEY_STATE_IDLE;
+                activeKeys--;
+                Keypad_PushEvent(index, KEY_EVENT_RELEASE, now);
+            }
+            break;
+    }
+}
+
+/* از تسک دوره‌ای زمان‌بند صدا زده می‌شود */
+void Keypad_Sample(void)
+{
+#if KEYPAD_USE_EXTI
+    /* بی‌کار و بدون وقفه ردیف: اسکنی لازم نیست */
+    if (activeKeys == 0 && !keypadIrqPending) {
+        return;
+    }
+    keypadIrqPending = 0;
+#endif
+
+    PROFILE_BEGIN();
+    uint32_t now = HAL_GetTick();
+    uint16_t pressed = Keypad_ReadMatrix();
+
+    for (uint8_t i = 0; i < 16; i++) {
+        uint8_t isDown = (pressed >> i) & 1u;
+        if (isDown || keys[i].state != KEY_STATE_IDLE) {
+            Keypad_UpdateKey(i, isDown, now);
+        }
+    }
+
+#if KEYPAD_USE_EXTI
+    if (activeKeys == 0) {
+        Keypad_ArmInterrupt();
+    }
+#endif
+    PROFILE_END(PROF_KEYPAD_SAMPLE);
+}
+
+uint8_t Keypad_GetEvent(KeyEvent_t *event)
+{
+    if (queueTail == queueHead) {
+        return 0;
+    }
+    *event = eventQueue[queueTail];
+    queueTail = (queueTail + 1) & (KEYPAD_QUEUE_SIZE - 1);
+    return 1;
+}
+
+/* کلید بعدی که فشرده شده؛ سایر رویدادها دور ریخته می‌شوند. هرگز block نمی‌کند */
+char Keypad_GetKey(void)
+{
+    KeyEvent_t event;
+    char key = 0; // هیچ دکمه‌ای فشرده نشده
+
+    PROFILE_BEGIN();
+    while (Keypad_GetEvent(&event)) {
+        if (event.type == KEY_EVENT_PRESS) {
+            key = event.key;
+            break;
+        }
+    }
+    PROFILE_END(PROF_KEYPAD_GETKEY);
+    return key;
+}
+
+uint8_t Keypad_IsIdle(void)
+{
+    return (activeKeys == 0) && !keypadIrqPending && (queueHead == queueTail);
+}
+
+uint32_t Keypad_GetDroppedEvents(void)
+{
+    return droppedEvents;
+}
+
+/* همه ستون‌ها LOW: فشردن هر کلید یک لبه پایین‌رونده روی ردیف‌ها می‌سازد */
+static void Keypad_ArmInterrupt(void)
+{
+    HAL_GPIO_WritePin(GPIOC, KEYPAD_COL_PINS, GPIO_PIN_RESET);
+
+    /* لبه‌های ایجاد شده در حین اسکن را دور بریز */
+    __HAL_GPIO_EXTI_CLEAR_IT(KEYPAD_ROW_PINS);
+    keypadIrqPending = 0;
+
+    /* اگر کلیدی همین حالا پایین است، لبه‌اش را از دست نده */
+    if ((GPIOC->IDR & KEYPAD_ROW_PINS) != KEYPAD_ROW_PINS) {
+        keypadIrqPending = 1;
+    }
+}
+
+/* از HAL_GPIO_EXTI_Callback صدا زده می‌شود */
+void Keypad_RowInterrupt(uint16_t GPIO_Pin)
+{
+    if (GPIO_Pin & KEYPAD_ROW_PINS) {
+        /* فقط لبه شروع فشردن؛ لبه‌های حین اسکن زمان‌مهر را عوض نمی‌کنند */
+        if (activeKeys == 0 && !keypadIrqPending) {
+            BENCH_STIMULUS(BENCH_SRC_KEY);
+        }
+        keypadIrqPending = 1;
+    }
+}
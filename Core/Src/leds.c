@@ -0,0 +1,143 @@
+/* =================================================================
+ * موتور الگوی LED - پیاده‌سازی
+ *
+ * Leds_Tick هر 1ms از SysTick_Handler صدا زده می‌شود. پین‌ها فقط وقتی
+ * ماسک عوض شود نوشته می‌شوند، پس هزینه وقفه در حالت ثابت چند دستور است.
+ * ================================================================= */
+
+#include "leds.h"
+
+typedef struct {
+    const LedPattern_t *pattern;
+    uint8_t step;
+    uint8_t playsLeft;
+    uint16_t remaining;     /* ms باقی‌مانده از گام جاری؛ 0 = ثابت */
+} LedPlayer_t;
+
+static LedStep_t fixedStep;
+static const LedPattern_t fixedPattern = {&fixedStep, 1, 0};
+
+static LedPlayer_t base;
+static LedPlayer_t overlay;
+static volatile uint8_t overlayActive = 0;
+static uint8_t outputMask = 0xFF;   /* اولین نوشتن را اجباری می‌کند */
+
+static void Leds_Write(uint8_t mask)
+{
+    if (mask == outputMask) {
+        return;
+    }
+    outputMask = mask;
+    HAL_GPIO_WritePin(LED_GREEN_GPIO_Port, LED_GREEN_Pin, (mask & LED_MASK_GREEN) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(LED_RED1_GPIO_Port, LED_RED1_Pin, (mask & LED_MASK_RED1) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(LED_RED2_GPIO_Port, LED_RED2_Pin, (mask & LED_MASK_RED2) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+static void Leds_Start(LedPlayer_t *player, const LedPattern_t *pattern)
+{
+    player->pattern = pattern;
+    player->step = 0;
+    player->playsLeft = (pattern->repeat > 0) ? pattern->repeat : 1;
+    player->remaining = pattern->steps[0].duration;
+}
+
+/* یک ms جلو می‌رود؛ اگر overlay تمام شود 1 برمی‌گرداند */
+static uint8_t Leds_Advance(LedPlayer_t *player, uint8_t isOverlay)
+{
+    if (player->remaining == 0 || --player->remaining > 0) {
+        return 0;
+    }
+
+    if (++player->step >= player->pattern->count) {
+        player->step = 0;
+        if (isOverlay && --player->playsLeft == 0) {
+            return 1;
+        }
+    }
+    player->remaining = player->pattern->steps[player->step].duration;
+    return 0;
+}
+
+void Leds_Init(void)
+{
+    overlayActive = 0;
+    Leds_SetMask(0);
+}
+
+/* الگوی پایه؛ overlay در حال پخش قطع نمی‌شود */
+void Leds_SetPattern(const LedPattern_t *pattern)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    if (pattern == NULL || pattern->count == 0) {
+        return;
+    }
+
+    __disable_irq();
+    Leds_Start(&base, pattern);
+    if (!overlayActive) {
+        Leds_Write(pattern->steps[0].mask);
+    }
+    __set_PRIMASK(primask);
+}
+
+void Leds_PlayOverlay(const LedPattern_t *pattern)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    if (pattern == NULL || pattern->count == 0) {
+        return;
+    }
+
+    __disable_irq();
+    Leds_Start(&overlay, pattern);
+    overlayActive = 1;
+    Leds_Write(pattern->steps[0].mask);
+    __set_PRIMASK(primask);
+}
+
+/* ماسک ثابت به عنوان الگوی پایه (جایگزین کنترل مستقیم پین‌ها) */
+void Leds_SetMask(uint8_t mask)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    fixedStep.mask = mask;
+    fixedStep.duration = 0;
+    overlayActive = 0;
+    Leds_Start(&base, &fixedPattern);
+    Leds_Write(mask);
+    __set_PRIMASK(primask);
+}
+
+uint8_t Leds_GetMask(void)
+{
+    return outputMask;
+}
+
+/* الگوی ثابت به تیک نیاز ندارد (مثلاً برای Stop mode) */
+uint8_t Leds_IsAnimating(void)
+{
+    return overlayActive || (base.pattern != NULL && base.remaining != 0);
+}
+
+/* از SysTick_Handler صدا زده می‌شود (هر 1ms) */
+void Leds_Tick(void)
+{
+    if (base.pattern == NULL) {
+        return;
+    }
+
+    /* الگوی پایه زیر overlay هم جلو می‌رود تا بعد از آن هم‌فاز بماند */
+    Leds_Advance(&base, 0);
+
+    if (overlayActive) {
+        if (Leds_Advance(&overlay, 1)) {
+            overlayActive = 0;
+        } else {
+            Leds_Write(overlay.pattern->steps[overlay.step].mask);
+            return;
+        }
+    }
+    Leds_Write(base.pattern->steps[base.step].mask);
+}
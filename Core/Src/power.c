@@ -0,0 +1,262 @@
+/* =================================================================
+ * مدیریت توان - پیاده‌سازی
+ *
+ * خطوط EXTI0-3 یا به PC0-3 (ردیف‌های کیپد) وصل می‌شوند یا به PB0-3
+ * (کارت‌ها و PIR)، نه هر دو. کیپد EXTI را نگه می‌دارد و حسگرها با
+ * wakeup دوره‌ای RTC خوانده می‌شوند.
+ *
+ * زمان خواب از ثانیه و زیرثانیه تقویم RTC (دقت 0.5ms) اندازه‌گیری
+ * می‌شود، چون شمارنده wakeup قابل خواندن نیست و ممکن است EXTI زودتر
+ * بیدار کند. دقت جبران به دقت LSI وابسته است.
+ * ================================================================= */
+
+#include "power.h"
+#include "scheduler.h"
+#include "keypad.h"
+#include "hd44780.h"
+#include "buzzer.h"
+#include "leds.h"
+#include "security.h"
+#include "timing.h"
+#include "profile.h"
+#include "eventlog.h"
+#include "eeprom.h"
+#include "config.h"
+#include "integrity.h"
+
+#define RTC_ASYNC_PREDIV    15                                      /* LSI/16 = 2kHz */
+#define RTC_TICKS_PER_SEC   (POWER_LSI_HZ / (RTC_ASYNC_PREDIV + 1))
+#define RTC_SYNC_PREDIV     (RTC_TICKS_PER_SEC - 1)                 /* 1Hz برای تقویم */
+#define RTC_TICKS_PER_MS    (RTC_TICKS_PER_SEC / 1000)
+#define RTC_EXTI_LINE       (1UL << 22)
+#define HSI_CYCLES_PER_US   (HSI_VALUE / 1000000U)
+
+static PowerStats_t stats;
+static uint8_t rtcReady = 0;
+static volatile uint8_t wakePending = 0;
+static uint32_t wakeCycles = 0;         /* CYCCNT لحظه بیدار شدن */
+static uint32_t restoreCycles = 0;      /* CYCCNT بعد از بازیابی PLL */
+
+static void Power_RtcUnlock(void)
+{
+    RTC->WPR = 0xCA;
+    RTC->WPR = 0x53;
+}
+
+static void Power_RtcLock(void)
+{
+    RTC->WPR = 0xFF;
+}
+
+void Power_Init(void)
+{
+    __HAL_RCC_PWR_CLK_ENABLE();
+
+    /* LSI برای RTC */
+    RCC->CSR |= RCC_CSR_LSION;
+    while (!(RCC->CSR & RCC_CSR_LSIRDY)) {
+    }
+
+    PWR->CR |= PWR_CR_DBP;
+    if ((RCC->BDCR & RCC_BDCR_RTCSEL) != RCC_BDCR_RTCSEL_1) {
+        RCC->BDCR |= RCC_BDCR_BDRST;
+        RCC->BDCR &= ~RCC_BDCR_BDRST;
+        RCC->BDCR |= RCC_BDCR_RTCSEL_1;     /* RTCCLK = LSI */
+    }
+    RCC->BDCR |= RCC_BDCR_RTCEN;
+
+    Power_RtcUnlock();
+
+    /* تقویم: پیش‌تقسیم‌ها برای دقت 0.5ms زیرثانیه */
+    RTC->ISR |= RTC_ISR_INIT;
+    while (!(RTC->ISR & RTC_ISR_INITF)) {
+    }
+    RTC->PRER = RTC_SYNC_PREDIV;
+    RTC->PRER |= (uint32_t)RTC_ASYNC_PREDIV << RTC_PRER_PREDIV_A_Pos;
+    RTC->TR = 0;
+    RTC->CR = RTC_CR_BYPSHAD;           /* خواندن مستقیم بعد از بیدار شدن، بدون انتظار RSF */
+    RTC->ISR &= ~RTC_ISR_INIT;
+
+    /* wakeup timer با RTCCLK/16 */
+    RTC->CR &= ~RTC_CR_WUTE;
+    while (!(RTC->ISR & RTC_ISR_WUTWF)) {
+    }
+    RTC->CR &= ~RTC_CR_WUCKSEL;
+    RTC->CR |= RTC_CR_WUTIE;
+    RTC->ISR &= ~RTC_ISR_WUTF;
+
+    Power_RtcLock();
+
+    /* RTC wakeup روی EXTI line 22 (لبه بالارونده) */
+    EXTI->IMR |= RTC_EXTI_LINE;
+    EXTI->RTSR |= RTC_EXTI_LINE;
+    EXTI->PR = RTC_EXTI_LINE;
+    HAL_NVIC_SetPriority(RTC_WKUP_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(RTC_WKUP_IRQn);
+
+    rtcReady = 1;
+}
+
+/* زمان RTC در واحد تیک 0.5ms داخل یک ساعت */
+static uint32_t Power_RtcNow(void)
+{
+    uint32_t ssr, tr;
+
+    /* با BYPSHAD دو بار بخوان تا مقدار سازگار بگیری */
+    do {
+        ssr = RTC->SSR;
+        tr = RTC->TR;
+    } while (ssr != RTC->SSR);
+
+    uint32_t seconds = ((tr >> 4) & 0x7) * 10 + (tr & 0xF)
+                     + (((tr >> 12) & 0x7) * 10 + ((tr >> 8) & 0xF)) * 60;
+    return seconds * RTC_TICKS_PER_SEC + (RTC_SYNC_PREDIV - ssr);
+}
+
+static void Power_StartWakeupTimer(uint32_t ms)
+{
+    Power_RtcUnlock();
+    RTC->CR &= ~RTC_CR_WUTE;
+    while (!(RTC->ISR & RTC_ISR_WUTWF)) {
+    }
+    RTC->WUTR = ms * RTC_TICKS_PER_MS - 1U;
+    RTC->ISR &= ~RTC_ISR_WUTF;
+    RTC->CR |= RTC_CR_WUTE;
+    Power_RtcLock();
+    EXTI->PR = RTC_EXTI_LINE;
+}
+
+static void Power_StopWakeupTimer(void)
+{
+    Power_RtcUnlock();
+    RTC->CR &= ~RTC_CR_WUTE;
+    RTC->ISR &= ~RTC_ISR_WUTF;
+    Power_RtcLock();
+    EXTI->PR = RTC_EXTI_LINE;
+}
+
+/* بعد از Stop سیستم با HSI کار می‌کند؛ HSE و PLL (تنظیمات حفظ شده) دوباره روشن می‌شوند */
+static void Power_RestoreClocks(void)
+{
+    RCC->CR |= RCC_CR_HSEON;
+    while (!(RCC->CR & RCC_CR_HSERDY)) {
+    }
+    RCC->CR |= RCC_CR_PLLON;
+    while (!(RCC->CR & RCC_CR_PLLRDY)) {
+    }
+    RCC->CFGR = (RCC->CFGR & ~RCC_CFGR_SW) | RCC_CFGR_SW_PLL;
+    while ((RCC->CFGR & RCC_CFGR_SWS) != RCC_CFGR_SWS_PLL) {
+    }
+}
+
+/* Stop فقط وقتی که هیچ ماژولی کار زمان‌دار در جریان ندارد */
+static uint8_t Power_CanStop(void)
+{
+    return Keypad_IsIdle()
+        && !LCD_IsDirty() && !LCD_IsBusy()
+        && !Buzzer_IsBusy()
+        && !Leds_IsAnimating()
+        && Security_IsIdle()
+        && Profile_IsIdle()
+        && EventLog_IsIdle()           // رکوردهای RAM بیشتر از EVENTLOG_FLUSH_MS منتظر نمی‌مانند
+        && Eeprom_IsIdle()
+        && Config_IsIdle()
+        && Integrity_IsIdle();
+}
+
+/* با وقفه‌های بسته صدا زده می‌شود؛ وقفه در انتظار WFI را بیدار می‌کند و بعد از
+ * برگرداندن کلاک و جبران زمان اجرا می‌شود */
+static void Power_EnterStop(uint32_t ms)
+{
+    uint32_t before = Power_RtcNow();
+
+    HAL_SuspendTick();
+    Power_StartWakeupTimer(ms);
+
+    /* Stop با رگولاتور کم‌مصرف */
+    PWR->CR &= ~PWR_CR_PDDS;
+    PWR->CR |= PWR_CR_LPDS;
+    SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+    __WFI();
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+
+    wakeCycles = DWT->CYCCNT;
+    Power_RestoreClocks();
+    restoreCycles = DWT->CYCCNT;
+
+    Power_StopWakeupTimer();
+
+    /* جبران زمان خواب */
+    uint32_t sleptTicks = (Power_RtcNow() - before + 3600U * RTC_TICKS_PER_SEC) % (3600U * RTC_TICKS_PER_SEC);
+    uint32_t sleptMs = sleptTicks / RTC_TICKS_PER_MS;
+    uwTick += sleptMs;
+    Timing_AddSleep(sleptMs * 1000U);
+    HAL_ResumeTick();
+    __enable_irq();
+
+    stats.stopCount++;
+    stats.stopTimeMs += sleptMs;
+    stats.lastRestoreUs = (restoreCycles - wakeCycles) / HSI_CYCLES_PER_US;
+    wakePending = 1;
+
+    /* تسک‌های دوره‌ای بلافاصله اجرا شوند، بدون ثبت تأخیر */
+    Scheduler_Resume();
+}
+
+void Scheduler_Idle(uint32_t timeToNext)
+{
+    if (timeToNext == 0) {
+        return;
+    }
+
+    /* بین بررسی بیکاری و WFI وقفه‌ای (EXTI کیپد، TIM3، SysTick) نباید کاری
+     * بسازد که تا بیدار شدن RTC منتظر بماند: وقفه‌ها تا بعد از WFI بسته‌اند.
+     * وقفه در انتظار با PRIMASK=1 هم WFI را بیدار می‌کند. */
+    __disable_irq();
+#if POWER_USE_STOP
+    if (rtcReady && Power_CanStop()) {
+        uint32_t budget = Security_NeedsSensors() ? POWER_SENSOR_POLL_MS : POWER_STOP_MAX_MS;
+        uint32_t oneShot = Scheduler_TimeToNextOneShot();
+        if (oneShot < budget) {
+            budget = oneShot;
+        }
+        if (budget >= POWER_STOP_MIN_MS) {
+            Power_EnterStop(budget);
+            return;
+        }
+    }
+#endif
+
+    stats.sleepCount++;
+    __WFI();
+    __enable_irq();
+}
+
+/* اولین تسکی که بعد از Stop ورودی را پردازش می‌کند صدا می‌زند */
+void Power_WakeHandled(void)
+{
+    if (!wakePending) {
+        return;
+    }
+    wakePending = 0;
+
+    uint32_t latency = stats.lastRestoreUs + Timing_ElapsedUs(restoreCycles);
+    stats.lastWakeLatencyUs = latency;
+    if (latency > stats.maxWakeLatencyUs) {
+        stats.maxWakeLatencyUs = latency;
+    }
+}
+
+const PowerStats_t* Power_GetStats(void)
+{
+    return &stats;
+}
+
+/* از RTC_WKUP_IRQHandler صدا زده می‌شود */
+void Power_RtcWakeupIRQHandler(void)
+{
+    Power_RtcUnlock();
+    RTC->ISR &= ~RTC_ISR_WUTF;
+    Power_RtcLock();
+    EXTI->PR = RTC_EXTI_LINE;
+}
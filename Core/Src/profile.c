@@ -0,0 +1,190 @@
+/* =================================================================
+ * پروفایلر سیکلی - پیاده‌سازی
+ *
+ * هر شناسه فقط از یک زمینه (یک تسک یا یک وقفه) به‌روز می‌شود، پس
+ * Profile_Record قفل ندارد؛ خواننده جدول کپی را با وقفه‌های بسته می‌گیرد.
+ *
+ * قالب گزارش (یک خط برای هر شناسه، عددها دهدهی):
+ *   prof t=<HAL_GetTick>
+ *   <نام> <تعداد> <مجموع سیکل> <بیشترین سیکل>
+ * ================================================================= */
+
+#include "profile.h"
+
+static const char* const profileNames[PROF_COUNT] = {
+    [PROF_KEYPAD_SAMPLE]    = "Keypad_Sample",
+    [PROF_KEYPAD_GETKEY]    = "Keypad_GetKey",
+    [PROF_LCD_SEND_DATA]    = "LCD_SendData",
+    [PROF_LCD_FLUSH]        = "LCD_FlushStep",
+    [PROF_SECURITY_SENSORS] = "Sec_Sensors",
+    [PROF_SECURITY_EVENTS]  = "Sec_Events",
+    [PROF_CARDS_LOOKUP]     = "Cards_Lookup",
+    [PROF_ISR_SYSTICK]      = "ISR_SysTick",
+    [PROF_ISR_EXTI]         = "ISR_EXTI",
+    [PROF_ISR_TIM3]         = "ISR_TIM3",
+    [PROF_ISR_RTC]          = "ISR_RTC",
+    [PROF_ISR_DMA]          = "ISR_DMA",
+};
+
+static ProfileEntry_t table[PROF_COUNT];
+static uint32_t overheadCycles = 0;     /* هزینه خود جفت BEGIN/END */
+
+static uint8_t reporting = 0;
+static uint32_t nextReport = 0;
+static uint8_t reportLine = 0;
+static char line[64];
+static uint8_t lineLen = 0;
+static uint8_t linePos = 0;
+
+/* بعد از Timing_Init (شمارنده سیکل باید روشن باشد) */
+void Profile_Init(void)
+{
+    uint32_t start = DWT->CYCCNT;
+    uint32_t end = DWT->CYCCNT;
+    overheadCycles = end - start;
+
+    Profile_Reset();
+    reporting = 0;
+    nextReport = HAL_GetTick() + PROFILE_REPORT_MS;
+}
+
+void Profile_Reset(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    for (int i = 0; i < PROF_COUNT; i++) {
+        table[i].calls = 0;
+        table[i].totalCycles = 0;
+        table[i].maxCycles = 0;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+void Profile_Record(ProfileId_t id, uint32_t cycles)
+{
+    ProfileEntry_t *e = &table[id];
+
+    cycles = (cycles > overheadCycles) ? cycles - overheadCycles : 0;
+    e->calls++;
+    e->totalCycles += cycles;
+    if (cycles > e->maxCycles) {
+        e->maxCycles = cycles;
+    }
+}
+
+uint8_t Profile_Get(ProfileId_t id, ProfileEntry_t *entry)
+{
+    if (id >= PROF_COUNT) {
+        return 0;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *entry = table[id];
+    __set_PRIMASK(primask);
+    return 1;
+}
+
+/* ================================================
+ * قالب‌بندی خط‌ها بدون printf
+ * ================================================ */
+static void Profile_Append(const char *str)
+{
+    while (*str && lineLen < sizeof(line) - 1) {
+        line[lineLen++] = *str++;
+    }
+}
+
+static void Profile_AppendNumber(uint64_t value)
+{
+    char digits[21];
+    uint8_t n = 0;
+
+    do {
+        digits[n++] = (char)('0' + value % 10U);
+        value /= 10U;
+    } while (value > 0);
+
+    while (n > 0 && lineLen < sizeof(line) - 1) {
+        line[lineLen++] = digits[--n];
+    }
+}
+
+/* خط شماره index گزارش را می‌سازد؛ 0 یعنی گزارش تمام شده */
+static uint8_t Profile_FormatLine(uint8_t index)
+{
+    lineLen = 0;
+    linePos = 0;
+
+    if (index == 0) {
+        Profile_Append("prof t=");
+        Profile_AppendNumber(HAL_GetTick());
+    } else if (index <= PROF_COUNT) {
+        ProfileEntry_t entry;
+        Profile_Get((ProfileId_t)(index - 1), &entry);
+        Profile_Append(profileNames[index - 1]);
+        Profile_Append(" ");
+        Profile_AppendNumber(entry.calls);
+        Profile_Append(" ");
+        Profile_AppendNumber(entry.totalCycles);
+        Profile_Append(" ");
+        Profile_AppendNumber(entry.maxCycles);
+    } else {
+        return 0;
+    }
+
+    Profile_Append("\n");
+    return 1;
+}
+
+/* ================================================
+ * ارسال روی ITM
+ * ================================================ */
+static uint8_t Profile_ItmEnabled(void)
+{
+    return (ITM->TCR & ITM_TCR_ITMENA_Msk) && (ITM->TER & (1UL << PROFILE_ITM_PORT));
+}
+
+/* تسک دوره‌ای: هرگز منتظر FIFO نمی‌ماند */
+void Profile_Task(void)
+{
+    if (!reporting) {
+        uint32_t now = HAL_GetTick();
+        if ((int32_t)(now - nextReport) < 0) {
+            return;
+        }
+        nextReport += PROFILE_REPORT_MS;
+        if ((int32_t)(now - nextReport) >= 0) {
+            nextReport = now + PROFILE_REPORT_MS; // بعد از خواب طولانی
+        }
+        if (!Profile_ItmEnabled()) {
+            return; // دیباگر SWO را باز نکرده
+        }
+        reporting = 1;
+        reportLine = 0;
+        lineLen = linePos = 0;
+    }
+
+    for (uint8_t budget = PROFILE_TX_BUDGET; budget > 0; budget--) {
+        if (linePos == lineLen && !Profile_FormatLine(reportLine++)) {
+            reporting = 0;
+            return;
+        }
+        if (!Profile_ItmEnabled()) {
+            reporting = 0;
+            return;
+        }
+        if (ITM->PORT[PROFILE_ITM_PORT].u32 == 0) {
+            return; // FIFO پر است؛ ادامه در اجرای بعدی
+        }
+        ITM->PORT[PROFILE_ITM_PORT].u8 = (uint8_t)line[linePos++];
+    }
+}
+
+/* گزارش نیمه‌کاره نباید با Stop قطع شود (SWO در Stop خاموش است) */
+uint8_t Profile_IsIdle(void)
+{
+    return !reporting;
+}
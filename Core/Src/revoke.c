@@ -0,0 +1,91 @@
+/* =================================================================
+ * کارت‌های باطل‌شده - فیلتر Bloom و فهرست مرتب
+ *
+ * h = SipHash(کلید جدول، طول | UID)، h1 = 32 بیت پایین، h2 = 32 بیت بالا | 1
+ * بیت i ام = (h1 + i * h2) در بازه [0، m)، برای i < k
+ * ================================================================= */
+
+#include "revoke.h"
+#include <string.h>
+
+static RevokeStats_t revokeStats;
+static const RevokeTable_t *activeTable = &revokeTable;
+
+uint8_t Revoke_FilterMayContain(const RevokeTable_t *table, const CardUid_t *uid)
+{
+    if (table->filterBits == 0) {
+        return 0;
+    }
+
+    uint64_t h = Cards_Hash(table->key, uid);
+    uint32_t h1 = (uint32_t)h;
+    uint32_t h2 = (uint32_t)(h >> 32) | 1U;
+
+    for (uint8_t i = 0; i < table->hashCount; i++) {
+        uint32_t bit = (uint32_t)(((uint64_t)h1 * table->filterBits) >> 32);
+        if ((table->filter[bit >> 5] & (1UL << (bit & 31U))) == 0) {
+            return 0;
+        }
+        h1 += h2;
+    }
+    return 1;
+}
+
+static int Revoke_Compare(const CardUid_t *a, const CardUid_t *b)
+{
+    if (a->length != b->length) {
+        return (a->length < b->length) ? -1 : 1;
+    }
+    return memcmp(a->bytes, b->bytes, a->length);
+}
+
+uint8_t Revoke_IsRevokedIn(const RevokeTable_t *table, const CardUid_t *uid, uint8_t *filterHit)
+{
+    int32_t low = 0, high = (int32_t)table->count - 1;
+
+    *filterHit = Revoke_FilterMayContain(table, uid);
+    if (!*filterHit) {
+        return 0;
+    }
+
+    while (low <= high) {
+        int32_t mid = (low + high) / 2;
+        int cmp = Revoke_Compare(&table->uids[mid], uid);
+        if (cmp == 0) {
+            return 1;
+        }
+        if (cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return 0;
+}
+
+uint8_t Revoke_IsRevoked(const CardUid_t *uid)
+{
+    uint8_t filterHit;
+    uint8_t revoked = Revoke_IsRevokedIn(activeTable, uid, &filterHit);
+
+    revokeStats.checks++;
+    revokeStats.filterHits += filterHit;
+    revokeStats.revoked += revoked;
+    return revoked;
+}
+
+/* NULL = بازگشت به جدول firmware */
+void Revoke_SetTable(const RevokeTable_t *table)
+{
+    activeTable = (table != NULL) ? table : &revokeTable;
+}
+
+void Revoke_GetStats(RevokeStats_t *stats)
+{
+    *stats = revokeStats;
+}
+
+void Revoke_ResetStats(void)
+{
+    memset(&revokeStats, 0, sizeof(revokeStats));
+}
@@ -0,0 +1,30 @@
+/* =================================================================
+ * کارت‌های باطل‌شده - تولید شده با Host/revoke_gen از revoked_demo.txt؛ دستی ویرایش نشود
+ * 3 کارت، فیلتر 32 بیت، k = 7، نرخ مثبت کاذب هدف 0.01
+ * ================================================================= */
+
+#include "revoke.h"
+
+CARDS_SECTION static const uint32_t filter[1] = {
+    0xAACC3251
+};
+
+CARDS_SECTION INTEGRITY_ALIGNED static const CardUid_t uids[4] = {
+    {4, {0x04, 0xA9, 0x71, 0x0D}},
+    {7, {0x04, 0x33, 0x8E, 0x5A, 0x01, 0xC7, 0x80}},
+    {7, {0x04, 0x6B, 0x3E, 0x91, 0xC2, 0x55, 0x80}},
+    {0, {0}},
+};
+
+CARDS_SECTION const RevokeTable_t revokeTable = {
+    {0x3C, 0xBA, 0x1C, 0xED, 0x32, 0x60, 0x06, 0xBD, 0xD0, 0x16, 0x73, 0xD6, 0xAF, 0xED, 0x98, 0xFB},
+    32, 7, filter,
+    3, uids
+};
+
+static const IntegritySpan_t spans[2] = {
+    {filter, 4},
+    {uids, 36},
+};
+
+const IntegrityImage_t revokeTableCrc = {spans, 2, 0xF7362271};
@@ -0,0 +1,188 @@
+/* =================================================================
+ * زمان‌بند همکارانه - پیاده‌سازی
+ *
+ * ترتیب ثبت تسک‌ها اولویت آن‌ها را تعیین می‌کند (اولین = بالاترین).
+ * تسک‌ها نباید block کنند؛ هر تسک تا انتها اجرا می‌شود.
+ * ================================================================= */
+
+#include "scheduler.h"
+
+static Task_t tasks[SCHEDULER_MAX_TASKS];
+
+void Scheduler_Init(void)
+{
+    for (int i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        tasks[i].active = 0;
+        tasks[i].function = NULL;
+    }
+}
+
+static uint8_t Scheduler_Insert(TaskFunction_t function, uint32_t period, uint32_t delay, uint32_t deadline)
+{
+    if (function == NULL) {
+        return SCHEDULER_INVALID_ID;
+    }
+
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        if (!tasks[i].active) {
+            tasks[i].function = function;
+            tasks[i].period = period;
+            tasks[i].deadline = deadline;
+            tasks[i].nextRun = HAL_GetTick() + delay;
+            tasks[i].runCount = 0;
+            tasks[i].deadlineMisses = 0;
+            tasks[i].maxLateness = 0;
+            tasks[i].active = 1;
+            return i;
+        }
+    }
+    return SCHEDULER_INVALID_ID; // جدول پر است
+}
+
+uint8_t Scheduler_AddTask(TaskFunction_t function, uint32_t period, uint32_t offset, uint32_t deadline)
+{
+    if (period == 0) {
+        return SCHEDULER_INVALID_ID;
+    }
+    return Scheduler_Insert(function, period, offset, deadline);
+}
+
+uint8_t Scheduler_AddOneShot(TaskFunction_t function, uint32_t delay, uint32_t deadline)
+{
+    return Scheduler_Insert(function, 0, delay, deadline);
+}
+
+void Scheduler_RemoveTask(uint8_t id)
+{
+    if (id < SCHEDULER_MAX_TASKS) {
+        tasks[id].active = 0;
+    }
+}
+
+const Task_t* Scheduler_GetTask(uint8_t id)
+{
+    if (id < SCHEDULER_MAX_TASKS) {
+        return &tasks[id];
+    }
+    return NULL;
+}
+
+uint32_t Scheduler_TimeToNextTask(void)
+{
+    uint32_t now = HAL_GetTick();
+    uint32_t minTime = UINT32_MAX;
+
+    for (int i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        if (!tasks[i].active) {
+            continue;
+        }
+        int32_t remaining = (int32_t)(tasks[i].nextRun - now);
+        if (remaining <= 0) {
+            return 0;
+        }
+        if ((uint32_t)remaining < minTime) {
+            minTime = (uint32_t)remaining;
+        }
+    }
+    return minTime;
+}
+
+uint32_t Scheduler_TimeToNextOneShot(void)
+{
+    uint32_t now = HAL_GetTick();
+    uint32_t minTime = UINT32_MAX;
+
+    for (int i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        if (!tasks[i].active || tasks[i].period != 0) {
+            continue;
+        }
+        int32_t remaining = (int32_t)(tasks[i].nextRun - now);
+        if (remaining <= 0) {
+            return 0;
+        }
+        if ((uint32_t)remaining < minTime) {
+            minTime = (uint32_t)remaining;
+        }
+    }
+    return minTime;
+}
+
+/* بعد از خواب طولانی (Stop): تسک‌های دوره‌ای عقب‌مانده همین الان موعد دارند
+ * و این تأخیر در آمار deadline حساب نمی‌شود */
+void Scheduler_Resume(void)
+{
+    uint32_t now = HAL_GetTick();
+
+    for (int i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        if (tasks[i].active && tasks[i].period != 0 && (int32_t)(now - tasks[i].nextRun) > 0) {
+            tasks[i].nextRun = now;
+        }
+    }
+}
+
+/* بعد از پرش زمان: تسک‌های دوره‌ای عقب‌مانده به اولین نوبت آینده خودشان
+ * می‌روند (فاز حفظ می‌شود)، بدون اجرای جبرانی و بدون ثبت تأخیر */
+void Scheduler_Realign(void)
+{
+    uint32_t now = HAL_GetTick();
+
+    for (int i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        Task_t *task = &tasks[i];
+        if (task->active && task->period != 0 && (int32_t)(now - task->nextRun) > 0) {
+            uint32_t behind = now - task->nextRun;
+            task->nextRun += ((behind + task->period - 1) / task->period) * task->period;
+        }
+    }
+}
+
+void Scheduler_Run(void)
+{
+    uint8_t ranTask = 0;
+
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        Task_t *task = &tasks[i];
+        if (!task->active) {
+            continue;
+        }
+
+        uint32_t now = HAL_GetTick();
+        int32_t lateness = (int32_t)(now - task->nextRun);
+        if (lateness < 0) {
+            continue; // هنوز موعدش نرسیده
+        }
+
+        /* آمار deadline */
+        if ((uint32_t)lateness > task->maxLateness) {
+            task->maxLateness = (uint32_t)lateness;
+        }
+        if ((uint32_t)lateness > task->deadline) {
+            task->deadlineMisses++;
+        }
+
+        if (task->period != 0) {
+            task->nextRun += task->period;
+            /* اگر چند دوره عقب افتادیم، اجرای جبرانی پشت سر هم نداریم */
+            if ((int32_t)(now - task->nextRun) >= 0) {
+                task->nextRun = now + task->period;
+            }
+        } else {
+            task->active = 0; // تسک یک‌باره قبل از اجرا آزاد می‌شود تا بتواند خودش را دوباره ثبت کند
+        }
+
+        task->runCount++;
+        task->function();
+        ranTask = 1;
+    }
+
+    if (!ranTask) {
+        Scheduler_Idle(Scheduler_TimeToNextTask());
+    }
+}
+
+/* هیچ تسکی آماده نیست: تا وقفه بعدی (حداکثر SysTick بعدی) بخواب */
+__weak void Scheduler_Idle(uint32_t timeToNext)
+{
+    if (timeToNext > 0) {
+        __WFI();
+    }
+}
@@ -0,0 +1,576 @@
+/* =================================================================
+ * ماشین حالت سیستم امنیتی - پیاده‌سازی
+ *
+ * ترتیب اجرای یک انتقال:
+ *   guard (اگر false شد رویداد نادیده گرفته می‌شود)
+ *   -> exit حالت فعلی -> action -> entry حالت بعدی
+ * انتقال با STATE_NONE داخلی است (exit/entry اجرا نمی‌شود).
+ * STATE_RETURN به حالتی برمی‌گردد که ورود رمز از آن شروع شد.
+ *
+ * بررسی رمز خودش انتقال نمی‌دهد: نتیجه را به صورت رویداد
+ * PIN_OK/PIN_BAD در صف می‌گذارد (به جای فراخوانی بازگشتی).
+ * ================================================================= */
+
+#include "security.h"
+#include "hd44780.h"
+#include "leds.h"
+#include "buzzer.h"
+#include "timing.h"
+#include "users.h"
+#include "cards.h"
+#include "revoke.h"
+#include "eventlog.h"
+#include "eeprom.h"
+#include "bench.h"
+#include "profile.h"
+#include <string.h>
+
+#define STATE_NONE      0xFE
+#define STATE_RETURN    0xFF
+
+typedef struct {
+    uint8_t (*guard)(const SecurityEvent_t *event);
+    void (*action)(const SecurityEvent_t *event);
+    uint8_t next;
+} Transition_t;
+
+typedef struct {
+    void (*entry)(void);
+    void (*exit)(void);
+    uint32_t timeout;       /* ms بعد از ورود رویداد TIMEOUT؛ 0 = ندارد */
+    uint16_t timeoutKey;    /* کلید EEPROM که در صورت وجود جای timeout را می‌گیرد؛ 0 = ندارد */
+} StateInfo_t;
+
+typedef enum {
+    ALARM_REASON_CARD,
+    ALARM_REASON_MOTION
+} AlarmReason_t;
+
+/* الگوهای LED هر وضعیت {ماسک، مدت ms} */
+static const LedStep_t disarmedSteps[]      = {{LED_MASK_GREEN, 0}};
+static const LedStep_t armedSteps[]         = {{LED_MASK_RED1, 0}};
+static const LedStep_t passwordEntrySteps[] = {{LED_MASK_RED2, 0}};
+static const LedStep_t alarmSteps[]         = {{LED_MASK_RED1, 150}, {LED_MASK_RED2, 150}};
+static const LedStep_t accessGrantedSteps[] = {{LED_MASK_GREEN, 0}};
+static const LedStep_t accessDeniedSteps[]  = {{LED_MASK_RED1 | LED_MASK_RED2, 300}, {0, 300}};
+
+static const LedPattern_t disarmedPattern      = {disarmedSteps, 1, 0};
+static const LedPattern_t armedPattern         = {armedSteps, 1, 0};
+static const LedPattern_t passwordEntryPattern = {passwordEntrySteps, 1, 0};
+static const LedPattern_t alarmPattern         = {alarmSteps, 2, 0};
+static const LedPattern_t accessGrantedPattern = {accessGrantedSteps, 1, 0};
+static const LedPattern_t accessDeniedPattern  = {accessDeniedSteps, 2, 3};
+
+/* خط‌های RFID_CARD1..3 برد به جای کارت‌خوان: هر خط یک UID ثابت ارائه می‌کند */
+static const CardUid_t lineCards[3] = {
+    {4, {0x04, 0xA2, 0x2B, 0x1C}},
+    {7, {0x04, 0x5F, 0x11, 0x92, 0x3A, 0x6E, 0x80}},
+    {4, {0xDE, 0xAD, 0xBE, 0xEF}},          /* در پایگاه نیست */
+};
+
+/* الگوی آژیر: بوق 100ms هر 300ms، تا خروج از حالت آلارم */
+static const BuzzerTone_t alarmSiren[] = {
+    {0, 100, 200}
+};
+
+static SystemState_t currentState = SYSTEM_DISARMED;
+static SystemState_t returnState = SYSTEM_DISARMED;
+static AlarmReason_t alarmReason = ALARM_REASON_CARD;
+static char enteredPassword[USERS_PIN_MAX_LENGTH + 1];
+static uint8_t passwordIndex = 0;
+static uint16_t lastUserId = USERS_INVALID_ID;
+
+static uint8_t timerActive = 0;
+static uint32_t timerDeadline = 0;
+
+static SecurityEvent_t eventQueue[SECURITY_QUEUE_SIZE];
+static volatile uint8_t queueHead = 0;
+static volatile uint8_t queueTail = 0;
+static uint32_t droppedEvents = 0;
+static uint32_t maxDispatchCycles = 0;
+
+/* ================================================
+ * تایمر حالت
+ * ================================================ */
+static void Security_StartTimer(uint32_t ms)
+{
+    timerDeadline = HAL_GetTick() + ms;
+    timerActive = 1;
+}
+
+/* ================================================
+ * entry / exit حالت‌ها
+ * ================================================ */
+static void Entry_Disarmed(void)
+{
+    Buzzer_Stop();
+    LCD_Clear();
+    LCD_Print("System DISARMED");
+    LCD_SetCursor(1, 0);
+    LCD_Print("Press *=* to ARM");
+    Leds_SetPattern(&disarmedPattern);
+}
+
+static void Entry_Armed(void)
+{
+    LCD_Clear();
+    LCD_Print("System ARMED");
+    LCD_SetCursor(1, 0);
+    LCD_Print("Monitoring...");
+    Leds_SetPattern(&armedPattern);
+}
+
+static void Entry_Alarm(void)
+{
+    LCD_Clear();
+    LCD_Print("!! ALARM !!");
+    LCD_SetCursor(1, 0);
+    LCD_Print(alarmReason == ALARM_REASON_MOTION ? "Motion Detected" : "Unauthorized");
+    Leds_SetPattern(&alarmPattern);
+    Buzzer_PlayLoop(alarmSiren, sizeof(alarmSiren) / sizeof(alarmSiren[0]));
+}
+
+static void Entry_PasswordEntry(void)
+{
+    LCD_Clear();
+    LCD_Print("Enter Password:");
+    LCD_SetCursor(1, 0);
+    for (uint8_t i = 0; i < passwordIndex; i++) {
+        LCD_PutChar('*'); // نمایش ستاره به جای عدد
+    }
+    Leds_SetPattern(&passwordEntryPattern);
+}
+
+static void Exit_PasswordEntry(void)
+{
+    memset(enteredPassword, 0, sizeof(enteredPassword));
+    passwordIndex = 0;
+}
+
+static void Entry_AccessGranted(void)
+{
+    LCD_Clear();
+    LCD_Print("Password OK!");
+    LCD_SetCursor(1, 0);
+    LCD_Print("Access Granted");
+    Leds_SetPattern(&accessGrantedPattern);
+    Buzzer_Stop();     // آژیر احتمالی قطع می‌شود
+    Buzzer_Beep(200);  // بوق کوتاه موفقیت
+}
+
+static void Entry_AccessDenied(void)
+{
+    LCD_Clear();
+    LCD_Print("Wrong Password!");
+    LCD_SetCursor(1, 0);
+    LCD_Print("Access Denied");
+    Leds_PlayOverlay(&accessDeniedPattern);
+    Buzzer_Beep(500);  // بوق طولانی خطا
+}
+
+static const StateInfo_t states[SYSTEM_STATE_COUNT] = {
+    [SYSTEM_ARMED]          = {Entry_Armed,         NULL,               0,                        0},
+    [SYSTEM_DISARMED]       = {Entry_Disarmed,      NULL,               0,                        0},
+    [SYSTEM_ALARM]          = {Entry_Alarm,         NULL,               0,                        0},
+    [SYSTEM_PASSWORD_ENTRY] = {Entry_PasswordEntry, Exit_PasswordEntry, 0,                        0},
+    [SYSTEM_ACCESS_GRANTED] = {Entry_AccessGranted, NULL,               SECURITY_GRANTED_SHOW_MS, EEPROM_KEY_GRANTED_SHOW_MS},
+    [SYSTEM_ACCESS_DENIED]  = {Entry_AccessDenied,  NULL,               SECURITY_DENIED_SHOW_MS,  EEPROM_KEY_DENIED_SHOW_MS},
+};
+
+/* ================================================
+ * guard ها
+ * ================================================ */
+static uint8_t Guard_PinNotFull(const SecurityEvent_t *event)
+{
+    (void)event;
+    return passwordIndex < USERS_PIN_MAX_LENGTH;
+}
+
+/* در حین ورود رمز، سیستم مسلح همچنان به حسگرها پاسخ می‌دهد */
+static uint8_t Guard_EnteredFromArmed(const SecurityEvent_t *event)
+{
+    (void)event;
+    return returnState == SYSTEM_ARMED;
+}
+
+/* ================================================
+ * action ها
+ * ================================================ */
+static void Action_BeginEntry(const SecurityEvent_t *event)
+{
+    returnState = currentState;
+    memset(enteredPassword, 0, sizeof(enteredPassword));
+    enteredPassword[0] = event->key;
+    passwordIndex = 1;
+}
+
+static void Action_AppendDigit(const SecurityEvent_t *event)
+{
+    enteredPassword[passwordIndex++] = event->key;
+    LCD_SetCursor(1, passwordIndex - 1);
+    LCD_PutChar('*');
+
+    /* طول رمز متغیر است: از حداقل طول به بعد، مکث بعد از هر رقم بررسی خودکار را شروع می‌کند ('=' فوری) */
+    if (passwordIndex >= USERS_PIN_MIN_LENGTH) {
+        Security_StartTimer(Eeprom_Read(EEPROM_KEY_PIN_SHOW_MS, SECURITY_PIN_SHOW_MS));
+    }
+}
+
+static void Action_ClearEntry(const SecurityEvent_t *event)
+{
+    (void)event;
+    memset(enteredPassword, 0, sizeof(enteredPassword));
+    passwordIndex = 0;
+    timerActive = 0;
+    Entry_PasswordEntry();
+}
+
+static void Action_Verify(const SecurityEvent_t *event)
+{
+    (void)event;
+    timerActive = 0;
+    if (Users_Verify(enteredPassword, passwordIndex, &lastUserId)) {
+        Security_PostEvent(SEC_EVENT_PIN_OK, 0);
+    } else {
+        Security_PostEvent(SEC_EVENT_PIN_BAD, 0);
+    }
+}
+
+/* رمز صحیح وضعیت مبدأ را برعکس می‌کند: غیرفعال -> مسلح، بقیه -> غیرفعال */
+static void Action_Granted(const SecurityEvent_t *event)
+{
+    (void)event;
+    returnState = (returnState == SYSTEM_DISARMED) ? SYSTEM_ARMED : SYSTEM_DISARMED;
+    EventLog_Append(EVENTLOG_PIN_GRANTED, returnState == SYSTEM_ARMED, lastUserId);
+    Eeprom_Write(EEPROM_KEY_PIN_FAILURES, 0); // بدون تغییر چیزی نوشته نمی‌شود
+}
+
+/* شمارنده رمز اشتباه با reset صفر نمی‌شود */
+static void Action_Denied(const SecurityEvent_t *event)
+{
+    (void)event;
+    EventLog_Append(EVENTLOG_PIN_DENIED, 0, 0);
+    Eeprom_Write(EEPROM_KEY_PIN_FAILURES, Security_GetFailedAttempts() + 1U);
+}
+
+static void Action_CardAccepted(const SecurityEvent_t *event)
+{
+    (void)event;
+    Buzzer_Beep(200);
+}
+
+/* فقط انتقال‌هایی که آلارم تازه می‌سازند؛ Entry_Alarm با 'C' یا برگشت از
+ * رمز اشتباه هم اجرا می‌شود و نباید آلارم دوباره ثبت کند */
+static void Security_RaiseAlarm(AlarmReason_t reason)
+{
+    alarmReason = reason;
+    EventLog_Append(EVENTLOG_ALARM, (uint8_t)reason, 0);
+    Eeprom_Write(EEPROM_KEY_ALARM_COUNT, Eeprom_Read(EEPROM_KEY_ALARM_COUNT, 0) + 1U);
+}
+
+static void Action_AlarmCard(const SecurityEvent_t *event)
+{
+    (void)event;
+    Security_RaiseAlarm(ALARM_REASON_CARD);
+}
+
+static void Action_AlarmMotion(const SecurityEvent_t *event)
+{
+    (void)event;
+    Security_RaiseAlarm(ALARM_REASON_MOTION);
+}
+
+/* ================================================
+ * جدول انتقال [حالت][رویداد]؛ خانه خالی = رویداد نادیده گرفته می‌شود
+ * ================================================ */
+#define T(guard, action, next)  {guard, action, next}
+#define IGNORE                  {NULL, NULL, STATE_NONE}
+
+static const Transition_t transitions[SYSTEM_STATE_COUNT][SEC_EVENT_COUNT] = {
+    [SYSTEM_ARMED] = {
+        [SEC_EVENT_KEY_DIGIT]    = T(NULL, Action_BeginEntry, SYSTEM_PASSWORD_ENTRY),
+        [SEC_EVENT_KEY_CLEAR]    = T(NULL, NULL, SYSTEM_ARMED),
+        [SEC_EVENT_KEY_ENTER]    = IGNORE,
+        [SEC_EVENT_CARD_VALID]   = T(NULL, Action_CardAccepted, SYSTEM_DISARMED),
+        [SEC_EVENT_CARD_INVALID] = T(NULL, Action_AlarmCard, SYSTEM_ALARM),
+        [SEC_EVENT_MOTION]       = T(NULL, Action_AlarmMotion, SYSTEM_ALARM),
+        [SEC_EVENT_PIN_OK]       = IGNORE,
+        [SEC_EVENT_PIN_BAD]      = IGNORE,
+        [SEC_EVENT_TIMEOUT]      = IGNORE,
+    },
+    [SYSTEM_DISARMED] = {
+        [SEC_EVENT_KEY_DIGIT]    = T(NULL, Action_BeginEntry, SYSTEM_PASSWORD_ENTRY),
+        [SEC_EVENT_KEY_CLEAR]    = T(NULL, NULL, SYSTEM_DISARMED),
+        [SEC_EVENT_KEY_ENTER]    = IGNORE,
+        [SEC_EVENT_CARD_VALID]   = IGNORE,
+        [SEC_EVENT_CARD_INVALID] = IGNORE,
+        [SEC_EVENT_MOTION]       = IGNORE,
+        [SEC_EVENT_PIN_OK]       = IGNORE,
+        [SEC_EVENT_PIN_BAD]      = IGNORE,
+        [SEC_EVENT_TIMEOUT]      = IGNORE,
+    },
+    [SYSTEM_ALARM] = {
+        [SEC_EVENT_KEY_DIGIT]    = T(NULL, Action_BeginEntry, SYSTEM_PASSWORD_ENTRY),
+        [SEC_EVENT_KEY_CLEAR]    = T(NULL, NULL, SYSTEM_ALARM),
+        [SEC_EVENT_KEY_ENTER]    = IGNORE,
+        [SEC_EVENT_CARD_VALID]   = IGNORE,
+        [SEC_EVENT_CARD_INVALID] = IGNORE,
+        [SEC_EVENT_MOTION]       = IGNORE,
+        [SEC_EVENT_PIN_OK]       = IGNORE,
+        [SEC_EVENT_PIN_BAD]      = IGNORE,
+        [SEC_EVENT_TIMEOUT]      = IGNORE,
+    },
+    [SYSTEM_PASSWORD_ENTRY] = {
+        [SEC_EVENT_KEY_DIGIT]    = T(Guard_PinNotFull, Action_AppendDigit, STATE_NONE),
+        [SEC_EVENT_KEY_CLEAR]    = T(NULL, Action_ClearEntry, STATE_NONE),
+        [SEC_EVENT_KEY_ENTER]    = T(NULL, Action_Verify, STATE_NONE),
+        [SEC_EVENT_CARD_VALID]   = T(Guard_EnteredFromArmed, Action_CardAccepted, SYSTEM_DISARMED),
+        [SEC_EVENT_CARD_INVALID] = T(Guard_EnteredFromArmed, Action_AlarmCard, SYSTEM_ALARM),
+        [SEC_EVENT_MOTION]       = T(Guard_EnteredFromArmed, Action_AlarmMotion, SYSTEM_ALARM),
+        [SEC_EVENT_PIN_OK]       = T(NULL, Action_Granted, SYSTEM_ACCESS_GRANTED),
+        [SEC_EVENT_PIN_BAD]      = T(NULL, Action_Denied, SYSTEM_ACCESS_DENIED),
+        [SEC_EVENT_TIMEOUT]      = T(NULL, Action_Verify, STATE_NONE),
+    },
+    [SYSTEM_ACCESS_GRANTED] = {
+        [SEC_EVENT_KEY_DIGIT]    = IGNORE,
+        [SEC_EVENT_KEY_CLEAR]    = IGNORE,
+        [SEC_EVENT_KEY_ENTER]    = IGNORE,
+        [SEC_EVENT_CARD_VALID]   = IGNORE,
+        [SEC_EVENT_CARD_INVALID] = IGNORE,
+        [SEC_EVENT_MOTION]       = IGNORE,
+        [SEC_EVENT_PIN_OK]       = IGNORE,
+        [SEC_EVENT_PIN_BAD]      = IGNORE,
+        [SEC_EVENT_TIMEOUT]      = T(NULL, NULL, STATE_RETURN),
+    },
+    [SYSTEM_ACCESS_DENIED] = {
+        [SEC_EVENT_KEY_DIGIT]    = IGNORE,
+        [SEC_EVENT_KEY_CLEAR]    = T(NULL, NULL, STATE_RETURN),
+        [SEC_EVENT_KEY_ENTER]    = IGNORE,
+        [SEC_EVENT_CARD_VALID]   = IGNORE,
+        [SEC_EVENT_CARD_INVALID] = IGNORE,
+        [SEC_EVENT_MOTION]       = IGNORE,
+        [SEC_EVENT_PIN_OK]       = IGNORE,
+        [SEC_EVENT_PIN_BAD]      = IGNORE,
+        [SEC_EVENT_TIMEOUT]      = T(NULL, NULL, STATE_RETURN),
+    },
+};
+
+/* ================================================
+ * هسته ماشین حالت
+ * ================================================ */
+static void Security_Enter(SystemState_t state)
+{
+    uint32_t timeout = Eeprom_Read(states[state].timeoutKey, states[state].timeout);
+
+    currentState = state;
+    timerActive = 0;
+    if (timeout > 0) {
+        Security_StartTimer(timeout);
+    }
+    if (states[state].entry != NULL) {
+        states[state].entry();
+    }
+}
+
+static void Security_Dispatch(const SecurityEvent_t *event)
+{
+    const Transition_t *t = &transitions[currentState][event->type];
+
+    if (t->action == NULL && t->next == STATE_NONE) {
+        return;
+    }
+    if (t->guard != NULL && !t->guard(event)) {
+        return;
+    }
+
+    uint8_t next = (t->next == STATE_RETURN) ? (uint8_t)returnState : t->next;
+
+    if (next != STATE_NONE && states[currentState].exit != NULL) {
+        states[currentState].exit();
+    }
+    if (t->action != NULL) {
+        t->action(event);
+    }
+    if (next != STATE_NONE) {
+        Security_Enter((SystemState_t)next);
+    }
+}
+
+void Security_Init(void)
+{
+    queueHead = queueTail = 0;
+    passwordIndex = 0;
+    memset(enteredPassword, 0, sizeof(enteredPassword));
+    returnState = SYSTEM_DISARMED;
+    Security_Enter(SYSTEM_DISARMED);
+}
+
+uint8_t Security_PostEvent(SecurityEventType_t type, char key)
+{
+    uint8_t next = (queueHead + 1) & (SECURITY_QUEUE_SIZE - 1);
+    if (next == queueTail) {
+        droppedEvents++; // صف پر است
+        return 0;
+    }
+    eventQueue[queueHead].type = type;
+    eventQueue[queueHead].key = key;
+    eventQueue[queueHead].timestamp = HAL_GetTick();
+    queueHead = next;
+    return 1;
+}
+
+/* نگاشت کلیدهای کیپد به رویداد؛ سایر کلیدها نادیده گرفته می‌شوند */
+void Security_PostKey(char key)
+{
+    if (key >= '0' && key <= '9') {
+        Security_PostEvent(SEC_EVENT_KEY_DIGIT, key);
+    } else if (key == 'C') {
+        Security_PostEvent(SEC_EVENT_KEY_CLEAR, key);
+    } else if (key == '=') {
+        Security_PostEvent(SEC_EVENT_KEY_ENTER, key);
+    }
+}
+
+/* 4 بایت آخر UID برای گزارش رویدادها */
+static uint32_t Security_UidTail(const CardUid_t *uid)
+{
+    uint32_t tail = 0;
+
+    for (uint8_t i = (uid->length > 4) ? uid->length - 4U : 0; i < uid->length; i++) {
+        tail = (tail << 8) | uid->bytes[i];
+    }
+    return tail;
+}
+
+/* UID خوانده‌شده را در پایگاه کارت‌ها جست‌وجو می‌کند؛ کارت ناشناس یا مسدود غیرمجاز است */
+void Security_PresentCard(const CardUid_t *uid)
+{
+    uint16_t attributes;
+    uint8_t reason;
+
+    /* فهرست باطل‌شده فقط برای کارت معتبر؛ اغلب فیلتر Bloom همان‌جا رد می‌کند */
+    if (!Cards_Lookup(uid, &attributes)) {
+        reason = EVENTLOG_CARD_UNKNOWN;
+    } else if (!(attributes & CARD_ATTR_ACTIVE)) {
+        reason = EVENTLOG_CARD_BLOCKED;
+    } else if (Revoke_IsRevoked(uid)) {
+        reason = EVENTLOG_CARD_REVOKED;
+    } else {
+        Security_PostEvent(SEC_EVENT_CARD_VALID, 0);
+        EventLog_Append(EVENTLOG_CARD_GRANTED, 0, Security_UidTail(uid));
+        return;
+    }
+
+    /* تصمیم اول در صف می‌رود، بعد گزارش */
+    Security_PostEvent(SEC_EVENT_CARD_INVALID, 0);
+    EventLog_Append(EVENTLOG_CARD_DENIED, reason, Security_UidTail(uid));
+}
+
+/* حسگرها با لبه رویداد می‌سازند، نه با سطح */
+void Security_CheckSensors(void)
+{
+    static uint8_t lastCards = 0;
+    static uint8_t lastPirState = GPIO_PIN_RESET;
+    PROFILE_BEGIN();
+
+    /* کارت‌ها (کلید فعال-پایین) */
+    uint8_t cards = 0;
+    if (HAL_GPIO_ReadPin(RFID_CARD1_GPIO_Port, RFID_CARD1_Pin) == GPIO_PIN_RESET) cards |= 0x01;
+    if (HAL_GPIO_ReadPin(RFID_CARD2_GPIO_Port, RFID_CARD2_Pin) == GPIO_PIN_RESET) cards |= 0x02;
+    if (HAL_GPIO_ReadPin(RFID_CARD3_GPIO_Port, RFID_CARD3_Pin) == GPIO_PIN_RESET) cards |= 0x04;
+
+    uint8_t presented = cards & ~lastCards;
+    lastCards = cards;
+    if (presented) {
+        BENCH_STIMULUS(BENCH_SRC_CARD);
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        if (presented & (1u << i)) {
+            Security_PresentCard(&lineCards[i]);
+        }
+    }
+
+    /* PIR Sensor (LOGICSTATE) */
+    uint8_t currentPirState = HAL_GPIO_ReadPin(PIR_SENSOR_GPIO_Port, PIR_SENSOR_Pin);
+    if (currentPirState == GPIO_PIN_SET && lastPirState == GPIO_PIN_RESET) {
+        BENCH_STIMULUS(BENCH_SRC_PIR);
+        Security_PostEvent(SEC_EVENT_MOTION, 0);
+        EventLog_Append(EVENTLOG_MOTION, 0, 0);
+    }
+    lastPirState = currentPirState;
+    PROFILE_END(PROF_SECURITY_SENSORS);
+}
+
+/* timeout حالت را بررسی و همه رویدادهای صف را پردازش می‌کند */
+void Security_ProcessEvents(void)
+{
+    SecurityEvent_t event;
+    PROFILE_BEGIN();
+
+    if (timerActive && (int32_t)(HAL_GetTick() - timerDeadline) >= 0) {
+        timerActive = 0;
+        Security_PostEvent(SEC_EVENT_TIMEOUT, 0);
+    }
+
+    while (queueTail != queueHead) {
+        event = eventQueue[queueTail];
+        queueTail = (queueTail + 1) & (SECURITY_QUEUE_SIZE - 1);
+
+        uint32_t start = Timing_GetCycles();
+        Security_Dispatch(&event);
+        uint32_t cycles = Timing_ElapsedCycles(start);
+        if (cycles > maxDispatchCycles) {
+            maxDispatchCycles = cycles;
+        }
+        Security_EventHandled(&event);
+        BENCH_EVENT(event.type, currentState);
+    }
+    PROFILE_END(PROF_SECURITY_EVENTS);
+}
+
+/* کاربر آخرین رمز صحیح؛ USERS_INVALID_ID اگر آخرین تلاش رد شد */
+uint16_t Security_GetLastUser(void)
+{
+    return lastUserId;
+}
+
+/* رمزهای اشتباه پشت سر هم از آخرین رمز صحیح، حتی در میان reset ها */
+uint32_t Security_GetFailedAttempts(void)
+{
+    return Eeprom_Read(EEPROM_KEY_PIN_FAILURES, 0);
+}
+
+SystemState_t Security_GetState(void)
+{
+    return currentState;
+}
+
+/* رویداد یا timeout در انتظار نیست */
+uint8_t Security_IsIdle(void)
+{
+    return (queueHead == queueTail) && !timerActive;
+}
+
+/* حسگرها فقط وقتی سیستم مسلح است (یا ورود رمز از حالت مسلح) اثر دارند */
+uint8_t Security_NeedsSensors(void)
+{
+    return currentState == SYSTEM_ARMED
+        || (currentState == SYSTEM_PASSWORD_ENTRY && returnState == SYSTEM_ARMED);
+}
+
+/* بدترین زمان پردازش یک رویداد (سیکل CPU) */
+uint32_t Security_GetMaxDispatchCycles(void)
+{
+    return maxDispatchCycles;
+}
+
+uint32_t Security_GetDroppedEvents(void)
+{
+    return droppedEvents;
+}
+
+/* بعد از پردازش هر رویداد صدا زده می‌شود (برای اندازه‌گیری تأخیر) */
+__weak void Security_EventHandled(const SecurityEvent_t *event)
+{
+    (void)event;
+}
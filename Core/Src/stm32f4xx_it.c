@@ -22,6 +22,13 @@
 #include "stm32f4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "hd44780.h"
+#include "timing.h"
+#include "buzzer.h"
+#include "leds.h"
+#include "power.h"
+#include "profile.h"
+#include "crc.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -57,6 +64,9 @@
 /* External variables --------------------------------------------------------*/
 
 /* USER CODE BEGIN EV */
+#if LCD_USE_DMA
+extern DMA_HandleTypeDef hdma_tim1_up;
+#endif
 
 /* USER CODE END EV */
 
@@ -183,11 +193,13 @@ void PendSV_Handler(void)
 void SysTick_Handler(void)
 {
   /* USER CODE BEGIN SysTick_IRQn 0 */
-
+  PROFILE_BEGIN();
   /* USER CODE END SysTick_IRQn 0 */
   HAL_IncTick();
   /* USER CODE BEGIN SysTick_IRQn 1 */
-
+  Timing_Update();
+  Leds_Tick();
+  PROFILE_END(PROF_ISR_SYSTICK);
   /* USER CODE END SysTick_IRQn 1 */
 }
 
@@ -198,6 +210,120 @@ void SysTick_Handler(void)
 /* please refer to the startup file (startup_stm32f4xx.s).                    */
 /******************************************************************************/
 
+/**
+  * @brief This function handles EXTI line0 interrupt.
+  */
+void EXTI0_IRQHandler(void)
+{
+  /* USER CODE BEGIN EXTI0_IRQn 0 */
+  PROFILE_BEGIN();
+  /* USER CODE END EXTI0_IRQn 0 */
+  HAL_GPIO_EXTI_IRQHandler(KEYPAD_ROW1_Pin);
+  /* USER CODE BEGIN EXTI0_IRQn 1 */
+  PROFILE_END(PROF_ISR_EXTI);
+  /* USER CODE END EXTI0_IRQn 1 */
+}
+
+/**
+  * @brief This function handles EXTI line1 interrupt.
+  */
+void EXTI1_IRQHandler(void)
+{
+  /* USER CODE BEGIN EXTI1_IRQn 0 */
+  PROFILE_BEGIN();
+  /* USER CODE END EXTI1_IRQn 0 */
+  HAL_GPIO_EXTI_IRQHandler(KEYPAD_ROW2_Pin);
+  /* USER CODE BEGIN EXTI1_IRQn 1 */
+  PROFILE_END(PROF_ISR_EXTI);
+  /* USER CODE END EXTI1_IRQn 1 */
+}
+
+/**
+  * @brief This function handles EXTI line2 interrupt.
+  */
+void EXTI2_IRQHandler(void)
+{
+  /* USER CODE BEGIN EXTI2_IRQn 0 */
+  PROFILE_BEGIN();
+  /* USER CODE END EXTI2_IRQn 0 */
+  HAL_GPIO_EXTI_IRQHandler(KEYPAD_ROW3_Pin);
+  /* USER CODE BEGIN EXTI2_IRQn 1 */
+  PROFILE_END(PROF_ISR_EXTI);
+  /* USER CODE END EXTI2_IRQn 1 */
+}
+
+/**
+  * @brief This function handles EXTI line3 interrupt.
+  */
+void EXTI3_IRQHandler(void)
+{
+  /* USER CODE BEGIN EXTI3_IRQn 0 */
+  PROFILE_BEGIN();
+  /* USER CODE END EXTI3_IRQn 0 */
+  HAL_GPIO_EXTI_IRQHandler(KEYPAD_ROW4_Pin);
+  /* USER CODE BEGIN EXTI3_IRQn 1 */
+  PROFILE_END(PROF_ISR_EXTI);
+  /* USER CODE END EXTI3_IRQn 1 */
+}
+
+/**
+  * @brief This function handles RTC wake-up interrupt through EXTI line 22.
+  */
+void RTC_WKUP_IRQHandler(void)
+{
+  /* USER CODE BEGIN RTC_WKUP_IRQn 0 */
+  PROFILE_BEGIN();
+  /* USER CODE END RTC_WKUP_IRQn 0 */
+  Power_RtcWakeupIRQHandler();
+  /* USER CODE BEGIN RTC_WKUP_IRQn 1 */
+  PROFILE_END(PROF_ISR_RTC);
+  /* USER CODE END RTC_WKUP_IRQn 1 */
+}
+
+/**
+  * @brief This function handles TIM3 global interrupt.
+  */
+void TIM3_IRQHandler(void)
+{
+  /* USER CODE BEGIN TIM3_IRQn 0 */
+  PROFILE_BEGIN();
+  /* USER CODE END TIM3_IRQn 0 */
+  Buzzer_IRQHandler();
+  /* USER CODE BEGIN TIM3_IRQn 1 */
+  PROFILE_END(PROF_ISR_TIM3);
+  /* USER CODE END TIM3_IRQn 1 */
+}
+
+/**
+  * @brief This function handles DMA2 stream0 global interrupt.
+  */
+void DMA2_Stream0_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA2_Stream0_IRQn 0 */
+  PROFILE_BEGIN();
+  /* USER CODE END DMA2_Stream0_IRQn 0 */
+  Crc_IRQHandler();
+  /* USER CODE BEGIN DMA2_Stream0_IRQn 1 */
+  PROFILE_END(PROF_ISR_DMA);
+  /* USER CODE END DMA2_Stream0_IRQn 1 */
+}
+
+#if LCD_USE_DMA
+/**
+  * @brief This function handles DMA2 stream5 global interrupt.
+  */
+void DMA2_Stream5_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA2_Stream5_IRQn 0 */
+  PROFILE_BEGIN();
+  /* USER CODE END DMA2_Stream5_IRQn 0 */
+  HAL_DMA_IRQHandler(&hdma_tim1_up);
+  /* USER CODE BEGIN DMA2_Stream5_IRQn 1 */
+  PROFILE_END(PROF_ISR_DMA);
+  /* USER CODE END DMA2_Stream5_IRQn 1 */
+}
+#endif /* LCD_USE_DMA */
+
 /* USER CODE BEGIN 1 */
 
 /* USER CODE END 1 */
@@ -0,0 +1,105 @@
+/* =================================================================
+ * سرویس زمان‌سنجی DWT - پیاده‌سازی
+ *
+ * CYCCNT در 84MHz هر حدود 51 ثانیه سرریز می‌شود. Timing_Update که در
+ * SysTick_Handler صدا زده می‌شود اختلاف را در یک شمارنده 64 بیتی جمع
+ * می‌کند تا هیچ سرریزی گم نشود.
+ * ================================================================= */
+
+#include "timing.h"
+
+static uint32_t cyclesPerUs = 1;
+static uint32_t lastCycles = 0;
+static uint64_t totalCycles = 0;
+
+void Timing_Init(void)
+{
+    cyclesPerUs = SystemCoreClock / 1000000U;
+    if (cyclesPerUs == 0) {
+        cyclesPerUs = 1;
+    }
+
+    /* فعال‌سازی واحد trace و شمارنده سیکل */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    lastCycles = 0;
+    totalCycles = 0;
+}
+
+/* با وقفه‌های بسته صدا زده شود؛ جمع 64 بیتی همان لحظه را برمی‌گرداند */
+static uint64_t Timing_Accumulate(void)
+{
+    uint32_t now = DWT->CYCCNT;
+    totalCycles += (uint32_t)(now - lastCycles);
+    lastCycles = now;
+    return totalCycles;
+}
+
+/* حداقل یک بار در هر دور CYCCNT باید صدا زده شود (از SysTick) */
+void Timing_Update(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    Timing_Accumulate();
+    __set_PRIMASK(primask);
+}
+
+void delay_us(uint32_t us)
+{
+    uint32_t start = DWT->CYCCNT;
+    uint32_t ticks = us * cyclesPerUs;
+
+    while ((uint32_t)(DWT->CYCCNT - start) < ticks) {
+    }
+}
+
+uint32_t Timing_GetCycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+/* کپی در همان بخش بحرانی: خواندن 64 بیتی در دو دستور با SysTick نصف نمی‌شود */
+uint64_t Timing_GetMicros64(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint64_t cycles = Timing_Accumulate();
+    __set_PRIMASK(primask);
+
+    return cycles / cyclesPerUs;
+}
+
+/* تفاضل بدون علامت: یک بار سرریز بین start و الان درست حساب می‌شود */
+uint32_t Timing_ElapsedCycles(uint32_t startCycles)
+{
+    return (uint32_t)(DWT->CYCCNT - startCycles);
+}
+
+uint32_t Timing_ElapsedUs(uint32_t startCycles)
+{
+    return Timing_ElapsedCycles(startCycles) / cyclesPerUs;
+}
+
+uint32_t Timing_CyclesToUs(uint32_t cycles)
+{
+    return cycles / cyclesPerUs;
+}
+
+uint32_t Timing_CyclesPerUs(void)
+{
+    return cyclesPerUs;
+}
+
+/* در Stop mode شمارنده سیکل می‌ایستد؛ زمان خواب جداگانه اضافه می‌شود */
+void Timing_AddSleep(uint32_t us)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    totalCycles += (uint64_t)us * cyclesPerUs;
+    lastCycles = DWT->CYCCNT;
+
+    __set_PRIMASK(primask);
+}
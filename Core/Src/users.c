@@ -0,0 +1,105 @@
+/* =================================================================
+ * جدول کاربران - بررسی رمز در زمان ثابت
+ *
+ * کلید درهم‌سازی رکورد = salt رکورد | pepper دستگاه
+ * کلید نمایه            = pepper | صفر
+ * تصمیم تطابق بدون شرط روی داده محرمانه گرفته می‌شود: تفاوت درهم‌ها
+ * به یک بیت تبدیل و با ماسک جمع می‌شود. تنها انشعاب، پر یا خالی بودن
+ * جای سطل است که به رمز واردشده بستگی ندارد.
+ * ================================================================= */
+
+#include "users.h"
+#include "hash.h"
+#include <string.h>
+
+/* جای خالی سطل روی این رکورد کار می‌کند؛ درهمش با هیچ ورودی برابر نمی‌شود مگر به تصادف 2^-64 */
+static const UserRecord_t dummyRecord = {USERS_INVALID_ID, 0, {0}, 0};
+
+static UsersTable_t builtinTable;
+static const UsersTable_t *activeTable = NULL;
+
+/* NULL یعنی جدول firmware (users_table.c) */
+static const UsersTable_t* Users_Active(void)
+{
+    if (activeTable == NULL) {
+        builtinTable.pepper = usersPepper;
+        builtinTable.index = usersIndex;
+        builtinTable.records = usersRecords;
+        builtinTable.count = usersCount;
+        activeTable = &builtinTable;
+    }
+    return activeTable;
+}
+
+static uint16_t Users_Bucket(const UsersTable_t *table, const char *pin)
+{
+    uint8_t key[HASH_KEY_SIZE] = {0};
+
+    memcpy(key, table->pepper, USERS_PEPPER_SIZE);
+    return (uint16_t)(Hash_SipHash(key, pin, USERS_PREFIX_LENGTH) % USERS_BUCKETS);
+}
+
+/* 1 اگر value صفر باشد، بدون انشعاب */
+static uint32_t Users_IsZero(uint64_t value)
+{
+    return (uint32_t)(((value | (~value + 1U)) >> 63) ^ 1U);
+}
+
+/* رمز (رقم‌های ASCII) را در جدول فعال بررسی می‌کند؛ در صورت تطابق شناسه کاربر در userId */
+uint8_t Users_Verify(const char *pin, uint8_t length, uint16_t *userId)
+{
+    return Users_VerifyIn(Users_Active(), pin, length, userId);
+}
+
+uint8_t Users_VerifyIn(const UsersTable_t *table, const char *pin, uint8_t length, uint16_t *userId)
+{
+    char digits[USERS_PIN_MAX_LENGTH] = {0};
+    uint8_t key[HASH_KEY_SIZE];
+    uint32_t validLength = (length >= USERS_PIN_MIN_LENGTH) & (length <= USERS_PIN_MAX_LENGTH);
+    uint32_t matched = 0;
+    uint16_t found = USERS_INVALID_ID;
+
+    /* رمز کوتاه یا بلند هم همان مقدار کار را انجام می‌دهد و فقط در آخر رد می‌شود */
+    if (length > USERS_PIN_MAX_LENGTH) {
+        length = USERS_PIN_MAX_LENGTH;
+    }
+    memcpy(digits, pin, length);
+
+    uint16_t bucket = Users_Bucket(table, digits);
+    uint16_t first = table->index[bucket];
+    uint16_t count = (uint16_t)(table->index[bucket + 1] - first);
+
+    memcpy(key + USERS_SALT_SIZE, table->pepper, USERS_PEPPER_SIZE);
+
+    for (uint16_t slot = 0; slot < USERS_BUCKET_MAX; slot++) {
+        uint32_t used = slot < count;
+        const UserRecord_t *record = used ? &table->records[first + slot] : &dummyRecord;
+
+        memcpy(key, record->salt, USERS_SALT_SIZE);
+        uint64_t hash = Hash_SipHash(key, digits, length);
+
+        uint32_t equal = Users_IsZero(hash ^ record->hash) & used;
+        uint16_t mask = (uint16_t)(0U - equal);
+        found = (uint16_t)((found & ~mask) | (record->id & mask));
+        matched |= equal;
+    }
+
+    memset(digits, 0, sizeof(digits));
+    matched &= validLength;
+
+    if (userId != NULL) {
+        *userId = matched ? found : USERS_INVALID_ID;
+    }
+    return (uint8_t)matched;
+}
+
+/* جایگزینی بین دو بررسی (تسک‌ها همکارند)؛ NULL = بازگشت به جدول firmware */
+void Users_SetTable(const UsersTable_t *table)
+{
+    activeTable = table;
+}
+
+uint16_t Users_Count(void)
+{
+    return Users_Active()->count;
+}
@@ -0,0 +1,262 @@
+/* =================================================================
+ * تولید پایگاه کارت‌ها (Core/Src/cards_table.c) از فهرست UID ها
+ *
+ * ورودی: قالب cards_list.h (فاصله یا CSV). درج cuckoo با جابه‌جایی تصادفی؛
+ * اگر نشد کلید جدول عوض می‌شود و بعد جدول 5% بزرگ‌تر می‌شود.
+ * در پایان هر کارت با همان Cards_LookupIn firmware بررسی می‌شود.
+ * استفاده:
+ *   ./cards_gen cards.txt [seed] > ../Core/Src/cards_table.c
+ *   ./cards_gen -r 50000 [seed]     فقط آمار برای N کارت تصادفی
+ * ================================================================= */
+
+#include "cards_list.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CARDS_GEN_LOAD      0.90        /* پرشدگی هدف */
+#define CARDS_GEN_KICKS     500
+#define CARDS_GEN_RESEEDS   8
+#define CARDS_GEN_PROBES    1000000     /* کارت ناشناس برای تخمین پذیرش اشتباه */
+
+typedef struct {
+    CardUid_t uid;
+    uint16_t attributes;
+    uint32_t tag;
+    uint32_t bucket[2];
+} GenCard_t;
+
+static CardsListEntry_t list[CARDS_LIST_MAX];
+static GenCard_t cards[CARDS_LIST_MAX];
+static uint32_t cardCount = 0;
+
+static uint32_t *tags = NULL;
+static uint16_t *attributes = NULL;
+static int32_t *slotCard = NULL;        /* کارت هر خانه؛ -1 خالی */
+static CardTable_t table;
+
+static uint32_t rngState = 0;
+static FILE *urandom = NULL;
+
+static uint32_t Gen_Rand(void)
+{
+    uint32_t value;
+    if (urandom != NULL && fread(&value, sizeof(value), 1, urandom) == 1) {
+        return value;
+    }
+    rngState = rngState * 1664525U + 1013904223U;
+    return rngState ^ (rngState >> 16);
+}
+
+static void Gen_Load(const CardsListEntry_t *entries, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        cards[i].uid = entries[i].uid;
+        cards[i].attributes = entries[i].attributes;
+    }
+    cardCount = count;
+}
+
+/* ================================================
+ * ساخت جدول
+ * ================================================ */
+static int Gen_Place(uint32_t index)
+{
+    uint32_t current = index;
+
+    for (int kick = 0; kick < CARDS_GEN_KICKS; kick++) {
+        GenCard_t *c = &cards[current];
+        for (int b = 0; b < 2; b++) {
+            uint32_t base = c->bucket[b] * CARDS_SLOTS_PER_BUCKET;
+            for (uint32_t s = 0; s < CARDS_SLOTS_PER_BUCKET; s++) {
+                if (slotCard[base + s] < 0) {
+                    slotCard[base + s] = (int32_t)current;
+                    return 1;
+                }
+            }
+        }
+
+        /* هر دو سطل پر: یک ساکن تصادفی را بیرون کن */
+        uint32_t victim = c->bucket[Gen_Rand() & 1U] * CARDS_SLOTS_PER_BUCKET + Gen_Rand() % CARDS_SLOTS_PER_BUCKET;
+        uint32_t evicted = (uint32_t)slotCard[victim];
+        slotCard[victim] = (int32_t)current;
+        current = evicted;
+    }
+    return 0;
+}
+
+static int Gen_Build(uint32_t bucketCount)
+{
+    uint32_t slots = bucketCount * CARDS_SLOTS_PER_BUCKET;
+
+    tags = realloc(tags, slots * sizeof(uint32_t));
+    attributes = realloc(attributes, slots * sizeof(uint16_t));
+    slotCard = realloc(slotCard, slots * sizeof(int32_t));
+    if (tags == NULL || attributes == NULL || slotCard == NULL) {
+        fprintf(stderr, "cards_gen: out of memory\n");
+        exit(1);
+    }
+
+    for (int k = 0; k < HASH_KEY_SIZE; k++) {
+        table.key[k] = (uint8_t)Gen_Rand();
+    }
+    table.bucketCount = bucketCount;
+    table.cardCount = cardCount;
+    table.tags = tags;
+    table.attributes = attributes;
+
+    for (uint32_t i = 0; i < slots; i++) {
+        slotCard[i] = -1;
+    }
+    for (uint32_t i = 0; i < cardCount; i++) {
+        Cards_Locate(&table, &cards[i].uid, &cards[i].tag, &cards[i].bucket[0], &cards[i].bucket[1]);
+    }
+    for (uint32_t i = 0; i < cardCount; i++) {
+        if (!Gen_Place(i)) {
+            return 0;
+        }
+    }
+
+    for (uint32_t i = 0; i < slots; i++) {
+        tags[i] = (slotCard[i] < 0) ? CARDS_EMPTY_TAG : cards[slotCard[i]].tag;
+        attributes[i] = (slotCard[i] < 0) ? CARD_ATTR_NONE : cards[slotCard[i]].attributes;
+    }
+
+    /* برخورد برچسب دو کارت در سطل مشترک جواب را مبهم می‌کند */
+    for (uint32_t i = 0; i < cardCount; i++) {
+        uint16_t attr;
+        if (!Cards_LookupIn(&table, &cards[i].uid, &attr) || attr != cards[i].attributes) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static uint32_t Gen_BuildAll(void)
+{
+    uint32_t bucketCount = (uint32_t)(cardCount / (CARDS_SLOTS_PER_BUCKET * CARDS_GEN_LOAD)) + 1U;
+
+    for (;;) {
+        for (int attempt = 0; attempt < CARDS_GEN_RESEEDS; attempt++) {
+            if (Gen_Build(bucketCount)) {
+                return bucketCount;
+            }
+        }
+        bucketCount += bucketCount / 20U + 1U;
+    }
+}
+
+/* ================================================
+ * خروجی
+ * ================================================ */
+/* همان اندازه‌ای که Gen_Write در بخش .cards می‌گذارد */
+static uint32_t Gen_FlashBytes(void)
+{
+    return table.bucketCount * CARDS_SLOTS_PER_BUCKET * (uint32_t)(sizeof(uint32_t) + sizeof(uint16_t));
+}
+
+static void Gen_Stats(FILE *out)
+{
+    uint32_t slots = table.bucketCount * CARDS_SLOTS_PER_BUCKET;
+    uint32_t falseHits = 0;
+
+    for (uint32_t i = 0; i < CARDS_GEN_PROBES; i++) {
+        CardUid_t uid = {4, {0}};
+        uint16_t attr;
+        uint32_t r = Gen_Rand();
+        uid.bytes[0] = 0xF0;                    /* خارج از فضای UID کارت‌های تولیدشده */
+        memcpy(&uid.bytes[1], &r, 3);
+        falseHits += Cards_LookupIn(&table, &uid, &attr);
+    }
+
+    fprintf(out, "%lu cards, %lu buckets x %d slots, load %.1f%%, %lu bytes of flash\n",
+            (unsigned long)cardCount, (unsigned long)table.bucketCount, CARDS_SLOTS_PER_BUCKET,
+            100.0 * cardCount / (slots ? slots : 1),
+            (unsigned long)Gen_FlashBytes());
+    fprintf(out, "%lu of %d unknown UIDs falsely matched\n", (unsigned long)falseHits, CARDS_GEN_PROBES);
+    if (Gen_FlashBytes() > CARDS_FLASH_BUDGET) {
+        fprintf(out, "warning: table exceeds CARDS_FLASH_BUDGET (%lu bytes); the firmware will not link\n",
+                (unsigned long)CARDS_FLASH_BUDGET);
+    }
+}
+
+static void Gen_Write(const char *source)
+{
+    uint32_t slots = table.bucketCount * CARDS_SLOTS_PER_BUCKET;
+    uint32_t crc = Hash_Crc32(HASH_CRC_INITIAL, tags, slots * sizeof(uint32_t));
+    crc = Hash_Crc32(crc, attributes, slots * sizeof(uint16_t));
+
+    printf("/* =================================================================\n");
+    printf(" * پایگاه کارت‌ها - تولید شده با Host/cards_gen از %s؛ دستی ویرایش نشود\n", source);
+    printf(" * %lu کارت، %lu سطل\n", (unsigned long)cardCount, (unsigned long)table.bucketCount);
+    printf(" * ================================================================= */\n\n");
+    printf("#include \"cards.h\"\n\n");
+    printf("#if CARDS_STORE == CARDS_STORE_CUCKOO\n\n");
+
+    printf("CARDS_SECTION static const uint32_t tags[%lu] = {", (unsigned long)slots);
+    for (uint32_t i = 0; i < slots; i++) {
+        printf("%s%s0x%08lX", i ? "," : "", (i % 4) ? " " : "\n    ", (unsigned long)tags[i]);
+    }
+    printf("\n};\n\n");
+
+    printf("CARDS_SECTION INTEGRITY_ALIGNED static const uint16_t attributes[%lu] = {", (unsigned long)slots);
+    for (uint32_t i = 0; i < slots; i++) {
+        printf("%s%s0x%04X", i ? "," : "", (i % 8) ? " " : "\n    ", attributes[i]);
+    }
+    printf("\n};\n\n");
+
+    printf("CARDS_SECTION const CardTable_t cardsTable = {\n    {");
+    for (int k = 0; k < HASH_KEY_SIZE; k++) {
+        printf("%s0x%02X", k ? ", " : "", table.key[k]);
+    }
+    printf("},\n    %lu, %lu, tags, attributes\n};\n\n", (unsigned long)table.bucketCount, (unsigned long)cardCount);
+    printf("static const IntegritySpan_t spans[2] = {\n");
+    printf("    {tags, sizeof(tags)},\n    {attributes, sizeof(attributes)},\n};\n\n");
+    printf("const IntegrityImage_t cardsTableCrc = {spans, 2, 0x%08lX};\n\n", (unsigned long)crc);
+    printf("#endif /* CARDS_STORE_CUCKOO */\n");
+}
+
+int main(int argc, char **argv)
+{
+    int randomMode = (argc > 2 && strcmp(argv[1], "-r") == 0);
+    int seedArg = randomMode ? 3 : 2;
+
+    if (argc < 2 || (argc > 1 && strcmp(argv[1], "-r") == 0 && !randomMode)) {
+        fprintf(stderr, "usage: %s cards.txt [seed] | -r count [seed]\n", argv[0]);
+        return 2;
+    }
+    if (argc > seedArg) {
+        rngState = (uint32_t)strtoul(argv[seedArg], NULL, 0);
+    } else if ((urandom = fopen("/dev/urandom", "rb")) == NULL) {
+        perror("/dev/urandom");
+        return 1;
+    }
+
+    if (randomMode) {
+        uint32_t count = (uint32_t)strtoul(argv[2], NULL, 0);
+        if (count > CARDS_LIST_MAX) {
+            fprintf(stderr, "cards_gen: at most %d cards\n", CARDS_LIST_MAX);
+            return 1;
+        }
+        CardsList_Random(list, count, Gen_Rand);
+        Gen_Load(list, count);
+        Gen_BuildAll();
+        Gen_Stats(stdout);
+        return 0;
+    }
+
+    uint32_t count;
+    if (CardsList_Read(argv[1], list, &count) != 0 || CardsList_SortUnique(list, count) != 0) {
+        return 1;
+    }
+    Gen_Load(list, count);
+    Gen_BuildAll();
+    Gen_Stats(stderr);
+    /* جدولی که لینک نمی‌شود نوشته نمی‌شود؛ make cards همین‌جا می‌ایستد */
+    if (Gen_FlashBytes() > CARDS_FLASH_BUDGET) {
+        fprintf(stderr, "cards_gen: table not written\n");
+        return 1;
+    }
+    Gen_Write(argv[1]);
+    return 0;
+}
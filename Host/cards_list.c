@@ -0,0 +1,115 @@
+/* =================================================================
+ * خواندن فهرست کارت‌ها - مشترک بین cards_gen، cards_mph_gen و cards_pack_gen
+ * ================================================================= */
+
+#include "cards_list.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ابزارها فقط Cards_*LookupIn را روی جدول خودشان صدا می‌زنند؛ جدول‌های
+ * firmware فقط برای لینک cards.o این‌جا خالی تعریف می‌شوند */
+const CardTable_t cardsTable;
+const CardPerfectTable_t cardsPerfectTable;
+const CardPackedTable_t cardsPackedTable;
+
+static int CardsList_ParseUid(const char *text, CardUid_t *uid)
+{
+    uid->length = 0;
+    while (*text) {
+        unsigned int byte;
+        if (*text == ':') {
+            text++;
+            continue;
+        }
+        if (uid->length >= CARDS_UID_MAX || sscanf(text, "%2x", &byte) != 1 || text[1] == '\0' || text[1] == ':') {
+            return 0;
+        }
+        uid->bytes[uid->length++] = (uint8_t)byte;
+        text += 2;
+    }
+    return uid->length == 4 || uid->length == 7 || uid->length == 10;
+}
+
+int CardsList_Read(const char *path, CardsListEntry_t *list, uint32_t *count)
+{
+    FILE *f = fopen(path, "r");
+    char text[128];
+    int line = 0;
+
+    *count = 0;
+    if (f == NULL) {
+        perror(path);
+        return 1;
+    }
+
+    while (fgets(text, sizeof(text), f) != NULL) {
+        char uidText[64];
+        long attr = CARD_ATTR_ACTIVE;
+
+        line++;
+        for (char *p = text; *p; p++) {
+            if (*p == ',') {
+                *p = ' ';
+            }
+        }
+        if (text[0] == '#' || sscanf(text, "%63s %li", uidText, &attr) < 1) {
+            continue;
+        }
+        if (*count >= CARDS_LIST_MAX) {
+            fprintf(stderr, "%s:%d: too many cards\n", path, line);
+            fclose(f);
+            return 1;
+        }
+        if (!CardsList_ParseUid(uidText, &list[*count].uid)) {
+            if (line == 1) {
+                continue;                       /* سرستون CSV */
+            }
+            fprintf(stderr, "%s:%d: UID must be 4, 7 or 10 hex bytes\n", path, line);
+            fclose(f);
+            return 1;
+        }
+        list[*count].attributes = (uint16_t)attr;
+        (*count)++;
+    }
+
+    fclose(f);
+    return 0;
+}
+
+void CardsList_Random(CardsListEntry_t *list, uint32_t count, uint32_t (*random)(void))
+{
+    for (uint32_t i = 0; i < count; i++) {
+        memset(&list[i].uid, 0, sizeof(list[i].uid));
+        list[i].uid.length = 7;
+        list[i].uid.bytes[0] = 0x04;            /* سازنده NXP */
+        for (int b = 1; b < 7; b++) {
+            list[i].uid.bytes[b] = (uint8_t)random();
+        }
+        list[i].attributes = CARD_ATTR_ACTIVE;
+    }
+}
+
+/* ترتیب کلید Cards_PackedKey: اول طول، بعد بایت‌ها */
+static int CardsList_Compare(const void *a, const void *b)
+{
+    const CardUid_t *ua = &((const CardsListEntry_t *)a)->uid;
+    const CardUid_t *ub = &((const CardsListEntry_t *)b)->uid;
+
+    if (ua->length != ub->length) {
+        return (ua->length < ub->length) ? -1 : 1;
+    }
+    return memcmp(ua->bytes, ub->bytes, ua->length);
+}
+
+int CardsList_SortUnique(CardsListEntry_t *list, uint32_t count)
+{
+    qsort(list, count, sizeof(list[0]), CardsList_Compare);
+    for (uint32_t i = 1; i < count; i++) {
+        if (CardsList_Compare(&list[i - 1], &list[i]) == 0) {
+            fprintf(stderr, "duplicate UID\n");
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,28 @@
+/* =================================================================
+ * خواندن فهرست کارت‌ها برای ابزارهای تولید پایگاه کارت
+ *
+ * هر خط "<UID هگز 4/7/10 بایتی، ':' اختیاری> [ویژگی‌ها]"، با فاصله یا
+ * ',' (CSV)؛ بدون ستون ویژگی CARD_ATTR_ACTIVE. خط خالی، # و سرستون
+ * (خط اولی که UID نیست) نادیده گرفته می‌شوند.
+ * ================================================================= */
+
+#ifndef __CARDS_LIST_H
+#define __CARDS_LIST_H
+
+#include "cards.h"
+
+#define CARDS_LIST_MAX      200000
+
+typedef struct {
+    CardUid_t uid;
+    uint16_t attributes;
+} CardsListEntry_t;
+
+/* 0 در صورت موفقیت؛ خطا با نام فایل و شماره خط روی stderr */
+int CardsList_Read(const char *path, CardsListEntry_t *list, uint32_t *count);
+/* count کارت 7 بایتی NXP تصادفی و فعال */
+void CardsList_Random(CardsListEntry_t *list, uint32_t count, uint32_t (*random)(void));
+/* list را بر اساس UID مرتب می‌کند؛ 0 اگر UID تکراری نباشد */
+int CardsList_SortUnique(CardsListEntry_t *list, uint32_t count);
+
+#endif /* __CARDS_LIST_H */
@@ -0,0 +1,337 @@
+/* =================================================================
+ * تولید پایگاه کارت با درهم‌سازی کامل کمینه (Core/Src/cards_mph_table.c)
+ *
+ * ورودی: قالب cards_list.h (فاصله یا CSV). روش CHD: کارت‌ها با بخشی از
+ * درهم در سطل‌های حدود CARDS_MPH_LAMBDA تایی پخش می‌شوند؛ سطل‌ها از
+ * پرجمعیت به کم‌جمعیت پردازش و برای هر کدام کوچک‌ترین pilot یافته می‌شود که همه کارت‌هایش را
+ * به خانه‌های آزاد و متمایز ببرد. اگر pilot 16 بیتی پیدا نشد کلید جدول
+ * عوض می‌شود و بعد از چند بار، آرایه رکوردها 1% بزرگ‌تر (تقریباً کمینه).
+ * در پایان هر کارت با همان Cards_PerfectLookupIn firmware بررسی می‌شود.
+ * استفاده:
+ *   ./cards_mph_gen cards.csv [seed] > ../Core/Src/cards_mph_table.c
+ *   ./cards_mph_gen -r 100000 [seed]  فقط آمار برای N کارت تصادفی
+ * ================================================================= */
+
+#include "cards_list.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CARDS_MPH_LAMBDA    4           /* میانگین کارت در هر سطل */
+#define CARDS_MPH_PILOTS    65536
+#define CARDS_MPH_RESEEDS   8
+#define CARDS_MPH_PROBES    1000000
+
+typedef struct {
+    CardUid_t uid;
+    uint16_t attributes;
+    uint64_t hash;
+    uint32_t bucket;
+} GenCard_t;
+
+static CardsListEntry_t list[CARDS_LIST_MAX];
+static GenCard_t cards[CARDS_LIST_MAX];
+static uint32_t cardCount = 0;
+
+static uint32_t *order = NULL;          /* کارت‌ها مرتب بر اساس سطل */
+static uint32_t *bucketStart = NULL;
+static uint32_t *bucketOrder = NULL;    /* سطل‌ها از پرجمعیت به کم‌جمعیت */
+static uint16_t *pilots = NULL;
+static CardRecord_t *records = NULL;
+static uint8_t *taken = NULL;
+static CardPerfectTable_t table;
+
+static uint32_t rngState = 0;
+static FILE *urandom = NULL;
+
+static uint32_t Gen_Rand(void)
+{
+    uint32_t value;
+    if (urandom != NULL && fread(&value, sizeof(value), 1, urandom) == 1) {
+        return value;
+    }
+    rngState = rngState * 1664525U + 1013904223U;
+    return rngState ^ (rngState >> 16);
+}
+
+static void Gen_Load(const CardsListEntry_t *entries, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        cards[i].uid = entries[i].uid;
+        cards[i].attributes = entries[i].attributes;
+    }
+    cardCount = count;
+}
+
+/* ================================================
+ * ساخت جدول
+ * ================================================ */
+static int Gen_CompareBucketSize(const void *a, const void *b)
+{
+    uint32_t ba = *(const uint32_t *)a, bb = *(const uint32_t *)b;
+    uint32_t sa = bucketStart[ba + 1] - bucketStart[ba];
+    uint32_t sb = bucketStart[bb + 1] - bucketStart[bb];
+
+    if (sa != sb) {
+        return (sa > sb) ? -1 : 1;
+    }
+    return (ba > bb) - (ba < bb);
+}
+
+/* کوچک‌ترین pilot که همه کارت‌های سطل را به خانه‌های آزاد و متمایز می‌برد */
+static int Gen_PlaceBucket(uint32_t bucket)
+{
+    uint32_t first = bucketStart[bucket];
+    uint32_t size = bucketStart[bucket + 1] - first;
+    uint32_t position[64];
+
+    if (size > sizeof(position) / sizeof(position[0])) {
+        return 0;
+    }
+
+    for (uint32_t pilot = 0; pilot < CARDS_MPH_PILOTS; pilot++) {
+        uint32_t k;
+        for (k = 0; k < size; k++) {
+            uint32_t p = Cards_PerfectPosition(&table, cards[order[first + k]].hash, (uint16_t)pilot);
+            if (taken[p]) {
+                break;
+            }
+            taken[p] = 2;                       /* موقت؛ برخورد درون سطل */
+            position[k] = p;
+        }
+        if (k == size) {
+            for (k = 0; k < size; k++) {
+                const GenCard_t *c = &cards[order[first + k]];
+                CardRecord_t *r = &records[position[k]];
+                taken[position[k]] = 1;
+                r->length = c->uid.length;
+                memcpy(r->uid, c->uid.bytes, c->uid.length);
+                r->attributes = c->attributes;
+            }
+            pilots[bucket] = (uint16_t)pilot;
+            return 1;
+        }
+        while (k-- > 0) {
+            taken[position[k]] = 0;
+        }
+    }
+    return 0;
+}
+
+static int Gen_Build(uint32_t recordCount)
+{
+    uint32_t bucketCount = (cardCount + CARDS_MPH_LAMBDA - 1U) / CARDS_MPH_LAMBDA;
+
+    if (bucketCount == 0) {
+        bucketCount = 1;
+    }
+    order = realloc(order, (cardCount + 1U) * sizeof(uint32_t));
+    bucketStart = realloc(bucketStart, (bucketCount + 1U) * sizeof(uint32_t));
+    bucketOrder = realloc(bucketOrder, bucketCount * sizeof(uint32_t));
+    pilots = realloc(pilots, bucketCount * sizeof(uint16_t));
+    records = realloc(records, (recordCount + 1U) * sizeof(CardRecord_t));
+    taken = realloc(taken, recordCount + 1U);
+    if (order == NULL || bucketStart == NULL || bucketOrder == NULL || pilots == NULL || records == NULL || taken == NULL) {
+        fprintf(stderr, "cards_mph_gen: out of memory\n");
+        exit(1);
+    }
+
+    for (int k = 0; k < HASH_KEY_SIZE; k++) {
+        table.key[k] = (uint8_t)Gen_Rand();
+    }
+    table.bucketCount = bucketCount;
+    table.recordCount = recordCount;
+    table.cardCount = cardCount;
+    table.pilots = pilots;
+    table.records = records;
+
+    memset(records, 0, recordCount * sizeof(CardRecord_t));
+    memset(taken, 0, recordCount);
+    memset(pilots, 0, bucketCount * sizeof(uint16_t));
+    memset(bucketStart, 0, (bucketCount + 1U) * sizeof(uint32_t));
+
+    /* مرتب‌سازی شمارشی کارت‌ها بر اساس سطل؛ همان نگاشت Cards_PerfectLookupIn */
+    for (uint32_t i = 0; i < cardCount; i++) {
+        cards[i].hash = Cards_Hash(table.key, &cards[i].uid);
+        cards[i].bucket = (uint32_t)(((uint64_t)(uint32_t)cards[i].hash * bucketCount) >> 32);
+        bucketStart[cards[i].bucket + 1]++;
+    }
+    for (uint32_t b = 0; b < bucketCount; b++) {
+        bucketStart[b + 1] += bucketStart[b];
+        bucketOrder[b] = bucketStart[b];        /* موقتاً مکان پرکردن سطل */
+    }
+    for (uint32_t i = 0; i < cardCount; i++) {
+        order[bucketOrder[cards[i].bucket]++] = i;
+    }
+    for (uint32_t b = 0; b < bucketCount; b++) {
+        bucketOrder[b] = b;
+    }
+
+    qsort(bucketOrder, bucketCount, sizeof(uint32_t), Gen_CompareBucketSize);
+    for (uint32_t b = 0; b < bucketCount; b++) {
+        if (!Gen_PlaceBucket(bucketOrder[b])) {
+            return 0;
+        }
+    }
+
+    for (uint32_t i = 0; i < cardCount; i++) {
+        uint16_t attr;
+        if (!Cards_PerfectLookupIn(&table, &cards[i].uid, &attr) || attr != cards[i].attributes) {
+            fprintf(stderr, "cards_mph_gen: self-check failed\n");
+            exit(1);
+        }
+    }
+    return 1;
+}
+
+static void Gen_BuildAll(void)
+{
+    uint32_t recordCount = cardCount ? cardCount : 1U;
+
+    for (;;) {
+        for (int attempt = 0; attempt < CARDS_MPH_RESEEDS; attempt++) {
+            if (Gen_Build(recordCount)) {
+                return;
+            }
+        }
+        recordCount += recordCount / 100U + 1U;
+    }
+}
+
+/* ================================================
+ * خروجی
+ * ================================================ */
+/* همان اندازه‌ای که Gen_Write در بخش .cards می‌گذارد */
+static uint32_t Gen_FlashBytes(void)
+{
+    return table.recordCount * (uint32_t)sizeof(CardRecord_t) + table.bucketCount * (uint32_t)sizeof(uint16_t);
+}
+
+static void Gen_Stats(FILE *out, double seconds)
+{
+    uint32_t falseHits = 0, maxPilot = 0;
+    double pilotSum = 0;
+
+    for (uint32_t b = 0; b < table.bucketCount; b++) {
+        pilotSum += pilots[b];
+        if (pilots[b] > maxPilot) {
+            maxPilot = pilots[b];
+        }
+    }
+    for (uint32_t i = 0; i < CARDS_MPH_PROBES; i++) {
+        CardUid_t uid = {4, {0}};
+        uint16_t attr;
+        uint32_t r = Gen_Rand();
+        uid.bytes[0] = 0xF0;                    /* خارج از فضای UID کارت‌های تولیدشده */
+        memcpy(&uid.bytes[1], &r, 3);
+        falseHits += Cards_PerfectLookupIn(&table, &uid, &attr);
+    }
+
+    fprintf(out, "%lu cards, %lu records, %lu buckets (pilot mean %.1f, max %lu), %lu bytes of flash, built in %.2f s\n",
+            (unsigned long)cardCount, (unsigned long)table.recordCount, (unsigned long)table.bucketCount,
+            pilotSum / table.bucketCount, (unsigned long)maxPilot,
+            (unsigned long)Gen_FlashBytes(),
+            seconds);
+    fprintf(out, "%lu of %d unknown UIDs falsely matched\n", (unsigned long)falseHits, CARDS_MPH_PROBES);
+    if (Gen_FlashBytes() > CARDS_FLASH_BUDGET) {
+        fprintf(out, "warning: table exceeds CARDS_FLASH_BUDGET (%lu bytes); the firmware will not link\n",
+                (unsigned long)CARDS_FLASH_BUDGET);
+    }
+}
+
+static void Gen_Write(const char *source)
+{
+    static const CardRecord_t zero;
+    /* عنصر صفر اضافه تا آرایه به مضرب 4 بایت برسد (IntegritySpan_t) */
+    uint32_t pilotCount = table.bucketCount + (table.bucketCount & 1U);
+    uint32_t recordBytes = table.recordCount * sizeof(CardRecord_t);
+    uint32_t recordCount = table.recordCount + ((recordBytes % 4U) ? 1U : 0U);
+    uint32_t crc = Hash_Crc32(HASH_CRC_INITIAL, pilots, table.bucketCount * sizeof(uint16_t));
+    crc = Hash_Crc32(crc, records, recordBytes);
+
+    printf("/* =================================================================\n");
+    printf(" * پایگاه کارت (درهم‌سازی کامل) - تولید شده با Host/cards_mph_gen از %s؛ دستی ویرایش نشود\n", source);
+    printf(" * %lu کارت، %lu رکورد، %lu سطل\n", (unsigned long)cardCount,
+           (unsigned long)table.recordCount, (unsigned long)table.bucketCount);
+    printf(" * ================================================================= */\n\n");
+    printf("#include \"cards.h\"\n\n");
+    printf("#if CARDS_STORE == CARDS_STORE_PERFECT\n\n");
+
+    printf("CARDS_SECTION INTEGRITY_ALIGNED static const uint16_t pilots[%lu] = {", (unsigned long)pilotCount);
+    for (uint32_t b = 0; b < pilotCount; b++) {
+        printf("%s%s%u", b ? "," : "", (b % 16) ? " " : "\n    ", b < table.bucketCount ? pilots[b] : 0U);
+    }
+    printf("\n};\n\n");
+
+    printf("CARDS_SECTION INTEGRITY_ALIGNED static const CardRecord_t records[%lu] = {\n", (unsigned long)recordCount);
+    for (uint32_t i = 0; i < recordCount; i++) {
+        const CardRecord_t *r = (i < table.recordCount) ? &records[i] : &zero;
+        printf("    {%u, {", r->length);
+        for (int b = 0; b < CARDS_UID_MAX; b++) {
+            printf("%s0x%02X", b ? ", " : "", r->uid[b]);
+        }
+        printf("}, 0, 0x%04X},\n", r->attributes);
+    }
+    printf("};\n\n");
+
+    printf("CARDS_SECTION const CardPerfectTable_t cardsPerfectTable = {\n    {");
+    for (int k = 0; k < HASH_KEY_SIZE; k++) {
+        printf("%s0x%02X", k ? ", " : "", table.key[k]);
+    }
+    printf("},\n    %lu, %lu, %lu, pilots, records\n};\n\n", (unsigned long)table.bucketCount,
+           (unsigned long)table.recordCount, (unsigned long)cardCount);
+    printf("static const IntegritySpan_t spans[2] = {\n");
+    printf("    {pilots, %lu},\n", (unsigned long)((table.bucketCount * sizeof(uint16_t) + 3U) & ~3U));
+    printf("    {records, %lu},\n};\n\n", (unsigned long)((recordBytes + 3U) & ~3U));
+    printf("const IntegrityImage_t cardsTableCrc = {spans, 2, 0x%08lX};\n\n", (unsigned long)crc);
+    printf("#endif /* CARDS_STORE_PERFECT */\n");
+}
+
+int main(int argc, char **argv)
+{
+    int randomMode = (argc > 2 && strcmp(argv[1], "-r") == 0);
+    int seedArg = randomMode ? 3 : 2;
+    clock_t start;
+
+    if (argc < 2 || (strcmp(argv[1], "-r") == 0 && !randomMode)) {
+        fprintf(stderr, "usage: %s cards.csv [seed] | -r count [seed]\n", argv[0]);
+        return 2;
+    }
+    if (argc > seedArg) {
+        rngState = (uint32_t)strtoul(argv[seedArg], NULL, 0);
+    } else if ((urandom = fopen("/dev/urandom", "rb")) == NULL) {
+        perror("/dev/urandom");
+        return 1;
+    }
+
+    uint32_t count;
+    if (randomMode) {
+        count = (uint32_t)strtoul(argv[2], NULL, 0);
+        if (count > CARDS_LIST_MAX) {
+            fprintf(stderr, "cards_mph_gen: at most %d cards\n", CARDS_LIST_MAX);
+            return 1;
+        }
+        CardsList_Random(list, count, Gen_Rand);
+    } else if (CardsList_Read(argv[1], list, &count) != 0) {
+        return 1;
+    }
+    /* UID تکراری هیچ pilot ای ندارد */
+    if (CardsList_SortUnique(list, count) != 0) {
+        return 1;
+    }
+    Gen_Load(list, count);
+
+    start = clock();
+    Gen_BuildAll();
+    Gen_Stats(randomMode ? stdout : stderr, (double)(clock() - start) / CLOCKS_PER_SEC);
+    if (!randomMode) {
+        /* جدولی که لینک نمی‌شود نوشته نمی‌شود؛ make cards-mph همین‌جا می‌ایستد */
+        if (Gen_FlashBytes() > CARDS_FLASH_BUDGET) {
+            fprintf(stderr, "cards_mph_gen: table not written\n");
+            return 1;
+        }
+        Gen_Write(argv[1]);
+    }
+    return 0;
+}
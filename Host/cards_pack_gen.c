@@ -0,0 +1,369 @@
+/* =================================================================
+ * تولید پایگاه کارت فشرده (Core/Src/cards_packed_table.c)
+ *
+ * ورودی: قالب cards_list.h (فاصله یا CSV). کلیدها مرتب و در بلوک‌های
+ * CARDS_PACKED_BLOCK تایی با Elias-Fano کد می‌شوند؛ l هر بلوک از فاصله
+ * کلیدهای همان بلوک، پس خوشه‌های 4 و 7 بایتی هر کدام چگالی خودشان را
+ * دارند. UID های 10 بایتی در فهرست مرتب جدا می‌مانند.
+ * در پایان هر کارت با همان Cards_PackedLookupIn firmware بررسی و
+ * کارت‌های تصادفی با جست‌وجوی دودویی در فهرست مقایسه می‌شوند.
+ * استفاده:
+ *   ./cards_pack_gen cards.csv > ../Core/Src/cards_packed_table.c
+ *   ./cards_pack_gen -r 100000 [seed]  فقط آمار برای N کارت تصادفی
+ * ================================================================= */
+
+#include "cards_list.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CARDS_PACK_PROBES   1000000
+
+static CardsListEntry_t list[CARDS_LIST_MAX];
+static uint32_t packedCount = 0;        /* کارت‌های 4 و 7 بایتی، اول فهرست */
+static uint32_t overflowCount = 0;
+
+static CardBlock_t *blocks = NULL;
+static uint32_t blockCount = 0;
+static uint32_t *bits = NULL;
+static uint32_t bitCount = 0;
+static uint32_t *attributeIndex = NULL;
+static uint16_t palette[CARDS_PACKED_ATTR_MAX];
+static uint8_t paletteSize = 0;
+static uint8_t attributeBits = 0;
+static CardRecord_t *overflow = NULL;
+static CardPackedTable_t table;
+
+static uint32_t rngState = 0;
+static FILE *urandom = NULL;
+
+static uint32_t Gen_Rand(void)
+{
+    uint32_t value;
+    if (urandom != NULL && fread(&value, sizeof(value), 1, urandom) == 1) {
+        return value;
+    }
+    rngState = rngState * 1664525U + 1013904223U;
+    return rngState ^ (rngState >> 16);
+}
+
+static void *Gen_Alloc(size_t size)
+{
+    void *p = calloc(1, size ? size : 1);
+    if (p == NULL) {
+        fprintf(stderr, "cards_pack_gen: out of memory\n");
+        exit(1);
+    }
+    return p;
+}
+
+/* بیت‌ها از کم‌ارزش به پرارزش هر کلمه، مثل Cards_ReadBits */
+static void Gen_PutBits(uint32_t *out, uint32_t pos, uint64_t value, uint8_t width)
+{
+    for (uint8_t i = 0; i < width; i++, pos++) {
+        if ((value >> i) & 1U) {
+            out[pos >> 5] |= 1UL << (pos & 31U);
+        }
+    }
+}
+
+static uint8_t Gen_Log2(uint64_t x)
+{
+    uint8_t l = 0;
+    while (x > 1) {
+        x >>= 1;
+        l++;
+    }
+    return l;
+}
+
+/* ================================================
+ * ساخت جدول
+ * ================================================ */
+static int Gen_Palette(void)
+{
+    for (uint32_t i = 0; i < packedCount; i++) {
+        uint8_t p = 0;
+        while (p < paletteSize && palette[p] != list[i].attributes) {
+            p++;
+        }
+        if (p == paletteSize) {
+            if (paletteSize == CARDS_PACKED_ATTR_MAX) {
+                fprintf(stderr, "cards_pack_gen: more than %d distinct attribute values\n", CARDS_PACKED_ATTR_MAX);
+                return 1;
+            }
+            palette[paletteSize++] = list[i].attributes;
+        }
+    }
+    attributeBits = (paletteSize > 1) ? (uint8_t)(Gen_Log2(paletteSize - 1U) + 1U) : 0;
+    return 0;
+}
+
+static void Gen_Build(void)
+{
+    /* بدترین حالت هر بلوک: 63 بیت پایین و 3 بیت یگانی برای هر کارت */
+    uint32_t words = (packedCount * 66U) / 32U + 3U;
+
+    blockCount = (packedCount + CARDS_PACKED_BLOCK - 1U) / CARDS_PACKED_BLOCK;
+    blocks = Gen_Alloc(blockCount * sizeof(CardBlock_t));
+    bits = Gen_Alloc(words * sizeof(uint32_t));
+    attributeIndex = Gen_Alloc(((packedCount * attributeBits) / 32U + 3U) * sizeof(uint32_t));
+    overflow = Gen_Alloc(overflowCount * sizeof(CardRecord_t));
+
+    for (uint32_t b = 0; b < blockCount; b++) {
+        uint32_t start = b * CARDS_PACKED_BLOCK;
+        uint32_t k = (packedCount - start < CARDS_PACKED_BLOCK) ? packedCount - start : CARDS_PACKED_BLOCK;
+        uint64_t first = Cards_PackedKey(&list[start].uid);
+        uint64_t span = Cards_PackedKey(&list[start + k - 1U].uid) - first;
+        uint8_t l = (k > 1 && span / (k - 1U) > 0) ? Gen_Log2(span / (k - 1U)) : 0;
+        CardBlock_t *block = &blocks[b];
+
+        block->first = first;
+        block->bitOffset = bitCount;
+        block->lowBits = l;
+        block->count = (uint8_t)k;
+        block->upperLength = (uint16_t)((span >> l) + (k - 1U));
+
+        uint32_t upper = bitCount + (k - 1U) * l;
+        for (uint32_t i = 1; i < k; i++) {
+            uint64_t d = Cards_PackedKey(&list[start + i].uid) - first;
+            Gen_PutBits(bits, bitCount + (i - 1U) * l, d, l);
+            Gen_PutBits(bits, upper + (uint32_t)(d >> l) + (i - 1U), 1, 1);
+        }
+        bitCount = upper + block->upperLength;
+    }
+
+    for (uint32_t i = 0; i < packedCount; i++) {
+        uint8_t p = 0;
+        while (palette[p] != list[i].attributes) {
+            p++;
+        }
+        Gen_PutBits(attributeIndex, i * attributeBits, p, attributeBits);
+    }
+
+    for (uint32_t i = 0; i < overflowCount; i++) {
+        const CardsListEntry_t *c = &list[packedCount + i];
+        overflow[i].length = c->uid.length;
+        memcpy(overflow[i].uid, c->uid.bytes, CARDS_UID_MAX);
+        overflow[i].attributes = c->attributes;
+    }
+
+    table.cardCount = packedCount + overflowCount;
+    table.blockCount = blockCount;
+    table.blocks = blocks;
+    table.bits = bits;
+    table.attributeBits = attributeBits;
+    table.palette = palette;
+    table.attributeIndex = attributeIndex;
+    table.overflowCount = overflowCount;
+    table.overflow = overflow;
+}
+
+static int Gen_CompareEntry(const void *a, const void *b)
+{
+    const CardUid_t *ua = &((const CardsListEntry_t *)a)->uid;
+    const CardUid_t *ub = &((const CardsListEntry_t *)b)->uid;
+
+    if (ua->length != ub->length) {
+        return (ua->length < ub->length) ? -1 : 1;
+    }
+    return memcmp(ua->bytes, ub->bytes, ua->length);
+}
+
+static int Gen_Check(void)
+{
+    for (uint32_t i = 0; i < table.cardCount; i++) {
+        uint16_t attr;
+        if (!Cards_PackedLookupIn(&table, &list[i].uid, &attr) || attr != list[i].attributes) {
+            fprintf(stderr, "cards_pack_gen: self-check failed at card %lu\n", (unsigned long)i);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* ================================================
+ * خروجی
+ * ================================================ */
+static uint32_t Gen_FlashBytes(void)
+{
+    return blockCount * (uint32_t)sizeof(CardBlock_t) + ((bitCount + 31U) / 32U + 2U) * 4U +
+           ((packedCount * attributeBits + 31U) / 32U + 2U) * 4U + paletteSize * 2U +
+           overflowCount * (uint32_t)sizeof(CardRecord_t);
+}
+
+static int Gen_Stats(FILE *out)
+{
+    static CardsListEntry_t probes[CARDS_PACK_PROBES];
+    static uint8_t found[CARDS_PACK_PROBES];
+    uint32_t wrong = 0, hits = 0;
+
+    /* یک سوم کارت واقعی، یک سوم همسایه نزدیک، یک سوم تصادفی هم‌خوشه */
+    for (uint32_t i = 0; i < CARDS_PACK_PROBES; i++) {
+        if (packedCount > 0 && i % 3U != 2U) {
+            probes[i] = list[Gen_Rand() % packedCount];
+            if (i % 3U == 1U) {
+                probes[i].uid.bytes[probes[i].uid.length - 1U] ^= (uint8_t)(1U + Gen_Rand() % 255U);
+            }
+        } else {
+            CardsList_Random(&probes[i], 1, Gen_Rand);
+        }
+    }
+
+    clock_t start = clock();
+    for (uint32_t i = 0; i < CARDS_PACK_PROBES; i++) {
+        uint16_t attr;
+        found[i] = Cards_PackedLookupIn(&table, &probes[i].uid, &attr);
+    }
+    double ns = 1e9 * (double)(clock() - start) / CLOCKS_PER_SEC / CARDS_PACK_PROBES;
+
+    for (uint32_t i = 0; i < CARDS_PACK_PROBES; i++) {
+        uint8_t truth = bsearch(&probes[i], list, packedCount, sizeof(list[0]), Gen_CompareEntry) != NULL;
+        wrong += (found[i] != truth);
+        hits += found[i];
+    }
+
+    fprintf(out, "%lu cards (%lu of 10 bytes), %lu blocks, %u attribute bits, %lu bytes of flash (%.1f bits/card)\n",
+            (unsigned long)table.cardCount, (unsigned long)overflowCount, (unsigned long)blockCount, attributeBits,
+            (unsigned long)Gen_FlashBytes(), table.cardCount ? 8.0 * Gen_FlashBytes() / table.cardCount : 0.0);
+    fprintf(out, "%lu probes, %lu present, %lu wrong answers, %.0f ns per lookup on host\n",
+            (unsigned long)CARDS_PACK_PROBES, (unsigned long)hits, (unsigned long)wrong, ns);
+    if (Gen_FlashBytes() > CARDS_FLASH_BUDGET) {
+        fprintf(out, "warning: table exceeds CARDS_FLASH_BUDGET (%lu bytes); the firmware will not link\n",
+                (unsigned long)CARDS_FLASH_BUDGET);
+    }
+    return wrong != 0;
+}
+
+static void Gen_Write(const char *source)
+{
+    uint32_t words = (bitCount + 31U) / 32U + 2U;
+    uint32_t attrWords = (packedCount * attributeBits + 31U) / 32U + 2U;
+    /* عنصر صفر اضافه تا آرایه به مضرب 4 بایت برسد (IntegritySpan_t) */
+    uint32_t paletteCount = paletteSize + (paletteSize & 1U);
+    uint32_t overflowBytes = overflowCount * sizeof(CardRecord_t);
+    uint32_t overflowPad = (overflowBytes % 4U) ? 1U : 0U;
+    uint32_t crc = Hash_Crc32(HASH_CRC_INITIAL, blocks, blockCount * sizeof(CardBlock_t));
+    crc = Hash_Crc32(crc, bits, words * sizeof(uint32_t));
+    crc = Hash_Crc32(crc, palette, paletteSize * sizeof(uint16_t));
+    crc = Hash_Crc32(crc, attributeIndex, attrWords * sizeof(uint32_t));
+    crc = Hash_Crc32(crc, overflow, overflowBytes);
+
+    printf("/* =================================================================\n");
+    printf(" * پایگاه کارت فشرده - تولید شده با Host/cards_pack_gen از %s؛ دستی ویرایش نشود\n", source);
+    printf(" * %lu کارت، %lu بلوک، %lu بایت\n", (unsigned long)table.cardCount,
+           (unsigned long)blockCount, (unsigned long)Gen_FlashBytes());
+    printf(" * ================================================================= */\n\n");
+    printf("#include \"cards.h\"\n\n");
+    printf("#if CARDS_STORE == CARDS_STORE_PACKED\n\n");
+
+    /* آرایه خالی در C مجاز نیست */
+    printf("CARDS_SECTION static const CardBlock_t blocks[%lu] = {\n", (unsigned long)(blockCount ? blockCount : 1U));
+    for (uint32_t b = 0; b < blockCount; b++) {
+        printf("    {0x%016llXULL, %lu, %u, %u, %u},\n", (unsigned long long)blocks[b].first,
+               (unsigned long)blocks[b].bitOffset, blocks[b].upperLength, blocks[b].lowBits, blocks[b].count);
+    }
+    if (blockCount == 0) {
+        printf("    {0, 0, 0, 0, 0},\n");
+    }
+    printf("};\n\n");
+
+    printf("CARDS_SECTION static const uint32_t bits[%lu] = {", (unsigned long)words);
+    for (uint32_t i = 0; i < words; i++) {
+        printf("%s%s0x%08lX", i ? "," : "", (i % 6) ? " " : "\n    ", (unsigned long)bits[i]);
+    }
+    printf("\n};\n\n");
+
+    printf("CARDS_SECTION INTEGRITY_ALIGNED static const uint16_t palette[%lu] = {", (unsigned long)(paletteCount ? paletteCount : 1U));
+    for (uint32_t p = 0; p < paletteCount; p++) {
+        printf("%s0x%04X", p ? ", " : "", p < paletteSize ? palette[p] : 0U);
+    }
+    printf("%s};\n\n", paletteSize ? "" : "CARD_ATTR_NONE");
+
+    printf("CARDS_SECTION static const uint32_t attributeIndex[%lu] = {", (unsigned long)attrWords);
+    for (uint32_t i = 0; i < attrWords; i++) {
+        printf("%s%s0x%08lX", i ? "," : "", (i % 6) ? " " : "\n    ", (unsigned long)attributeIndex[i]);
+    }
+    printf("\n};\n\n");
+
+    printf("CARDS_SECTION INTEGRITY_ALIGNED static const CardRecord_t overflow[%lu] = {\n",
+           (unsigned long)(overflowCount ? overflowCount + overflowPad : 1U));
+    for (uint32_t i = 0; i < overflowCount; i++) {
+        printf("    {%u, {", overflow[i].length);
+        for (int b = 0; b < CARDS_UID_MAX; b++) {
+            printf("%s0x%02X", b ? ", " : "", overflow[i].uid[b]);
+        }
+        printf("}, 0, 0x%04X},\n", overflow[i].attributes);
+    }
+    if (overflowCount == 0 || overflowPad) {
+        printf("    {0, {0}, 0, CARD_ATTR_NONE},\n");
+    }
+    printf("};\n\n");
+
+    printf("CARDS_SECTION const CardPackedTable_t cardsPackedTable = {\n");
+    printf("    %lu, %lu, blocks, bits,\n", (unsigned long)table.cardCount, (unsigned long)blockCount);
+    printf("    %u, palette, attributeIndex,\n", attributeBits);
+    printf("    %lu, overflow\n};\n\n", (unsigned long)overflowCount);
+    printf("static const IntegritySpan_t spans[5] = {\n");
+    printf("    {blocks, %lu},\n", (unsigned long)(blockCount * sizeof(CardBlock_t)));
+    printf("    {bits, sizeof(bits)},\n");
+    printf("    {palette, %lu},\n", (unsigned long)((paletteSize * sizeof(uint16_t) + 3U) & ~3U));
+    printf("    {attributeIndex, sizeof(attributeIndex)},\n");
+    printf("    {overflow, %lu},\n};\n\n", (unsigned long)((overflowBytes + 3U) & ~3U));
+    printf("const IntegrityImage_t cardsTableCrc = {spans, 5, 0x%08lX};\n\n", (unsigned long)crc);
+    printf("#endif /* CARDS_STORE_PACKED */\n");
+}
+
+int main(int argc, char **argv)
+{
+    int randomMode = (argc > 2 && strcmp(argv[1], "-r") == 0);
+    uint32_t count;
+
+    if (argc < 2 || (strcmp(argv[1], "-r") == 0 && !randomMode)) {
+        fprintf(stderr, "usage: %s cards.csv | -r count [seed]\n", argv[0]);
+        return 2;
+    }
+    if (randomMode && argc > 3) {
+        rngState = (uint32_t)strtoul(argv[3], NULL, 0);
+    } else if ((urandom = fopen("/dev/urandom", "rb")) == NULL) {
+        perror("/dev/urandom");
+        return 1;
+    }
+
+    if (randomMode) {
+        count = (uint32_t)strtoul(argv[2], NULL, 0);
+        if (count > CARDS_LIST_MAX) {
+            fprintf(stderr, "cards_pack_gen: at most %d cards\n", CARDS_LIST_MAX);
+            return 1;
+        }
+        CardsList_Random(list, count, Gen_Rand);
+    } else if (CardsList_Read(argv[1], list, &count) != 0) {
+        return 1;
+    }
+    /* ترتیب فهرست همان ترتیب کلید است: 4 بایتی، 7 بایتی، بعد 10 بایتی */
+    if (CardsList_SortUnique(list, count) != 0) {
+        return 1;
+    }
+    while (packedCount < count && list[packedCount].uid.length != CARDS_UID_MAX) {
+        packedCount++;
+    }
+    overflowCount = count - packedCount;
+
+    if (Gen_Palette() != 0) {
+        return 1;
+    }
+    Gen_Build();
+    if (Gen_Check() != 0 || Gen_Stats(randomMode ? stdout : stderr) != 0) {
+        return 1;
+    }
+    if (!randomMode) {
+        /* جدولی که لینک نمی‌شود نوشته نمی‌شود؛ make cards-packed همین‌جا می‌ایستد */
+        if (Gen_FlashBytes() > CARDS_FLASH_BUDGET) {
+            fprintf(stderr, "cards_pack_gen: table not written\n");
+            return 1;
+        }
+        Gen_Write(argv[1]);
+    }
+    return 0;
+}
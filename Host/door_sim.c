@@ -0,0 +1,185 @@
+/* =================================================================
+ * شبیه‌سازی ترافیک روزانه در روی شبیه‌ساز رویداد-گسسته
+ *
+ * هر «مراجعه» با فاصله تصادفی می‌رسد و یکی از این کارها را می‌کند:
+ *   ورود رمز صحیح (مسلح/غیرمسلح کردن)، رمز اشتباه و سپس صحیح،
+ *   کارت مجاز، کارت غیرمجاز، عبور از جلوی PIR
+ * اگر سیستم در آلارم باشد، مراجعه بعدی رمز صحیح را وارد می‌کند.
+ * استفاده:
+ *   ./door_sim [روز] [seed]
+ * ================================================================= */
+
+#include "main.h"
+#include "app.h"
+#include "scheduler.h"
+#include "keypad.h"
+#include "hd44780.h"
+#include "timing.h"
+#include "buzzer.h"
+#include "leds.h"
+#include "security.h"
+#include "power.h"
+#include "eventlog.h"
+#include "eeprom.h"
+#include "config.h"
+#include "integrity.h"
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define US_PER_MS       1000ULL
+#define US_PER_SEC      1000000ULL
+#define US_PER_DAY      (86400ULL * US_PER_SEC)
+
+#define VISIT_GAP_MIN_S     60
+#define VISIT_GAP_MAX_S     1800
+#define VISIT_SETTLE_US     (5 * US_PER_SEC)    /* فرصت پایان پیام‌ها و timeout ها */
+
+static uint32_t rngState = 1;
+static uint32_t visits = 0;
+static uint32_t alarms = 0;
+
+/* LCG ساده تا نتایج با یک seed تکرارپذیر باشد */
+static uint32_t Rand(void)
+{
+    rngState = rngState * 1664525U + 1013904223U;
+    return rngState >> 8;
+}
+
+static uint32_t RandRange(uint32_t min, uint32_t max)
+{
+    return min + Rand() % (max - min + 1);
+}
+
+/* ================================================
+ * تولید ورودی‌ها؛ هر تابع زمان پایان را برمی‌گرداند
+ * ================================================ */
+static uint64_t Visit_Type(uint64_t t, const char *keys)
+{
+    while (*keys) {
+        uint64_t hold = RandRange(80, 160) * US_PER_MS;
+        Sim_Schedule(t, SIM_KEY_DOWN, *keys);
+        Sim_Schedule(t + hold, SIM_KEY_UP, *keys);
+        t += hold + RandRange(150, 400) * US_PER_MS;
+        keys++;
+    }
+    return t;
+}
+
+static uint64_t Visit_Card(uint64_t t, char card)
+{
+    uint64_t hold = RandRange(200, 600) * US_PER_MS;
+    Sim_Schedule(t, SIM_CARD_ON, card);
+    Sim_Schedule(t + hold, SIM_CARD_OFF, card);
+    return t + hold;
+}
+
+static uint64_t Visit_Motion(uint64_t t)
+{
+    uint64_t hold = RandRange(1, 5) * US_PER_SEC;
+    Sim_Schedule(t, SIM_PIR_ON, 0);
+    Sim_Schedule(t + hold, SIM_PIR_OFF, 0);
+    return t + hold;
+}
+
+/* زمان پایان ورودی‌های این مراجعه را برمی‌گرداند */
+static uint64_t Visit_Next(uint64_t now)
+{
+    uint64_t t = now + RandRange(VISIT_GAP_MIN_S, VISIT_GAP_MAX_S) * US_PER_SEC;
+    uint32_t roll = Rand() % 100;
+
+    visits++;
+
+    if (Security_GetState() == SYSTEM_ALARM) {
+        alarms++;
+        return Visit_Type(now + RandRange(10, 40) * US_PER_SEC, "1234");
+    }
+
+    if (roll < 50) {
+        return Visit_Type(t, "1234");
+    } else if (roll < 65) {
+        t = Visit_Type(t, "1111");
+        return Visit_Type(t + (SECURITY_PIN_SHOW_MS + SECURITY_DENIED_SHOW_MS + 500) * US_PER_MS, "1234");
+    } else if (roll < 80) {
+        return Visit_Card(t, (char)RandRange(1, 2));
+    } else if (roll < 95) {
+        return Visit_Motion(t);
+    }
+    return Visit_Card(t, 3);
+}
+
+static void Print_Latency(const char *name, SimClass_t cls)
+{
+    const SimLatency_t *l = Sim_GetLatency(cls);
+
+    if (l->count == 0) {
+        printf("  %-7s      -\n", name);
+        return;
+    }
+    printf("  %-7s %7lu   min %6lu us   avg %6lu us   max %6lu us   lost %lu\n", name,
+           (unsigned long)l->count, (unsigned long)l->minUs,
+           (unsigned long)(l->totalUs / l->count), (unsigned long)l->maxUs, (unsigned long)l->lost);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t days = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 1;
+    rngState = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 1;
+
+    Mock_Reset();
+    Mock_FlashReset();
+    Timing_Init();
+    Buzzer_Init();
+    Leds_Init();
+    Keypad_Init();
+    LCD_Init();
+    Integrity_Init();
+    Eeprom_Init();
+    EventLog_Init();
+    Config_Init();
+    Security_Init();
+    App_StartTasks();
+    Sim_Init();
+
+    uint64_t end = days * US_PER_DAY;
+    clock_t start = clock();
+
+    while (Mock_Micros() < end) {
+        uint64_t visitEnd = Visit_Next(Mock_Micros()) + VISIT_SETTLE_US;
+        Sim_RunUntil(visitEnd < end ? visitEnd : end);
+    }
+
+    double wallMs = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+    const PowerStats_t *power = Power_GetStats();
+    EventLogStats_t log;
+    EventLog_GetStats(&log);
+    EepromStats_t eeprom;
+    Eeprom_GetStats(&eeprom);
+    IntegrityStats_t integrity;
+    Integrity_GetStats(&integrity);
+
+    printf("simulated %lu day(s): %lu visits, %lu stimuli, %lu alarms silenced\n",
+           (unsigned long)days, (unsigned long)visits, (unsigned long)Sim_GetStimuli(), (unsigned long)alarms);
+    printf("wall time %.1f ms (%.0fx real time)\n", wallMs, (double)end / 1000.0 / (wallMs > 0 ? wallMs : 1));
+    printf("idle skipped %lu s in %lu jumps, %lu single-tick waits\n",
+           (unsigned long)(power->stopTimeMs / 1000U), (unsigned long)power->stopCount, (unsigned long)power->sleepCount);
+    printf("input -> state machine latency (virtual):\n");
+    Print_Latency("key", SIM_CLASS_KEY);
+    Print_Latency("card", SIM_CLASS_CARD);
+    Print_Latency("motion", SIM_CLASS_MOTION);
+    printf("final state %d, dropped events %lu\n",
+           (int)Security_GetState(), (unsigned long)(Security_GetDroppedEvents() + Keypad_GetDroppedEvents()));
+    printf("event log: %lu records in %lu commits, %lu dropped, %lu erases (max %lu ms), max commit %lu us\n",
+           (unsigned long)log.committed, (unsigned long)log.commits, (unsigned long)log.dropped,
+           (unsigned long)log.erases, (unsigned long)log.maxEraseMs, (unsigned long)Timing_CyclesToUs(log.maxCommitCycles));
+    printf("eeprom: %lu writes, %lu unchanged, %lu compactions, %lu erases, max persist %lu us\n",
+           (unsigned long)eeprom.writes, (unsigned long)eeprom.unchanged, (unsigned long)eeprom.compactions,
+           (unsigned long)eeprom.erases, (unsigned long)Timing_CyclesToUs(eeprom.maxPersistCycles));
+    printf("integrity: %lu checks, %lu mismatches, %lu log seals, %lu slices (%lu KB) at %lu KB/s, max task %lu us\n",
+           (unsigned long)integrity.checks, (unsigned long)integrity.mismatches, (unsigned long)log.seals,
+           (unsigned long)integrity.slices, (unsigned long)(integrity.bytes / 1024U),
+           (unsigned long)Integrity_ThroughputKBps(), (unsigned long)Timing_CyclesToUs(integrity.maxTaskCycles));
+
+    return 0;
+}
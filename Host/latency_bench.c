@@ -0,0 +1,143 @@
+/* =================================================================
+ * بنچمارک تأخیر ورودی -> نمایشگر روی شبیه‌ساز (زمان مجازی)
+ *
+ * هر دور همه مسیرهای bench.h را یک بار طی می‌کند و به حالت غیرمسلح
+ * برمی‌گردد:
+ *   1234 (مسلح)  -> کارت مجاز (غیرمسلح) -> 1234 (مسلح)
+ *   -> کارت غیرمجاز (آلارم) -> 1234 -> 1234 (مسلح) -> PIR (آلارم)
+ *   -> 1234 (غیرمسلح) -> 1111= (رمز اشتباه، بررسی فوری با '=')
+ * زمان هر ورودی با jitter زیر میلی‌ثانیه جابه‌جا می‌شود تا فاز آن نسبت
+ * به تسک‌ها و SysTick پخش شود. استفاده:
+ *   ./latency_bench [تعداد دور] [seed]
+ * ================================================================= */
+
+#include "main.h"
+#include "app.h"
+#include "keypad.h"
+#include "hd44780.h"
+#include "timing.h"
+#include "buzzer.h"
+#include "leds.h"
+#include "security.h"
+#include "eventlog.h"
+#include "eeprom.h"
+#include "config.h"
+#include "integrity.h"
+#include "bench.h"
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define US_PER_MS       1000ULL
+
+#define KEY_HOLD_MS     100
+#define KEY_GAP_MS      250
+#define CARD_HOLD_MS    300
+#define PIR_HOLD_MS     2000
+#define STEP_GAP_MS     500
+#define GRANTED_WAIT_MS (SECURITY_PIN_SHOW_MS + SECURITY_GRANTED_SHOW_MS + STEP_GAP_MS)
+#define DENIED_WAIT_MS  (SECURITY_PIN_SHOW_MS + SECURITY_DENIED_SHOW_MS + STEP_GAP_MS)
+
+static uint32_t rngState = 1;
+
+static uint32_t Rand(void)
+{
+    rngState = rngState * 1664525U + 1013904223U;
+    return rngState >> 8;
+}
+
+static uint64_t Jitter(uint64_t t)
+{
+    return t + Rand() % US_PER_MS;
+}
+
+/* ================================================
+ * مراحل یک دور؛ هر تابع زمان شروع مرحله بعد را برمی‌گرداند
+ * ================================================ */
+static uint64_t Step_Type(uint64_t t, const char *keys, uint32_t waitMs)
+{
+    while (*keys) {
+        t = Jitter(t);
+        Sim_Schedule(t, SIM_KEY_DOWN, *keys);
+        Sim_Schedule(t + KEY_HOLD_MS * US_PER_MS, SIM_KEY_UP, *keys);
+        t += (KEY_HOLD_MS + KEY_GAP_MS) * US_PER_MS;
+        keys++;
+    }
+    return t + waitMs * US_PER_MS;
+}
+
+static uint64_t Step_Card(uint64_t t, char card)
+{
+    t = Jitter(t);
+    Sim_Schedule(t, SIM_CARD_ON, card);
+    Sim_Schedule(t + CARD_HOLD_MS * US_PER_MS, SIM_CARD_OFF, card);
+    return t + (CARD_HOLD_MS + STEP_GAP_MS) * US_PER_MS;
+}
+
+static uint64_t Step_Motion(uint64_t t)
+{
+    t = Jitter(t);
+    Sim_Schedule(t, SIM_PIR_ON, 0);
+    Sim_Schedule(t + PIR_HOLD_MS * US_PER_MS, SIM_PIR_OFF, 0);
+    return t + (PIR_HOLD_MS + STEP_GAP_MS) * US_PER_MS;
+}
+
+static uint64_t Round_Schedule(uint64_t t)
+{
+    t = Step_Type(t, "1234", GRANTED_WAIT_MS);     /* مسلح */
+    t = Step_Card(t, 1);                           /* غیرمسلح */
+    t = Step_Type(t, "1234", GRANTED_WAIT_MS);     /* مسلح */
+    t = Step_Card(t, 3);                           /* آلارم */
+    t = Step_Type(t, "1234", GRANTED_WAIT_MS);     /* غیرمسلح */
+    t = Step_Type(t, "1234", GRANTED_WAIT_MS);     /* مسلح */
+    t = Step_Motion(t);                            /* آلارم */
+    t = Step_Type(t, "1234", GRANTED_WAIT_MS);     /* غیرمسلح */
+    t = Step_Type(t, "1111=", DENIED_WAIT_MS);     /* رمز اشتباه، برگشت به غیرمسلح */
+    return t;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t rounds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 100;
+    rngState = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 1;
+
+    Mock_Reset();
+    Mock_FlashReset();
+    Timing_Init();
+    Buzzer_Init();
+    Leds_Init();
+    Keypad_Init();
+    LCD_Init();
+    Integrity_Init();
+    Eeprom_Init();
+    EventLog_Init();
+    Config_Init();
+    Security_Init();
+    App_StartTasks();
+    Sim_Init();
+    Bench_Reset();
+
+    for (uint32_t r = 0; r < rounds; r++) {
+        Sim_RunUntil(Round_Schedule(Mock_Micros() + STEP_GAP_MS * US_PER_MS));
+        if (Security_GetState() != SYSTEM_DISARMED) {
+            printf("round %lu: expected DISARMED, got state %d\n", (unsigned long)r, (int)Security_GetState());
+            return 1;
+        }
+    }
+
+    printf("%lu round(s), input -> LCD latency (virtual, %u MHz cycles):\n",
+           (unsigned long)rounds, (unsigned)MOCK_CPU_MHZ);
+    printf("  %-11s %7s %10s %10s %10s %10s\n", "path", "count", "min us", "median us", "p99 us", "max us");
+
+    for (int p = 0; p < BENCH_PATH_COUNT; p++) {
+        BenchResult_t result;
+        if (!Bench_GetResult((BenchPath_t)p, &result)) {
+            printf("  %-11s %7s\n", Bench_PathName((BenchPath_t)p), "-");
+            continue;
+        }
+        printf("  %-11s %7lu %10lu %10lu %10lu %10lu\n", Bench_PathName((BenchPath_t)p),
+               (unsigned long)result.count, (unsigned long)result.minUs, (unsigned long)result.medianUs,
+               (unsigned long)result.p99Us, (unsigned long)result.maxUs);
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+/* =================================================================
+ * درایور بازر برای بیلد host
+ *
+ * همان صف و رفتار Buzzer_* بدون TIM3: پوشش زمانی (envelope) هر بوق
+ * با SysTick مجازی شمرده و روی پین BUZZER نوشته می‌شود؛ فرکانس
+ * شبیه‌سازی نمی‌شود.
+ * ================================================================= */
+
+#include "buzzer.h"
+
+typedef enum {
+    BUZZER_IDLE,
+    BUZZER_TONE,
+    BUZZER_GAP
+} BuzzerPhase_t;
+
+static BuzzerTone_t queue[BUZZER_QUEUE_SIZE];
+static uint8_t queueHead = 0;
+static uint8_t queueTail = 0;
+static BuzzerTone_t loopTones[BUZZER_LOOP_MAX_TONES];
+static uint8_t loopCount = 0;
+
+static BuzzerPhase_t phase = BUZZER_IDLE;
+static BuzzerTone_t current;
+static uint32_t remaining = 0;
+static uint32_t tonesPlayed = 0;
+
+static void Buzzer_NextTone(void)
+{
+    if (queueTail != queueHead) {
+        current = queue[queueTail];
+        queueTail = (queueTail + 1) & (BUZZER_QUEUE_SIZE - 1);
+    } else if (loopCount > 0) {
+        for (uint8_t i = 1; i < loopCount; i++) {
+            queue[queueHead] = loopTones[i];
+            queueHead = (queueHead + 1) & (BUZZER_QUEUE_SIZE - 1);
+        }
+        current = loopTones[0];
+    } else {
+        phase = BUZZER_IDLE;
+        HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin, GPIO_PIN_RESET);
+        return;
+    }
+
+    tonesPlayed++;
+    phase = BUZZER_TONE;
+    remaining = (current.duration > 0) ? current.duration : 1;
+    HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin, GPIO_PIN_SET);
+}
+
+void Buzzer_Init(void)
+{
+    Buzzer_Stop();
+    tonesPlayed = 0;
+}
+
+uint8_t Buzzer_Play(const BuzzerTone_t *tones, uint8_t count)
+{
+    uint8_t queued = 0;
+
+    while (queued < count) {
+        uint8_t next = (queueHead + 1) & (BUZZER_QUEUE_SIZE - 1);
+        if (next == queueTail) {
+            break;
+        }
+        queue[queueHead] = tones[queued++];
+        queueHead = next;
+    }
+    if (phase == BUZZER_IDLE) {
+        Buzzer_NextTone();
+    }
+    return queued;
+}
+
+uint8_t Buzzer_Beep(uint16_t duration)
+{
+    BuzzerTone_t tone = {0, duration, 0};
+    return Buzzer_Play(&tone, 1);
+}
+
+void Buzzer_PlayLoop(const BuzzerTone_t *tones, uint8_t count)
+{
+    if (count > BUZZER_LOOP_MAX_TONES) {
+        count = BUZZER_LOOP_MAX_TONES;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        loopTones[i] = tones[i];
+    }
+    loopCount = count;
+    if (phase == BUZZER_IDLE) {
+        Buzzer_NextTone();
+    }
+}
+
+void Buzzer_Stop(void)
+{
+    queueTail = queueHead;
+    loopCount = 0;
+    phase = BUZZER_IDLE;
+    HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin, GPIO_PIN_RESET);
+}
+
+uint8_t Buzzer_IsBusy(void)
+{
+    return phase != BUZZER_IDLE;
+}
+
+void Buzzer_IRQHandler(void)
+{
+}
+
+/* از SysTick مجازی (هر 1ms) */
+void Buzzer_HostTick(void)
+{
+    if (phase == BUZZER_IDLE || --remaining > 0) {
+        return;
+    }
+    if (phase == BUZZER_TONE && current.gap > 0) {
+        phase = BUZZER_GAP;
+        remaining = current.gap;
+        HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin, GPIO_PIN_RESET);
+    } else {
+        Buzzer_NextTone();
+    }
+}
+
+uint32_t Buzzer_HostTonesPlayed(void)
+{
+    return tonesPlayed;
+}
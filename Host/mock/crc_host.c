@@ -0,0 +1,90 @@
+/* =================================================================
+ * واحد CRC + DMA برای بیلد host
+ *
+ * CRC با Hash_Crc32 روی flash ساختگی یک‌جا حساب می‌شود و
+ * انتقال تا گذشت زمان مجازی آن «مشغول» می‌ماند. زمان هر کلمه تخمین
+ * است (خواندن flash با 2 wait state و نوشتن در CRC->DR از راه FIFO)؛
+ * عدد واقعی را Integrity_ThroughputKBps روی برد گزارش می‌کند.
+ * ================================================================= */
+
+#include "crc.h"
+#include "integrity.h"
+#include "flash_map.h"
+
+#define CRC_HOST_CYCLES_PER_WORD    6U
+
+static uint32_t value = CRC_INITIAL;
+static uint64_t busyUntil = 0;
+static uint32_t transfers = 0;
+static uint32_t lastCycles = 0;
+
+void Crc_Init(void)
+{
+    value = CRC_INITIAL;
+    busyUntil = 0;
+    transfers = 0;
+    lastCycles = 0;
+}
+
+uint8_t Crc_Start(uintptr_t address, uint32_t words, uint8_t restart)
+{
+    if (Crc_IsBusy() || words == 0 || words > CRC_MAX_WORDS) {
+        return 0;
+    }
+    if (restart) {
+        value = CRC_INITIAL;
+    }
+    value = Hash_Crc32(value, FLASH_READ_PTR(address), words * 4U);
+    lastCycles = words * CRC_HOST_CYCLES_PER_WORD;
+    busyUntil = Mock_Micros() + (lastCycles + MOCK_CPU_MHZ - 1U) / MOCK_CPU_MHZ;
+    transfers++;
+    return 1;
+}
+
+uint8_t Crc_IsBusy(void)
+{
+    return Mock_Micros() < busyUntil;
+}
+
+uint8_t Crc_LastFailed(void)
+{
+    return 0;
+}
+
+uint32_t Crc_Value(void)
+{
+    return value;
+}
+
+uint32_t Crc_Transfers(void)
+{
+    return transfers;
+}
+
+uint32_t Crc_LastCycles(void)
+{
+    return lastCycles;
+}
+
+/* CPU منتظر می‌ماند: زمان مجازی به اندازه انتقال جلو می‌رود */
+uint32_t Crc_Compute(uint32_t address, uint32_t words)
+{
+    uint8_t restart = 1;
+
+    while (words > 0) {
+        uint32_t chunk = (words > CRC_MAX_WORDS) ? CRC_MAX_WORDS : words;
+        if (Crc_IsBusy()) {
+            Mock_AdvanceUs((uint32_t)(busyUntil - Mock_Micros()));
+        }
+        Crc_Start(address, chunk, restart);
+        Mock_AdvanceUs((uint32_t)(busyUntil - Mock_Micros()));
+        address += chunk * 4U;
+        words -= chunk;
+        restart = 0;
+    }
+    return restart ? CRC_INITIAL : value;
+}
+
+void Crc_IRQHandler(void)
+{
+}
@@ -0,0 +1,15 @@
+/* =================================================================
+ * معادل stm32f4xx_it.c برای بیلد host
+ * ================================================================= */
+
+#include "main.h"
+#include "timing.h"
+#include "leds.h"
+
+void Mock_SysTickHandler(void)
+{
+    HAL_IncTick();
+    Timing_Update();
+    Leds_Tick();
+    Buzzer_HostTick();
+}
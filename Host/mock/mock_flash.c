@@ -0,0 +1,105 @@
+/* =================================================================
+ * flash ساختگی برای بیلد host
+ *
+ * آرایه 512KB به جای flash داخلی؛ HAL_FLASH_Program فقط بیت‌ها را 0
+ * می‌کند (مثل سخت‌افزار) و HAL_FLASHEx_Erase کل sector را 0xFF می‌کند.
+ * زمان مجازی به اندازه زمان معمول دیتاشیت جلو می‌رود: برنامه کردن کلمه
+ * 16us، پاک کردن sector های 16K/64K/128K به ترتیب 250/550/1000ms.
+ * محتوا با Mock_Reset پاک نمی‌شود تا راه‌اندازی دوباره شبیه‌سازی شود.
+ * ================================================================= */
+
+#include "main.h"
+#include <string.h>
+
+#define MOCK_FLASH_SIZE         0x80000UL
+#define MOCK_FLASH_SECTORS      8
+#define MOCK_FLASH_WORD_US      16U
+
+typedef struct {
+    uint32_t offset;
+    uint32_t size;
+    uint32_t eraseUs;
+} MockFlashSector_t;
+
+static const MockFlashSector_t sectorMap[MOCK_FLASH_SECTORS] = {
+    {0x00000, 0x04000, 250000},
+    {0x04000, 0x04000, 250000},
+    {0x08000, 0x04000, 250000},
+    {0x0C000, 0x04000, 250000},
+    {0x10000, 0x10000, 550000},
+    {0x20000, 0x20000, 1000000},
+    {0x40000, 0x20000, 1000000},
+    {0x60000, 0x20000, 1000000},
+};
+
+static uint8_t memory[MOCK_FLASH_SIZE];
+static uint32_t eraseCounts[MOCK_FLASH_SECTORS];
+static uint8_t locked = 1;
+
+/* flash کاملاً پاک، مثل تراشه نو */
+void Mock_FlashReset(void)
+{
+    memset(memory, 0xFF, sizeof(memory));
+    memset(eraseCounts, 0, sizeof(eraseCounts));
+    locked = 1;
+}
+
+const void* Mock_FlashPtr(uintptr_t address)
+{
+    if (address < FLASH_BASE || address >= FLASH_BASE + MOCK_FLASH_SIZE) {
+        return (const void *)address;
+    }
+    return &memory[address - FLASH_BASE];
+}
+
+uint32_t Mock_FlashEraseCount(uint32_t sector)
+{
+    return (sector < MOCK_FLASH_SECTORS) ? eraseCounts[sector] : 0;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+    locked = 0;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+    locked = 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data)
+{
+    uint32_t size = (TypeProgram == FLASH_TYPEPROGRAM_BYTE) ? 1U
+                  : (TypeProgram == FLASH_TYPEPROGRAM_HALFWORD) ? 2U
+                  : (TypeProgram == FLASH_TYPEPROGRAM_WORD) ? 4U : 8U;
+
+    if (locked || Address < FLASH_BASE || Address - FLASH_BASE + size > MOCK_FLASH_SIZE
+        || (Address & (size - 1U)) != 0) {
+        return HAL_ERROR;
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        memory[Address - FLASH_BASE + i] &= (uint8_t)(Data >> (8U * i));
+    }
+    Mock_AdvanceUs(MOCK_FLASH_WORD_US * ((size + 3U) / 4U));
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError)
+{
+    *SectorError = 0xFFFFFFFFU;
+    if (locked || pEraseInit->TypeErase != FLASH_TYPEERASE_SECTORS) {
+        return HAL_ERROR;
+    }
+    for (uint32_t s = pEraseInit->Sector; s < pEraseInit->Sector + pEraseInit->NbSectors; s++) {
+        if (s >= MOCK_FLASH_SECTORS) {
+            *SectorError = s;
+            return HAL_ERROR;
+        }
+        memset(&memory[sectorMap[s].offset], 0xFF, sectorMap[s].size);
+        eraseCounts[s]++;
+        Mock_AdvanceUs(sectorMap[s].eraseUs);
+    }
+    return HAL_OK;
+}
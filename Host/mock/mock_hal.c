@@ -0,0 +1,264 @@
+/* =================================================================
+ * HAL ساختگی - پیاده‌سازی
+ *
+ * فقط توابعی از HAL که ماژول‌های برنامه استفاده می‌کنند.
+ * وقفه‌ها هم‌زمان اجرا می‌شوند: پیشروی ساعت در delay_us یا HAL_Delay
+ * همان‌جا SysTick را صدا می‌زند، مگر PRIMASK فعال باشد که تا
+ * __set_PRIMASK(0) معوق می‌ماند.
+ * ================================================================= */
+
+#include "main.h"
+#include <string.h>
+
+GPIO_TypeDef Mock_GPIOA;
+GPIO_TypeDef Mock_GPIOB;
+GPIO_TypeDef Mock_GPIOC;
+EXTI_TypeDef Mock_EXTI;
+
+static const char keypadLayout[16] = {
+    '1', '2', '3', '+',
+    '4', '5', '6', '-',
+    '7', '8', '9', '*',
+    'C', '0', '=', '/'
+};
+
+static uint64_t micros = 0;
+static volatile uint32_t ticks = 0;
+static uint32_t primask = 0;
+static uint32_t pendingTicks = 0;
+static uint16_t keysDown = 0;       /* بیت (row*4 + col) */
+static uint64_t horizon = 0;        /* دورترین زمانی که بی‌کاری می‌تواند به آن بپرد */
+
+static void Mock_UpdateKeypad(void);
+
+void Mock_Reset(void)
+{
+    memset(&Mock_GPIOA, 0, sizeof(Mock_GPIOA));
+    memset(&Mock_GPIOB, 0, sizeof(Mock_GPIOB));
+    memset(&Mock_GPIOC, 0, sizeof(Mock_GPIOC));
+    memset(&Mock_EXTI, 0, sizeof(Mock_EXTI));
+
+    /* کارت‌ها pull-up و فعال-پایین؛ PIR فعال-بالا */
+    Mock_GPIOB.IDR = RFID_CARD1_Pin | RFID_CARD2_Pin | RFID_CARD3_Pin;
+
+    micros = 0;
+    ticks = 0;
+    primask = 0;
+    pendingTicks = 0;
+    keysDown = 0;
+    horizon = 0;
+    Mock_UpdateKeypad();
+    Mock_LcdReset();
+}
+
+/* ================================================
+ * ساعت و وقفه
+ * ================================================ */
+uint64_t Mock_Micros(void)
+{
+    return micros;
+}
+
+static void Mock_Tick(void)
+{
+    if (primask) {
+        pendingTicks++;
+        return;
+    }
+    Mock_SysTickHandler();
+}
+
+void Mock_AdvanceUs(uint32_t us)
+{
+    uint64_t target = micros + us;
+    uint64_t boundary = (micros / 1000U + 1U) * 1000U;
+
+    while (boundary <= target) {
+        micros = boundary;
+        Mock_Tick();
+        boundary += 1000U;
+    }
+    micros = target;
+}
+
+/* پرش مستقیم زمان بدون اجرای SysTick های میانی؛ فقط وقتی مجاز است که
+ * هیچ کار زمان‌داری (انیمیشن LED، بازر، ...) در جریان نباشد */
+void Mock_SkipTo(uint64_t us)
+{
+    if (us <= micros) {
+        return;
+    }
+    ticks += (uint32_t)(us / 1000U - micros / 1000U);
+    micros = us;
+}
+
+void Mock_SetHorizon(uint64_t us)
+{
+    horizon = us;
+}
+
+uint64_t Mock_Horizon(void)
+{
+    return horizon;
+}
+
+/* تا وقفه بعدی (SysTick) بخواب */
+void Mock_WaitForInterrupt(void)
+{
+    Mock_AdvanceUs(1000U - (uint32_t)(micros % 1000U));
+}
+
+void Mock_DisableIrq(void)
+{
+    primask = 1;
+}
+
+void Mock_EnableIrq(void)
+{
+    Mock_SetPrimask(0);
+}
+
+uint32_t Mock_GetPrimask(void)
+{
+    return primask;
+}
+
+void Mock_SetPrimask(uint32_t value)
+{
+    primask = value & 1U;
+    while (!primask && pendingTicks > 0) {
+        pendingTicks--;
+        Mock_SysTickHandler();
+    }
+}
+
+void HAL_IncTick(void)
+{
+    ticks++;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return ticks;
+}
+
+/* مثل HAL واقعی یک تیک اضافه برای تضمین حداقل تأخیر */
+void HAL_Delay(uint32_t Delay)
+{
+    uint32_t start = ticks;
+    uint32_t wait = Delay;
+
+    if (wait < HAL_MAX_DELAY) {
+        wait++;
+    }
+    while ((ticks - start) < wait) {
+        Mock_WaitForInterrupt();
+    }
+}
+
+/* ================================================
+ * GPIO
+ * ================================================ */
+static void Mock_PortChanged(GPIO_TypeDef *port, uint32_t oldOdr)
+{
+    if (port == GPIOA) {
+        Mock_LcdBus(oldOdr, port->ODR);
+    } else if (port == GPIOC) {
+        Mock_UpdateKeypad();
+    }
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    uint32_t oldOdr = GPIOx->ODR;
+
+    if (PinState != GPIO_PIN_RESET) {
+        GPIOx->ODR |= GPIO_Pin;
+    } else {
+        GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+    }
+    Mock_PortChanged(GPIOx, oldOdr);
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    uint32_t oldOdr = GPIOx->ODR;
+
+    GPIOx->ODR ^= GPIO_Pin;
+    Mock_PortChanged(GPIOx, oldOdr);
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+    (void)GPIOx;
+    (void)GPIO_Init;
+}
+
+void Mock_SetInput(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state)
+{
+    if (state != GPIO_PIN_RESET) {
+        port->IDR |= pin;
+    } else {
+        port->IDR &= ~(uint32_t)pin;
+    }
+}
+
+/* ================================================
+ * مدل کیپد: ردیف‌ها pull-up، ستون‌ها خروجی
+ * ================================================ */
+static void Mock_UpdateKeypad(void)
+{
+    static const uint16_t rowPins[4] = {KEYPAD_ROW1_Pin, KEYPAD_ROW2_Pin, KEYPAD_ROW3_Pin, KEYPAD_ROW4_Pin};
+    static const uint16_t colPins[4] = {KEYPAD_COL1_Pin, KEYPAD_COL2_Pin, KEYPAD_COL3_Pin, KEYPAD_COL4_Pin};
+    uint32_t oldRows = Mock_GPIOC.IDR & KEYPAD_ROW_PINS;
+    uint32_t rows = KEYPAD_ROW_PINS;
+
+    for (int i = 0; i < 16; i++) {
+        if ((keysDown & (1u << i)) && !(Mock_GPIOC.ODR & colPins[i & 3])) {
+            rows &= ~(uint32_t)rowPins[i >> 2];
+        }
+    }
+    Mock_GPIOC.IDR = (Mock_GPIOC.IDR & ~(uint32_t)(KEYPAD_ROW_PINS | KEYPAD_COL_PINS))
+                   | (Mock_GPIOC.ODR & KEYPAD_COL_PINS) | rows;
+
+    /* لبه پایین‌رونده ردیف = وقفه EXTI (مثل HAL_GPIO_EXTI_IRQHandler) */
+    uint32_t falling = oldRows & ~rows;
+    for (int r = 0; r < 4; r++) {
+        if (falling & rowPins[r]) {
+            HAL_GPIO_EXTI_Callback(rowPins[r]);
+        }
+    }
+}
+
+static int Mock_KeyIndex(char key)
+{
+    for (int i = 0; i < 16; i++) {
+        if (keypadLayout[i] == key) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void Mock_KeyDown(char key)
+{
+    int index = Mock_KeyIndex(key);
+    if (index >= 0) {
+        keysDown |= (uint16_t)(1u << index);
+        Mock_UpdateKeypad();
+    }
+}
+
+void Mock_KeyUp(char key)
+{
+    int index = Mock_KeyIndex(key);
+    if (index >= 0) {
+        keysDown &= (uint16_t)~(1u << index);
+        Mock_UpdateKeypad();
+    }
+}
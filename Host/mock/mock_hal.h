@@ -0,0 +1,79 @@
+/* =================================================================
+ * HAL ساختگی - رابط
+ *
+ * - پورت‌های GPIO مجازی (ODR/IDR) و مدل کیپد ماتریسی روی GPIOC
+ * - ساعت مجازی با دقت 1us؛ هر مرز میلی‌ثانیه یک SysTick اجرا می‌کند
+ * - مدل HD44780 که نوشتن‌های باس GPIOA را رمزگشایی و ثبت می‌کند
+ * - flash داخلی به صورت آرایه (mock_flash.c)
+ * ================================================================= */
+
+#ifndef __MOCK_HAL_H
+#define __MOCK_HAL_H
+
+#include <stdint.h>
+
+/* نمونه‌های پریفرال ساختگی */
+extern GPIO_TypeDef Mock_GPIOA;
+extern GPIO_TypeDef Mock_GPIOB;
+extern GPIO_TypeDef Mock_GPIOC;
+extern EXTI_TypeDef Mock_EXTI;
+
+#undef GPIOA
+#undef GPIOB
+#undef GPIOC
+#undef EXTI
+#define GPIOA   (&Mock_GPIOA)
+#define GPIOB   (&Mock_GPIOB)
+#define GPIOC   (&Mock_GPIOC)
+#define EXTI    (&Mock_EXTI)
+
+/* دستورهای هسته */
+#undef __WFI
+#define __WFI()             Mock_WaitForInterrupt()
+#define __disable_irq()     Mock_DisableIrq()
+#define __enable_irq()      Mock_EnableIrq()
+#define __get_PRIMASK()     Mock_GetPrimask()
+#define __set_PRIMASK(x)    Mock_SetPrimask(x)
+
+#define MOCK_CPU_MHZ        84      /* فرکانس مجازی برای شمارنده سیکل */
+
+void Mock_WaitForInterrupt(void);
+void Mock_DisableIrq(void);
+void Mock_EnableIrq(void);
+uint32_t Mock_GetPrimask(void);
+void Mock_SetPrimask(uint32_t primask);
+
+/* ساعت مجازی */
+void Mock_Reset(void);
+uint64_t Mock_Micros(void);
+void Mock_AdvanceUs(uint32_t us);
+void Mock_SysTickHandler(void);
+void Mock_SkipTo(uint64_t us);
+void Mock_SetHorizon(uint64_t us);
+uint64_t Mock_Horizon(void);
+
+/* ورودی‌ها */
+void Mock_SetInput(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+void Mock_KeyDown(char key);
+void Mock_KeyUp(char key);
+
+/* مدل LCD */
+void Mock_LcdReset(void);
+void Mock_LcdBus(uint32_t oldOdr, uint32_t newOdr);
+const char* Mock_LcdLine(uint8_t row);
+uint32_t Mock_LcdBytes(void);
+
+/* flash ساختگی؛ خواندن مستقیم آدرس flash از این راه می‌گذرد (flash_map.h).
+ * آدرس بیرون از آن (جدول‌های ثابت که در بیلد host در حافظه خود برنامه‌اند)
+ * همان اشاره‌گر است */
+#define FLASH_READ_PTR(address)     Mock_FlashPtr(address)
+
+void Mock_FlashReset(void);
+const void* Mock_FlashPtr(uintptr_t address);
+uint32_t Mock_FlashEraseCount(uint32_t sector);
+
+/* جایگزین‌های host ماژول‌های سخت‌افزاری */
+void Buzzer_HostTick(void);
+uint32_t Buzzer_HostTonesPlayed(void);
+
+#endif /* __MOCK_HAL_H */
@@ -0,0 +1,98 @@
+/* =================================================================
+ * مدل HD44780 برای بیلد host
+ *
+ * روی لبه پایین‌رونده EN نیبل D4-D7 خوانده می‌شود. تا قبل از
+ * function set با DL=0 هر نیبل یک دستور 8 بیتی است؛ بعد از آن دو نیبل
+ * (اول بالا) یک بایت می‌سازند. فقط دستورهایی که درایور استفاده می‌کند
+ * (clear، home، set DDRAM address) روی محتوا اثر دارند.
+ * ================================================================= */
+
+#include "main.h"
+#include "hd44780.h"
+#include <string.h>
+
+#define DDRAM_SIZE  0x80
+
+static const uint8_t rowBase[4] = {0x00, 0x40, LCD_COLS, 0x40 + LCD_COLS};
+
+static char ddram[DDRAM_SIZE];
+static uint8_t address = 0;
+static uint8_t fourBit = 0;
+static uint8_t haveHigh = 0;
+static uint8_t highNibble = 0;
+static uint32_t bytes = 0;
+static char line[LCD_COLS + 1];
+
+void Mock_LcdReset(void)
+{
+    memset(ddram, ' ', sizeof(ddram));
+    address = 0;
+    fourBit = 0;
+    haveHigh = 0;
+    bytes = 0;
+}
+
+static void Mock_LcdExecute(uint8_t isData, uint8_t value)
+{
+    bytes++;
+
+    if (isData) {
+        ddram[address & (DDRAM_SIZE - 1)] = (char)value;
+        address = (address + 1) & (DDRAM_SIZE - 1);
+        return;
+    }
+
+    if (value & 0x80) {
+        address = value & 0x7F;                 /* set DDRAM address */
+    } else if (value & 0x20) {
+        fourBit = !(value & 0x10);              /* function set */
+    } else if (value == 0x01) {
+        memset(ddram, ' ', sizeof(ddram));      /* clear */
+        address = 0;
+    } else if ((value & 0xFE) == 0x02) {
+        address = 0;                            /* return home */
+    }
+}
+
+void Mock_LcdBus(uint32_t oldOdr, uint32_t newOdr)
+{
+    if (!((oldOdr & LCD_EN_Pin) && !(newOdr & LCD_EN_Pin))) {
+        return; // فقط لبه پایین‌رونده EN
+    }
+    if (newOdr & LCD_RW_Pin) {
+        return; // خواندن busy flag
+    }
+
+    uint8_t nibble = (uint8_t)((newOdr >> 4) & 0x0F);
+    uint8_t isData = (newOdr & LCD_RS_Pin) ? 1 : 0;
+
+    if (!fourBit) {
+        Mock_LcdExecute(isData, (uint8_t)(nibble << 4));
+        haveHigh = 0;
+        return;
+    }
+
+    if (!haveHigh) {
+        highNibble = nibble;
+        haveHigh = 1;
+    } else {
+        haveHigh = 0;
+        Mock_LcdExecute(isData, (uint8_t)((highNibble << 4) | nibble));
+    }
+}
+
+/* محتوای یک سطر پنل (نه بافر سایه) */
+const char* Mock_LcdLine(uint8_t row)
+{
+    if (row >= LCD_ROWS) {
+        row = 0;
+    }
+    memcpy(line, &ddram[rowBase[row]], LCD_COLS);
+    line[LCD_COLS] = '\0';
+    return line;
+}
+
+uint32_t Mock_LcdBytes(void)
+{
+    return bytes;
+}
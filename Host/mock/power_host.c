@@ -0,0 +1,79 @@
+/* =================================================================
+ * مدیریت توان برای بیلد host
+ *
+ * معادل Stop mode روی ساعت مجازی: وقتی همه ماژول‌ها بی‌کارند، زمان
+ * مستقیم تا افق تعیین‌شده (ورودی بعدی شبیه‌ساز یا پایان RunFor) جلو
+ * می‌رود. در غیر این صورت مثل WFI تا SysTick بعدی.
+ * ================================================================= */
+
+#include "power.h"
+#include "scheduler.h"
+#include "keypad.h"
+#include "hd44780.h"
+#include "buzzer.h"
+#include "leds.h"
+#include "security.h"
+#include "eventlog.h"
+#include "eeprom.h"
+#include "config.h"
+#include "integrity.h"
+
+static PowerStats_t stats;
+
+void Power_Init(void)
+{
+}
+
+void Power_WakeHandled(void)
+{
+}
+
+const PowerStats_t* Power_GetStats(void)
+{
+    return &stats;
+}
+
+void Power_RtcWakeupIRQHandler(void)
+{
+}
+
+static uint8_t Power_CanSkip(void)
+{
+    return Keypad_IsIdle()
+        && !LCD_IsDirty() && !LCD_IsBusy()
+        && !Buzzer_IsBusy()
+        && !Leds_IsAnimating()
+        && Security_IsIdle()
+        && EventLog_IsIdle()
+        && !EventLog_NeedsErase()      // پرش نوبت تسک پاک کردن را حذف می‌کرد
+        && Eeprom_IsIdle()
+        && Config_IsIdle()
+        && Integrity_IsIdle();
+}
+
+void Scheduler_Idle(uint32_t timeToNext)
+{
+    if (timeToNext == 0) {
+        return;
+    }
+
+    uint64_t now = Mock_Micros();
+    uint64_t target = Mock_Horizon();
+    uint32_t oneShot = Scheduler_TimeToNextOneShot();
+
+    if (oneShot != UINT32_MAX && now + (uint64_t)oneShot * 1000U < target) {
+        target = now + (uint64_t)oneShot * 1000U;
+    }
+
+    /* پرش فقط وقتی ارزش دارد که از یک دوره تسک بلندتر باشد */
+    if (target > now + 1000U * (uint64_t)timeToNext && Power_CanSkip()) {
+        stats.stopCount++;
+        stats.stopTimeMs += (uint32_t)((target - now) / 1000U);
+        Mock_SkipTo(target);
+        Scheduler_Realign();
+        return;
+    }
+
+    stats.sleepCount++;
+    Mock_WaitForInterrupt();
+}
@@ -0,0 +1,15 @@
+/* =================================================================
+ * HAL ساختگی برای بیلد host
+ *
+ * هدرهای واقعی HAL/CMSIS برای نوع‌ها و ثابت‌ها include می‌شوند؛ سپس
+ * نمونه‌های پریفرال (GPIOx، EXTI) و دستورهای مخصوص هسته (WFI، PRIMASK)
+ * به ساختارها و توابع ساختگی mock_hal.h هدایت می‌شوند.
+ * ================================================================= */
+
+#ifndef __MOCK_STM32F4XX_HAL_H
+#define __MOCK_STM32F4XX_HAL_H
+
+#include_next "stm32f4xx_hal.h"
+#include "mock_hal.h"
+
+#endif /* __MOCK_STM32F4XX_HAL_H */
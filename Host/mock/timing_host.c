@@ -0,0 +1,56 @@
+/* =================================================================
+ * سرویس زمان‌سنجی روی ساعت مجازی
+ *
+ * سیکل‌ها از زمان مجازی با فرکانس MOCK_CPU_MHZ ساخته می‌شوند؛
+ * delay_us ساعت مجازی را جلو می‌برد.
+ * ================================================================= */
+
+#include "timing.h"
+
+void Timing_Init(void)
+{
+}
+
+void Timing_Update(void)
+{
+}
+
+void delay_us(uint32_t us)
+{
+    Mock_AdvanceUs(us);
+}
+
+uint32_t Timing_GetCycles(void)
+{
+    return (uint32_t)(Mock_Micros() * MOCK_CPU_MHZ);
+}
+
+uint64_t Timing_GetMicros64(void)
+{
+    return Mock_Micros();
+}
+
+uint32_t Timing_ElapsedCycles(uint32_t startCycles)
+{
+    return (uint32_t)(Timing_GetCycles() - startCycles);
+}
+
+uint32_t Timing_ElapsedUs(uint32_t startCycles)
+{
+    return Timing_ElapsedCycles(startCycles) / MOCK_CPU_MHZ;
+}
+
+uint32_t Timing_CyclesToUs(uint32_t cycles)
+{
+    return cycles / MOCK_CPU_MHZ;
+}
+
+uint32_t Timing_CyclesPerUs(void)
+{
+    return MOCK_CPU_MHZ;
+}
+
+void Timing_AddSleep(uint32_t us)
+{
+    (void)us;
+}
@@ -0,0 +1,223 @@
+/* =================================================================
+ * تولید فهرست کارت‌های باطل‌شده و فیلتر Bloom (Core/Src/revoke_table.c)
+ *
+ * ورودی: قالب cards_list.h؛ ستون ویژگی لازم نیست. برای n کارت و نرخ
+ * مثبت کاذب p:  m = -n ln(p) / (ln 2)^2 (گرد به 32)،  k = (m / n) ln 2
+ * در پایان هر کارت فهرست با همان Revoke_IsRevokedIn firmware بررسی و
+ * نرخ مثبت کاذب واقعی روی کارت‌های تصادفی اندازه‌گیری می‌شود.
+ * استفاده:
+ *   ./revoke_gen [-p 0.01] revoked.txt [seed] > ../Core/Src/revoke_table.c
+ *   ./revoke_gen [-p 0.01] -r 5000 [seed]       فقط آمار برای N کارت تصادفی
+ * ================================================================= */
+
+#include "cards_list.h"
+#include "revoke.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REVOKE_GEN_PROBES   1000000
+#define REVOKE_GEN_MAX_K    16
+
+/* ابزار فقط Revoke_IsRevokedIn را روی جدول خودش صدا می‌زند */
+const RevokeTable_t revokeTable;
+
+static CardsListEntry_t list[CARDS_LIST_MAX];
+static CardUid_t uids[CARDS_LIST_MAX];
+static uint32_t count = 0;
+static uint32_t *filter = NULL;
+static RevokeTable_t table;
+
+static uint32_t rngState = 0;
+static FILE *urandom = NULL;
+
+static uint32_t Gen_Rand(void)
+{
+    uint32_t value;
+    if (urandom != NULL && fread(&value, sizeof(value), 1, urandom) == 1) {
+        return value;
+    }
+    rngState = rngState * 1664525U + 1013904223U;
+    return rngState ^ (rngState >> 16);
+}
+
+/* ================================================
+ * ساخت فیلتر
+ * ================================================ */
+static void Gen_Build(double rate)
+{
+    uint32_t bits = 0;
+    uint32_t k = 0;
+
+    if (count > 0) {
+        double m = -(double)count * log(rate) / (M_LN2 * M_LN2);
+        bits = ((uint32_t)ceil(m) + 31U) & ~31U;
+        k = (uint32_t)lround((double)bits / count * M_LN2);
+        k = (k < 1U) ? 1U : (k > REVOKE_GEN_MAX_K) ? REVOKE_GEN_MAX_K : k;
+    }
+
+    filter = calloc(bits / 32U + 1U, sizeof(uint32_t));
+    if (filter == NULL) {
+        fprintf(stderr, "revoke_gen: out of memory\n");
+        exit(1);
+    }
+    for (int i = 0; i < HASH_KEY_SIZE; i++) {
+        table.key[i] = (uint8_t)Gen_Rand();
+    }
+    table.filterBits = bits;
+    table.hashCount = (uint8_t)k;
+    table.filter = filter;
+    table.count = count;
+    table.uids = uids;
+
+    /* همان بیت‌های Revoke_FilterMayContain */
+    for (uint32_t n = 0; n < count; n++) {
+        uint64_t h = Cards_Hash(table.key, &uids[n]);
+        uint32_t h1 = (uint32_t)h;
+        uint32_t h2 = (uint32_t)(h >> 32) | 1U;
+        for (uint32_t i = 0; i < k; i++) {
+            uint32_t bit = (uint32_t)(((uint64_t)h1 * bits) >> 32);
+            filter[bit >> 5] |= 1UL << (bit & 31U);
+            h1 += h2;
+        }
+    }
+}
+
+static int Gen_Check(void)
+{
+    for (uint32_t n = 0; n < count; n++) {
+        uint8_t filterHit;
+        if (!Revoke_IsRevokedIn(&table, &uids[n], &filterHit)) {
+            fprintf(stderr, "revoke_gen: self-check failed\n");
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* ================================================
+ * خروجی
+ * ================================================ */
+static void Gen_Stats(FILE *out, double rate)
+{
+    uint32_t filterHits = 0, revoked = 0;
+
+    /* کارت‌های تصادفی خارج از فهرست؛ احتمال برخورد با فهرست ناچیز است */
+    for (uint32_t i = 0; i < REVOKE_GEN_PROBES; i++) {
+        CardsListEntry_t probe;
+        uint8_t filterHit;
+        CardsList_Random(&probe, 1, Gen_Rand);
+        probe.uid.bytes[0] = 0x05;
+        revoked += Revoke_IsRevokedIn(&table, &probe.uid, &filterHit);
+        filterHits += filterHit;
+    }
+
+    fprintf(out, "%lu revoked cards, filter %lu bits (%lu bytes), k = %u, list %lu bytes\n",
+            (unsigned long)count, (unsigned long)table.filterBits, (unsigned long)(table.filterBits / 8U),
+            table.hashCount, (unsigned long)(count * sizeof(CardUid_t)));
+    fprintf(out, "false positive rate %.4f%% (target %.4f%%), %lu of %d unknown cards reached the list, %lu matched\n",
+            100.0 * filterHits / REVOKE_GEN_PROBES, 100.0 * rate, (unsigned long)filterHits,
+            REVOKE_GEN_PROBES, (unsigned long)revoked);
+}
+
+static void Gen_Write(const char *source, double rate)
+{
+    uint32_t words = table.filterBits / 32U;
+    /* عنصر صفر اضافه تا آرایه به مضرب 4 بایت برسد (IntegritySpan_t) */
+    uint32_t uidBytes = count * sizeof(CardUid_t);
+    uint32_t uidPad = (uidBytes % 4U) ? 1U : 0U;
+    uint32_t crc = Hash_Crc32(HASH_CRC_INITIAL, filter, words * sizeof(uint32_t));
+    crc = Hash_Crc32(crc, uids, uidBytes);
+
+    printf("/* =================================================================\n");
+    printf(" * کارت‌های باطل‌شده - تولید شده با Host/revoke_gen از %s؛ دستی ویرایش نشود\n", source);
+    printf(" * %lu کارت، فیلتر %lu بیت، k = %u، نرخ مثبت کاذب هدف %g\n", (unsigned long)count,
+           (unsigned long)table.filterBits, table.hashCount, rate);
+    printf(" * ================================================================= */\n\n");
+    printf("#include \"revoke.h\"\n\n");
+
+    /* آرایه خالی در C مجاز نیست */
+    printf("CARDS_SECTION static const uint32_t filter[%lu] = {", (unsigned long)(words ? words : 1U));
+    for (uint32_t i = 0; i < words; i++) {
+        printf("%s%s0x%08lX", i ? "," : "", (i % 6) ? " " : "\n    ", (unsigned long)filter[i]);
+    }
+    printf("%s\n};\n\n", words ? "" : "\n    0");
+
+    printf("CARDS_SECTION INTEGRITY_ALIGNED static const CardUid_t uids[%lu] = {\n",
+           (unsigned long)(count ? count + uidPad : 1U));
+    for (uint32_t n = 0; n < count; n++) {
+        printf("    {%u, {", uids[n].length);
+        for (uint8_t b = 0; b < uids[n].length; b++) {
+            printf("%s0x%02X", b ? ", " : "", uids[n].bytes[b]);
+        }
+        printf("}},\n");
+    }
+    if (count == 0 || uidPad) {
+        printf("    {0, {0}},\n");
+    }
+    printf("};\n\n");
+
+    printf("CARDS_SECTION const RevokeTable_t revokeTable = {\n    {");
+    for (int i = 0; i < HASH_KEY_SIZE; i++) {
+        printf("%s0x%02X", i ? ", " : "", table.key[i]);
+    }
+    printf("},\n    %lu, %u, filter,\n    %lu, uids\n};\n\n", (unsigned long)table.filterBits,
+           table.hashCount, (unsigned long)count);
+    printf("static const IntegritySpan_t spans[2] = {\n");
+    printf("    {filter, %lu},\n", (unsigned long)(words * sizeof(uint32_t)));
+    printf("    {uids, %lu},\n};\n\n", (unsigned long)((uidBytes + 3U) & ~3U));
+    printf("const IntegrityImage_t revokeTableCrc = {spans, 2, 0x%08lX};\n", (unsigned long)crc);
+}
+
+int main(int argc, char **argv)
+{
+    double rate = 0.01;
+    int arg = 1;
+
+    if (argc > 2 && strcmp(argv[1], "-p") == 0) {
+        rate = strtod(argv[2], NULL);
+        arg = 3;
+    }
+    int randomMode = (argc > arg + 1 && strcmp(argv[arg], "-r") == 0);
+    int seedArg = randomMode ? arg + 2 : arg + 1;
+
+    if (argc <= arg || (strcmp(argv[arg], "-r") == 0 && !randomMode) || !(rate > 0.0 && rate < 1.0)) {
+        fprintf(stderr, "usage: %s [-p rate] revoked.txt [seed] | [-p rate] -r count [seed]\n", argv[0]);
+        return 2;
+    }
+    if (argc > seedArg) {
+        rngState = (uint32_t)strtoul(argv[seedArg], NULL, 0);
+    } else if ((urandom = fopen("/dev/urandom", "rb")) == NULL) {
+        perror("/dev/urandom");
+        return 1;
+    }
+
+    if (randomMode) {
+        count = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+        if (count > CARDS_LIST_MAX) {
+            fprintf(stderr, "revoke_gen: at most %d cards\n", CARDS_LIST_MAX);
+            return 1;
+        }
+        CardsList_Random(list, count, Gen_Rand);
+    } else if (CardsList_Read(argv[arg], list, &count) != 0) {
+        return 1;
+    }
+    /* همان ترتیب جست‌وجوی دودویی Revoke_IsRevokedIn */
+    if (CardsList_SortUnique(list, count) != 0) {
+        return 1;
+    }
+    for (uint32_t n = 0; n < count; n++) {
+        uids[n] = list[n].uid;
+    }
+
+    Gen_Build(rate);
+    if (Gen_Check() != 0) {
+        return 1;
+    }
+    Gen_Stats(randomMode ? stdout : stderr, rate);
+    if (!randomMode) {
+        Gen_Write(argv[arg], rate);
+    }
+    return 0;
+}
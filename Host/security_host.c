@@ -0,0 +1,919 @@
+/* =================================================================
+ * اجرای سناریوهای دسترسی روی بیلد host
+ *
+ * هر سناریو سیستم را از نو راه‌اندازی می‌کند، ورودی‌ها (کلید، کارت،
+ * PIR) را روی GPIO مجازی اعمال می‌کند و وضعیت نهایی و متن LCD را
+ * بررسی می‌کند. استفاده:
+ *   ./security_host [تعداد تکرار]
+ * ================================================================= */
+
+#include "main.h"
+#include "app.h"
+#include "scheduler.h"
+#include "keypad.h"
+#include "hd44780.h"
+#include "timing.h"
+#include "buzzer.h"
+#include "leds.h"
+#include "security.h"
+#include "users.h"
+#include "revoke.h"
+#include "cards.h"
+#include "eventlog.h"
+#include "eeprom.h"
+#include "config.h"
+#include "integrity.h"
+#include "crc.h"
+#include "hash.h"
+#include "flash_map.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define KEY_HOLD_MS     60
+#define KEY_GAP_MS      60
+#define INPUT_HOLD_MS   50
+
+typedef struct {
+    const char *name;
+    int (*run)(void);
+} Scenario_t;
+
+static const char *failReason = NULL;
+
+/* ================================================
+ * کمک‌تابع‌ها
+ * ================================================ */
+/* راه‌اندازی دوباره؛ محتوای flash (گزارش رویدادها) حفظ می‌شود */
+static void Host_Restart(void)
+{
+    Mock_Reset();
+    Timing_Init();
+    Buzzer_Init();
+    Leds_Init();
+    Keypad_Init();
+    LCD_Init();
+    Integrity_Init();
+    Eeprom_Init();
+    EventLog_Init();
+    Config_Init();
+    Security_Init();
+    App_StartTasks();
+}
+
+static void Host_Boot(void)
+{
+    Mock_FlashReset();
+    Host_Restart();
+}
+
+static void Host_RunFor(uint32_t ms)
+{
+    uint32_t start = HAL_GetTick();
+    Mock_SetHorizon((Mock_Micros() / 1000U + ms) * 1000U);
+    while ((HAL_GetTick() - start) < ms) {
+        Scheduler_Run();
+    }
+}
+
+static void Host_Press(char key)
+{
+    Mock_KeyDown(key);
+    Host_RunFor(KEY_HOLD_MS);
+    Mock_KeyUp(key);
+    Host_RunFor(KEY_GAP_MS);
+}
+
+static void Host_Type(const char *keys)
+{
+    while (*keys) {
+        Host_Press(*keys++);
+    }
+}
+
+/* کارت‌ها فعال-پایین (1..3) */
+static void Host_Card(uint8_t card)
+{
+    static const uint16_t pins[3] = {RFID_CARD1_Pin, RFID_CARD2_Pin, RFID_CARD3_Pin};
+    Mock_SetInput(GPIOB, pins[card - 1], GPIO_PIN_RESET);
+    Host_RunFor(INPUT_HOLD_MS);
+    Mock_SetInput(GPIOB, pins[card - 1], GPIO_PIN_SET);
+    Host_RunFor(INPUT_HOLD_MS);
+}
+
+static void Host_Motion(void)
+{
+    Mock_SetInput(PIR_SENSOR_GPIO_Port, PIR_SENSOR_Pin, GPIO_PIN_SET);
+    Host_RunFor(INPUT_HOLD_MS);
+    Mock_SetInput(PIR_SENSOR_GPIO_Port, PIR_SENSOR_Pin, GPIO_PIN_RESET);
+    Host_RunFor(INPUT_HOLD_MS);
+}
+
+static int Host_Expect(SystemState_t state, const char *line0)
+{
+    if (Security_GetState() != state) {
+        failReason = "state";
+        return 0;
+    }
+    if (line0 != NULL && strncmp(Mock_LcdLine(0), line0, strlen(line0)) != 0) {
+        failReason = "lcd";
+        return 0;
+    }
+    return 1;
+}
+
+static void Host_Arm(void)
+{
+    Host_Type("1234");
+    Host_RunFor(SECURITY_PIN_SHOW_MS + SECURITY_GRANTED_SHOW_MS + 100);
+}
+
+/* رکورد شماره back از آخر باید این نوع را داشته باشد */
+static int Host_ExpectLog(uint32_t back, EventLogType_t type, EventLogRecord_t *record)
+{
+    if (!EventLog_Read(back, record) || record->type != type
+        || record->sequence != EventLog_NextSequence() - 1U - back) {
+        failReason = "event log";
+        return 0;
+    }
+    return 1;
+}
+
+/* تصویر پیکربندی: یک کاربر و کارت خط 1 (lineCards در security.c) باطل‌شده */
+static uint32_t Host_BuildConfig(uint8_t *image, const char *pin, uint16_t id)
+{
+    static const uint8_t pepper[USERS_PEPPER_SIZE] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+    static const CardUid_t revoked = {4, {0x04, 0xA2, 0x2B, 0x1C}};
+    const uint32_t allMaybe = 0xFFFFFFFFUL;     /* فیلتر همیشه "شاید"؛ فهرست تصمیم می‌گیرد */
+    ConfigLayout_t layout;
+    UserRecord_t record;
+    uint16_t index[USERS_BUCKETS + 1];
+    uint8_t key[HASH_KEY_SIZE] = {0};
+
+    memcpy(key, pepper, USERS_PEPPER_SIZE);
+    uint16_t bucket = (uint16_t)(Hash_SipHash(key, pin, USERS_PREFIX_LENGTH) % USERS_BUCKETS);
+    for (uint32_t b = 0; b <= USERS_BUCKETS; b++) {
+        index[b] = b > bucket;
+    }
+    memset(&record, 0, sizeof(record));
+    record.id = id;
+    memset(record.salt, 0x5A, USERS_SALT_SIZE);
+    memcpy(key, record.salt, USERS_SALT_SIZE);
+    memcpy(key + USERS_SALT_SIZE, pepper, USERS_PEPPER_SIZE);
+    record.hash = Hash_SipHash(key, pin, strlen(pin));
+
+    memset(&layout, 0, sizeof(layout));
+    layout.usersCount = 1;
+    layout.usersPepper = sizeof(layout);
+    layout.usersIndex = layout.usersPepper + USERS_PEPPER_SIZE;
+    layout.usersRecords = (layout.usersIndex + sizeof(index) + 7U) & ~7U;
+    memset(layout.revokeKey, 0xC3, HASH_KEY_SIZE);
+    layout.revokeFilterBits = 32;
+    layout.revokeHashCount = 1;
+    layout.revokeFilter = layout.usersRecords + sizeof(record);
+    layout.revokeCount = 1;
+    layout.revokeUids = layout.revokeFilter + sizeof(allMaybe);
+
+    memset(image, 0, layout.revokeUids + sizeof(revoked) + 4U);
+    memcpy(image, &layout, sizeof(layout));
+    memcpy(image + layout.usersPepper, pepper, USERS_PEPPER_SIZE);
+    memcpy(image + layout.usersIndex, index, sizeof(index));
+    memcpy(image + layout.usersRecords, &record, sizeof(record));
+    memcpy(image + layout.revokeFilter, &allMaybe, sizeof(allMaybe));
+    memcpy(image + layout.revokeUids, &revoked, sizeof(revoked));
+    return (layout.revokeUids + sizeof(revoked) + 3U) & ~3U;
+}
+
+/* آرایه‌ای از جدول firmware به انتهای تصویر، هم‌تراز 8؛ فاصله‌اش را برمی‌گرداند */
+static uint32_t Host_AppendArray(uint8_t *image, uint32_t *length, const void *data, uint32_t size)
+{
+    uint32_t offset = (*length + 7U) & ~7U;
+
+    memset(image + *length, 0, offset - *length);
+    memcpy(image + offset, data, size);
+    *length = offset + size;
+    return offset;
+}
+
+/* پایگاه کارت firmware با همه ویژگی‌ها صفر (مسدود) به تصویر Host_BuildConfig */
+static uint32_t Host_AddCards(uint8_t *image, uint32_t length)
+{
+    ConfigLayout_t layout;
+
+    memcpy(&layout, image, sizeof(layout));
+    layout.cardsFormat = CONFIG_CARDS_FORMAT;
+#if CARDS_STORE == CARDS_STORE_PACKED
+    static const uint16_t palette[CARDS_PACKED_ATTR_MAX] = {CARD_ATTR_NONE};
+    static CardRecord_t overflow[16];
+    const CardPackedTable_t *table = &cardsPackedTable;
+
+    memcpy(overflow, table->overflow, table->overflowCount * sizeof(CardRecord_t));
+    for (uint32_t i = 0; i < table->overflowCount; i++) {
+        overflow[i].attributes = CARD_ATTR_NONE;
+    }
+    layout.cardsCount = table->cardCount;
+    layout.cardsBlockCount = table->blockCount;
+    layout.cardsBlocks = Host_AppendArray(image, &length, table->blocks, table->blockCount * sizeof(CardBlock_t));
+    layout.cardsBitsWords = cardsTableCrc.spans[1].length / 4U;
+    layout.cardsBits = Host_AppendArray(image, &length, table->bits, cardsTableCrc.spans[1].length);
+    layout.cardsAttributeBits = table->attributeBits;
+    layout.cardsPalette = Host_AppendArray(image, &length, palette, sizeof(palette));
+    layout.cardsAttributeWords = cardsTableCrc.spans[3].length / 4U;
+    layout.cardsAttributeIndex = Host_AppendArray(image, &length, table->attributeIndex, cardsTableCrc.spans[3].length);
+    layout.cardsOverflowCount = table->overflowCount;
+    layout.cardsOverflow = Host_AppendArray(image, &length, overflow, table->overflowCount * sizeof(CardRecord_t));
+#elif CARDS_STORE == CARDS_STORE_PERFECT
+    static CardRecord_t records[16];
+    const CardPerfectTable_t *table = &cardsPerfectTable;
+
+    memcpy(records, table->records, table->recordCount * sizeof(CardRecord_t));
+    for (uint32_t i = 0; i < table->recordCount; i++) {
+        records[i].attributes = CARD_ATTR_NONE;
+    }
+    memcpy(layout.cardsKey, table->key, HASH_KEY_SIZE);
+    layout.cardsBucketCount = table->bucketCount;
+    layout.cardsRecordCount = table->recordCount;
+    layout.cardsCount = table->cardCount;
+    layout.cardsPilots = Host_AppendArray(image, &length, table->pilots, table->bucketCount * sizeof(uint16_t));
+    layout.cardsRecords = Host_AppendArray(image, &length, records, table->recordCount * sizeof(CardRecord_t));
+#else
+    static const uint16_t attributes[64] = {CARD_ATTR_NONE};
+    const CardTable_t *table = &cardsTable;
+    uint32_t slots = table->bucketCount * CARDS_SLOTS_PER_BUCKET;
+
+    memcpy(layout.cardsKey, table->key, HASH_KEY_SIZE);
+    layout.cardsBucketCount = table->bucketCount;
+    layout.cardsCount = table->cardCount;
+    layout.cardsTags = Host_AppendArray(image, &length, table->tags, slots * sizeof(uint32_t));
+    layout.cardsAttributes = Host_AppendArray(image, &length, attributes, slots * sizeof(uint16_t));
+#endif
+    memcpy(image, &layout, sizeof(layout));
+    memset(image + length, 0, 3U);
+    return (length + 3U) & ~3U;
+}
+
+/* CRC که فرستنده همراه Config_Commit می‌فرستد */
+static uint32_t Host_ConfigCrc(const void *image, uint32_t length)
+{
+    return Hash_Crc32(CRC_INITIAL, image, length);
+}
+
+/* تکه‌تکه، هر بار به اندازه جای خالی بافر، مثل پیوندی کند */
+static int Host_SendConfig(const uint8_t *image, uint32_t length)
+{
+    uint32_t sent = 0;
+
+    if (!Config_Begin(length)) {
+        failReason = "config begin";
+        return 0;
+    }
+    for (uint32_t i = 0; i < 1000 && sent < length; i++) {
+        sent += Config_Write(image + sent, length - sent);
+        Host_RunFor(TASK_STORAGE_PERIOD);
+    }
+    return Config_Commit(Host_ConfigCrc(image, length));
+}
+
+static int Host_WaitConfig(uint32_t version)
+{
+    for (uint32_t i = 0; i < 500 && Config_GetVersion() != version; i++) {
+        Host_RunFor(TASK_STORAGE_PERIOD);
+    }
+    if (Config_GetVersion() != version || Config_GetUpdateState() != CONFIG_IDLE) {
+        failReason = "config version";
+        return 0;
+    }
+    return 1;
+}
+
+/* ================================================
+ * سناریوها
+ * ================================================ */
+static int Scenario_ArmWithPin(void)
+{
+    Host_Type("1234");
+    Host_RunFor(SECURITY_PIN_SHOW_MS + 50);
+    if (!Host_Expect(SYSTEM_ACCESS_GRANTED, "Password OK!")) return 0;
+    Host_RunFor(SECURITY_GRANTED_SHOW_MS + 50);
+    return Host_Expect(SYSTEM_ARMED, "System ARMED");
+}
+
+static int Scenario_WrongPin(void)
+{
+    Host_Type("1111");
+    Host_RunFor(SECURITY_PIN_SHOW_MS + 50);
+    if (!Host_Expect(SYSTEM_ACCESS_DENIED, "Wrong Password!")) return 0;
+    Host_RunFor(SECURITY_DENIED_SHOW_MS + 50);
+    return Host_Expect(SYSTEM_DISARMED, "System DISARMED");
+}
+
+static int Scenario_ClearKey(void)
+{
+    Host_Type("12C");
+    if (!Host_Expect(SYSTEM_PASSWORD_ENTRY, "Enter Password:")) return 0;
+    Host_Type("1234");
+    Host_RunFor(SECURITY_PIN_SHOW_MS + 50);
+    return Host_Expect(SYSTEM_ACCESS_GRANTED, NULL);
+}
+
+static int Scenario_CardDisarms(void)
+{
+    Host_Arm();
+    Host_Card(1);
+    return Host_Expect(SYSTEM_DISARMED, "System DISARMED");
+}
+
+/* خط 2 یک UID هفت بایتی از cards_demo.txt ارائه می‌کند */
+static int Scenario_SevenByteCard(void)
+{
+    Host_Arm();
+    Host_Card(2);
+    return Host_Expect(SYSTEM_DISARMED, "System DISARMED");
+}
+
+static int Scenario_InvalidCardAlarm(void)
+{
+    Host_Arm();
+    Host_Card(3);
+    if (!Host_Expect(SYSTEM_ALARM, "!! ALARM !!")) return 0;
+    if (strncmp(Mock_LcdLine(1), "Unauthorized", 12) != 0) {
+        failReason = "lcd";
+        return 0;
+    }
+    return Buzzer_IsBusy();
+}
+
+/* در cards_demo.txt فعال ولی در revoked_demo.txt باطل‌شده؛ کارت معتبر از فیلتر رد می‌شود */
+static int Scenario_RevokedCardAlarm(void)
+{
+    static const CardUid_t revoked = {7, {0x04, 0x6B, 0x3E, 0x91, 0xC2, 0x55, 0x80}};
+    RevokeStats_t stats;
+
+    Host_Arm();
+    Revoke_ResetStats();
+    Host_Card(1);
+    Host_Arm();
+    Security_PresentCard(&revoked);
+    Host_RunFor(INPUT_HOLD_MS);
+    if (!Host_Expect(SYSTEM_ALARM, "!! ALARM !!")) return 0;
+
+    Revoke_GetStats(&stats);
+    if (stats.checks != 2 || stats.revoked != 1) {
+        failReason = "revoke stats";
+        return 0;
+    }
+    return 1;
+}
+
+static int Scenario_MotionAlarmThenPin(void)
+{
+    Host_Arm();
+    Host_Motion();
+    if (!Host_Expect(SYSTEM_ALARM, "!! ALARM !!")) return 0;
+    Host_Arm();
+    if (!Host_Expect(SYSTEM_DISARMED, "System DISARMED")) return 0;
+    return !Buzzer_IsBusy();
+}
+
+static int Scenario_DisarmedIgnoresSensors(void)
+{
+    Host_Motion();
+    Host_Card(3);
+    return Host_Expect(SYSTEM_DISARMED, "System DISARMED");
+}
+
+static int Scenario_MotionDuringPinEntry(void)
+{
+    Host_Arm();
+    Host_Type("12");
+    Host_Motion();
+    return Host_Expect(SYSTEM_ALARM, "!! ALARM !!");
+}
+
+/* کاربران نمونه users_demo.txt: 1=1234، 2=246810 */
+static int Scenario_LongPinUser(void)
+{
+    Host_Type("246810");
+    Host_RunFor(SECURITY_PIN_SHOW_MS + 50);
+    if (!Host_Expect(SYSTEM_ACCESS_GRANTED, "Password OK!")) return 0;
+    return Security_GetLastUser() == 2;
+}
+
+static int Scenario_PrefixOfLongPin(void)
+{
+    Host_Type("2468");
+    Host_RunFor(SECURITY_PIN_SHOW_MS + 50);
+    if (!Host_Expect(SYSTEM_ACCESS_DENIED, "Wrong Password!")) return 0;
+    return Security_GetLastUser() == USERS_INVALID_ID;
+}
+
+static int Scenario_EnterVerifiesNow(void)
+{
+    Host_Type("1234=");
+    if (!Host_Expect(SYSTEM_ACCESS_GRANTED, "Password OK!")) return 0;
+    return Security_GetLastUser() == 1;
+}
+
+static int Scenario_EventLogRecords(void)
+{
+    EventLogRecord_t record;
+
+    Host_Type("1111");
+    Host_RunFor(SECURITY_PIN_SHOW_MS + SECURITY_DENIED_SHOW_MS + 100);
+    Host_Arm();
+    Host_Card(3);
+    Host_Motion();
+    if (!Host_Expect(SYSTEM_ALARM, "!! ALARM !!")) return 0;
+
+    /* حرکت در آلارم رویداد FSM نیست ولی لبه PIR ثبت می‌شود */
+    if (!Host_ExpectLog(0, EVENTLOG_MOTION, &record)) return 0;
+    if (!Host_ExpectLog(1, EVENTLOG_ALARM, &record) || record.detail != 0) return 0;
+    if (!Host_ExpectLog(2, EVENTLOG_CARD_DENIED, &record)) return 0;
+    if (record.detail != EVENTLOG_CARD_UNKNOWN || record.data != 0xDEADBEEFUL) {
+        failReason = "card record";
+        return 0;
+    }
+    if (!Host_ExpectLog(3, EVENTLOG_PIN_GRANTED, &record) || record.detail != 1 || record.data != 1) return 0;
+    if (!Host_ExpectLog(4, EVENTLOG_PIN_DENIED, &record)) return 0;
+    if (!Host_ExpectLog(5, EVENTLOG_BOOT, &record)) return 0;
+    return !EventLog_Read(6, &record);
+}
+
+static int Scenario_EventLogSurvivesReset(void)
+{
+    EventLogRecord_t record;
+
+    Host_Arm();
+    uint32_t next = EventLog_NextSequence();
+    Host_Restart();
+
+    if (!Host_ExpectLog(0, EVENTLOG_BOOT, &record) || record.sequence != next) return 0;
+    if (!Host_ExpectLog(1, EVENTLOG_PIN_GRANTED, &record)) return 0;
+    return Host_ExpectLog(2, EVENTLOG_BOOT, &record);
+}
+
+/* S3 و S4 پر می‌شوند و حلقه به S3 برمی‌گردد؛ پاک کردن فقط در تسک و در سکون */
+static int Scenario_EventLogRotates(void)
+{
+    const uint32_t records = (FLASH_MAP_LOG_SIZE0 + FLASH_MAP_LOG_SIZE1) / EVENTLOG_RECORD_SIZE + 100U;
+    EventLogStats_t stats;
+    EventLogRecord_t record;
+
+    for (uint32_t i = 0; i < records; i++) {
+        EventLog_Append(EVENTLOG_MOTION, 0, i);
+        if (EventLog_NeedsErase()) {
+            Host_RunFor(TASK_STORAGE_PERIOD + 10);
+        }
+    }
+    EventLog_GetStats(&stats);
+    if (stats.dropped != 0 || Mock_FlashEraseCount(FLASH_MAP_LOG_SECTOR0) != 2
+        || Mock_FlashEraseCount(FLASH_MAP_LOG_SECTOR1) != 1) {
+        failReason = "erases";
+        return 0;
+    }
+    if (!Host_ExpectLog(0, EVENTLOG_MOTION, &record) || record.data != records - 1U) return 0;
+
+    /* بعد از reset همان sector فعال پیدا می‌شود و کل S4 هنوز خواندنی است */
+    EventLog_Flush();
+    uint32_t next = EventLog_NextSequence();
+    Host_Restart();
+    if (!Host_ExpectLog(0, EVENTLOG_BOOT, &record) || record.sequence != next) return 0;
+    if (!Host_ExpectLog(FLASH_MAP_LOG_SIZE1 / EVENTLOG_RECORD_SIZE, EVENTLOG_MOTION, &record)) return 0;
+    Host_RunFor(100);
+    return Host_Expect(SYSTEM_DISARMED, "System DISARMED");
+}
+
+/* دو بافر پشت سر هم پر می‌شوند و تسک فقط اولی را می‌نویسد؛ دومی نوبت
+ * بعد می‌رود و افزودن بعدی جای آن را نمی‌گیرد: شماره‌ها صعودی می‌مانند */
+static int Scenario_EventLogBurst(void)
+{
+    const uint32_t burst = 2U * EVENTLOG_STAGE_RECORDS;
+    EventLogRecord_t record;
+    uint32_t first;
+
+    EventLog_Task();
+    first = EventLog_NextSequence();
+    for (uint32_t i = 0; i < burst; i++) {
+        EventLog_Append(EVENTLOG_MOTION, 0, i);
+    }
+    EventLog_Task();
+    EventLog_Append(EVENTLOG_MOTION, 0, burst);
+    if (EventLog_NextSequence() != first + burst + 1U) {
+        failReason = "sequence";
+        return 0;
+    }
+
+    /* در RAM و flash، بعد همه در flash، بعد از reset پشت BOOT */
+    for (uint32_t back = 0; back <= burst; back++) {
+        if (!Host_ExpectLog(back, EVENTLOG_MOTION, &record) || record.data != burst - back) return 0;
+    }
+    EventLog_Flush();
+    for (uint32_t back = 0; back <= burst; back++) {
+        if (!Host_ExpectLog(back, EVENTLOG_MOTION, &record) || record.data != burst - back) return 0;
+    }
+    Host_Restart();
+    if (!Host_ExpectLog(0, EVENTLOG_BOOT, &record) || record.sequence != first + burst + 1U) return 0;
+    for (uint32_t back = 0; back <= burst; back++) {
+        if (!Host_ExpectLog(back + 1U, EVENTLOG_MOTION, &record) || record.data != burst - back) return 0;
+    }
+    return 1;
+}
+
+/* رکوردهای عادی تا EVENTLOG_FLUSH_MS در RAM می‌مانند و با هم نوشته می‌شوند */
+static int Scenario_EventLogBatches(void)
+{
+    EventLogStats_t before, after;
+    EventLogRecord_t record;
+
+    Host_RunFor(TASK_STORAGE_PERIOD * 2);      /* BOOT بحرانی است و نوشته شده */
+    EventLog_GetStats(&before);
+    for (uint32_t i = 0; i < 3; i++) {
+        EventLog_Append(EVENTLOG_MOTION, 0, i);
+    }
+    Host_RunFor(EVENTLOG_FLUSH_MS / 2);
+    EventLog_GetStats(&after);
+    if (after.commits != before.commits || !Host_ExpectLog(0, EVENTLOG_MOTION, &record) || record.data != 2) {
+        failReason = "early commit";
+        return 0;
+    }
+    Host_RunFor(EVENTLOG_FLUSH_MS);
+    EventLog_GetStats(&after);
+    if (after.commits != before.commits + 1 || after.committed != before.committed + 3) {
+        failReason = "idle flush";
+        return 0;
+    }
+
+    /* بیش از دو بافر پشت سر هم: هیچ رکوردی گم نمی‌شود */
+    for (uint32_t i = 0; i < 3 * EVENTLOG_STAGE_RECORDS; i++) {
+        EventLog_Append(EVENTLOG_MOTION, 0, 100 + i);
+    }
+    if (!Host_ExpectLog(3 * EVENTLOG_STAGE_RECORDS, EVENTLOG_MOTION, &record) || record.data != 2) return 0;
+
+    /* رویداد بحرانی در نوبت بعدی تسک؛ ریست قبل از نوشتن فقط RAM را از دست می‌دهد */
+    Host_RunFor(EVENTLOG_FLUSH_MS + TASK_STORAGE_PERIOD);
+    EventLog_Append(EVENTLOG_ALARM, 1, 0);
+    Host_RunFor(TASK_STORAGE_PERIOD + 1);
+    EventLog_Append(EVENTLOG_MOTION, 0, 999);
+    Host_Restart();
+    if (!Host_ExpectLog(1, EVENTLOG_ALARM, &record)) return 0;
+    if (!Host_ExpectLog(2, EVENTLOG_MOTION, &record) || record.data != 100 + 3 * EVENTLOG_STAGE_RECORDS - 1) return 0;
+    EventLog_GetStats(&after);
+    return after.dropped == 0;
+}
+
+/* شمارنده رمز اشتباه و timeout تنظیم‌شده بعد از reset باقی می‌مانند */
+static int Scenario_SettingsSurviveReset(void)
+{
+    for (uint32_t i = 0; i < 2; i++) {
+        Host_Type("1111");
+        Host_RunFor(SECURITY_PIN_SHOW_MS + SECURITY_DENIED_SHOW_MS + 100);
+    }
+    Eeprom_Write(EEPROM_KEY_GRANTED_SHOW_MS, SECURITY_GRANTED_SHOW_MS * 3);
+    Host_RunFor(TASK_STORAGE_PERIOD * 2);
+    Host_Restart();
+    if (Security_GetFailedAttempts() != 2) {
+        failReason = "failures lost";
+        return 0;
+    }
+
+    Host_RunFor(100);
+    Host_Type("1234");
+    Host_RunFor(SECURITY_PIN_SHOW_MS + SECURITY_GRANTED_SHOW_MS + 50);
+    if (!Host_Expect(SYSTEM_ACCESS_GRANTED, NULL)) return 0;
+    Host_RunFor(SECURITY_GRANTED_SHOW_MS * 2);
+    if (!Host_Expect(SYSTEM_ARMED, "System ARMED")) return 0;
+    return Security_GetFailedAttempts() == 0;
+}
+
+/* 'C' و رمز اشتباه در آلارم به همان حالت برمی‌گردند ولی آلارم تازه نیستند */
+static int Scenario_AlarmCountedOnce(void)
+{
+    EventLogRecord_t record;
+    uint32_t alarms = 0;
+
+    Host_Arm();
+    Host_Motion();
+    if (!Host_Expect(SYSTEM_ALARM, "!! ALARM !!")) return 0;
+    for (uint32_t i = 0; i < 5; i++) {
+        Host_Press('C');
+    }
+    Host_Type("1111=");
+    Host_RunFor(SECURITY_DENIED_SHOW_MS + 100);
+    if (!Host_Expect(SYSTEM_ALARM, "!! ALARM !!")) return 0;
+
+    Host_RunFor(EVENTLOG_FLUSH_MS + TASK_STORAGE_PERIOD * 2);
+    Host_Restart();
+    if (Eeprom_Read(EEPROM_KEY_ALARM_COUNT, 0) != 1) {
+        failReason = "alarm count";
+        return 0;
+    }
+    for (uint32_t back = 0; EventLog_Read(back, &record); back++) {
+        alarms += record.type == EVENTLOG_ALARM;
+    }
+    if (alarms != 1) {
+        failReason = "alarm records";
+        return 0;
+    }
+    return 1;
+}
+
+/* هزاران تغییر: صفحه‌ها به نوبت فشرده و در سکون پاک می‌شوند */
+static int Scenario_EepromCompacts(void)
+{
+    const uint32_t writes = 3 * (FLASH_MAP_EEPROM_SIZE / EEPROM_RECORD_SIZE);
+    EepromStats_t stats;
+
+    for (uint32_t i = 1; i <= writes; i++) {
+        Eeprom_Write(EEPROM_KEY_ALARM_COUNT, i);
+        if (!Eeprom_IsIdle()) {
+            Host_RunFor(TASK_STORAGE_PERIOD);
+        }
+    }
+    Host_RunFor(TASK_STORAGE_PERIOD * 2);
+    Eeprom_GetStats(&stats);
+    if (stats.compactions < 2 || stats.failed != 0 || !Eeprom_IsIdle()) {
+        failReason = "compaction";
+        return 0;
+    }
+    uint32_t erases0 = Mock_FlashEraseCount(FLASH_MAP_EEPROM_SECTOR0);
+    uint32_t erases1 = Mock_FlashEraseCount(FLASH_MAP_EEPROM_SECTOR1);
+    if (erases0 + 1 < erases1 || erases1 + 1 < erases0) {
+        failReason = "uneven wear";
+        return 0;
+    }
+
+    Host_Restart();
+    return Eeprom_Read(EEPROM_KEY_ALARM_COUNT, 0) == writes;
+}
+
+/* در مدت نوشتن جدول firmware جواب می‌دهد؛ بعد از جابه‌جایی فقط تصویر تازه */
+static int Scenario_ConfigFlips(void)
+{
+    static uint64_t image[1024];
+    uint32_t length = Host_BuildConfig((uint8_t *)image, "5555", 7);
+    EventLogRecord_t record;
+    uint16_t userId;
+
+    if (Config_GetVersion() != 0 || !Config_Begin(length)) return 0;
+    Config_Write(image, CONFIG_STAGE_SIZE);
+    Host_Arm();
+    if (!Host_Expect(SYSTEM_ARMED, "System ARMED") || Config_GetVersion() != 0) return 0;
+
+    for (uint32_t sent = CONFIG_STAGE_SIZE; sent < length; Host_RunFor(TASK_STORAGE_PERIOD)) {
+        sent += Config_Write((const uint8_t *)image + sent, length - sent);
+    }
+    if (!Config_Commit(Host_ConfigCrc(image, length)) || !Host_WaitConfig(1)) return 0;
+    if (!Host_ExpectLog(0, EVENTLOG_CONFIG, &record) || record.data != 1) return 0;
+    if (Users_Count() != 1 || Users_Verify("1234", 4, &userId)) {
+        failReason = "old users";
+        return 0;
+    }
+
+    /* کارت خط 1 حالا باطل است؛ رمز تازه آلارم را خاموش می‌کند */
+    Host_Card(1);
+    if (!Host_Expect(SYSTEM_ALARM, "!! ALARM !!")) return 0;
+    Host_Type("5555");
+    Host_RunFor(SECURITY_PIN_SHOW_MS + 50);
+    if (!Host_Expect(SYSTEM_ACCESS_GRANTED, NULL) || Security_GetLastUser() != 7) return 0;
+
+    Host_Restart();
+    return Config_GetVersion() == 1 && Users_Verify("5555", 4, &userId) && userId == 7;
+}
+
+/* پایگاه کارت همراه کاربران عوض می‌شود: همان کارت‌های firmware، همه
+ * مسدود؛ کارت خط 2 دیگر غیرفعال نمی‌کند. قالب دیگر پذیرفته نمی‌شود */
+static int Scenario_ConfigCards(void)
+{
+    static const CardUid_t line2 = {7, {0x04, 0x5F, 0x11, 0x92, 0x3A, 0x6E, 0x80}};
+    static uint64_t image[1024];
+    uint32_t length = Host_AddCards((uint8_t *)image, Host_BuildConfig((uint8_t *)image, "5555", 7));
+    uint32_t count = Cards_Count();
+    ConfigLayout_t *layout = (ConfigLayout_t *)image;
+    ConfigStats_t stats;
+    uint16_t attributes;
+
+    if (!Host_SendConfig((const uint8_t *)image, length) || !Host_WaitConfig(1)) return 0;
+    if (Cards_Count() != count || !Cards_Lookup(&line2, &attributes) || attributes != CARD_ATTR_NONE) {
+        failReason = "config cards";
+        return 0;
+    }
+    Host_Type("5555");
+    Host_RunFor(SECURITY_PIN_SHOW_MS + SECURITY_GRANTED_SHOW_MS + 100);
+    Host_Card(2);
+    if (!Host_Expect(SYSTEM_ALARM, "!! ALARM !!")) return 0;
+
+    Host_Restart();
+    if (Config_GetVersion() != 1 || !Cards_Lookup(&line2, &attributes) || attributes != CARD_ATTR_NONE) {
+        failReason = "config cards after reset";
+        return 0;
+    }
+
+    layout->cardsFormat = CONFIG_CARDS_FORMAT + 1U;
+    if (!Host_SendConfig((const uint8_t *)image, length)) return 0;
+    Host_RunFor(TASK_STORAGE_PERIOD * 300);
+    Config_GetStats(&stats);
+    return Config_GetUpdateState() == CONFIG_FAILED && stats.rejected == 1 && Config_GetVersion() == 1;
+}
+
+/* نسخه 3 روی slot 0 پاک می‌شود؛ reset پیش از magic نسخه 2 را نگه می‌دارد */
+static int Scenario_ConfigInterrupted(void)
+{
+    static uint64_t image[1024];
+    uint16_t userId;
+    uint32_t length = Host_BuildConfig((uint8_t *)image, "5555", 7);
+
+    if (!Host_SendConfig((const uint8_t *)image, length) || !Host_WaitConfig(1)) return 0;
+    length = Host_BuildConfig((uint8_t *)image, "6666", 8);
+    if (!Host_SendConfig((const uint8_t *)image, length) || !Host_WaitConfig(2)) return 0;
+    if (Mock_FlashEraseCount(FLASH_MAP_CONFIG_SECTOR0) != 0) {
+        failReason = "erase of blank slot";
+        return 0;
+    }
+
+    length = Host_BuildConfig((uint8_t *)image, "7777", 9);
+    if (!Config_Begin(length) || Config_GetUpdateState() != CONFIG_ERASING) return 0;
+    Host_RunFor(TASK_STORAGE_PERIOD * 2);
+    if (Config_GetUpdateState() != CONFIG_RECEIVING || Mock_FlashEraseCount(FLASH_MAP_CONFIG_SECTOR0) != 1) {
+        failReason = "quiet erase";
+        return 0;
+    }
+    Config_Write(image, length / 2U);
+    Host_RunFor(TASK_STORAGE_PERIOD * 20);
+    Host_Restart();
+    if (Config_GetVersion() != 2 || !Users_Verify("6666", 4, &userId) || userId != 8) {
+        failReason = "interrupted image";
+        return 0;
+    }
+
+    if (!Host_SendConfig((const uint8_t *)image, length) || !Host_WaitConfig(3)) return 0;
+    return Users_Verify("7777", 4, &userId) && userId == 9;
+}
+
+/* CRC فرستنده با آنچه در flash نشسته نمی‌خواند: جابه‌جایی انجام نمی‌شود */
+static int Scenario_ConfigBadCrc(void)
+{
+    static uint64_t image[1024];
+    uint32_t length = Host_BuildConfig((uint8_t *)image, "5555", 7);
+    ConfigStats_t stats;
+
+    if (!Config_Begin(length)) return 0;
+    for (uint32_t sent = 0; sent < length; Host_RunFor(TASK_STORAGE_PERIOD)) {
+        sent += Config_Write((const uint8_t *)image + sent, length - sent);
+    }
+    if (!Config_Commit(Host_ConfigCrc(image, length) ^ 1U)) return 0;
+    Host_RunFor(TASK_STORAGE_PERIOD * 2);
+    Config_GetStats(&stats);
+    if (Config_GetUpdateState() != CONFIG_FAILED || stats.rejected != 1 || Config_GetVersion() != 0) {
+        failReason = "bad CRC accepted";
+        return 0;
+    }
+    return Host_SendConfig((const uint8_t *)image, length) && Host_WaitConfig(1);
+}
+
+/* بیتی از slot فعال پاک می‌شود: بررسی دوره‌ای گزارش می‌دهد و راه‌اندازی بعدی
+ * به جدول‌های firmware برمی‌گردد */
+static int Scenario_IntegrityConfig(void)
+{
+    static uint64_t image[1024];
+    uint32_t length = Host_BuildConfig((uint8_t *)image, "5555", 7);
+    EventLogRecord_t record;
+
+    if (!Host_SendConfig((const uint8_t *)image, length) || !Host_WaitConfig(1)) return 0;
+    if (Integrity_GetStatus(INTEGRITY_CONFIG) != INTEGRITY_OK) {
+        failReason = "not watched";
+        return 0;
+    }
+
+    HAL_FLASH_Unlock();
+    HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, FLASH_MAP_CONFIG_ADDR0 + CONFIG_HEADER_SIZE + sizeof(ConfigLayout_t), 0);
+    HAL_FLASH_Lock();
+    Host_RunFor(INTEGRITY_RECHECK_MS);
+    Host_RunFor(1000);                          /* بیداری بعد از موعد */
+    if (Integrity_GetStatus(INTEGRITY_CONFIG) != INTEGRITY_CORRUPT) {
+        failReason = "corruption missed";
+        return 0;
+    }
+    if (!Host_ExpectLog(0, EVENTLOG_INTEGRITY, &record) || record.detail != INTEGRITY_CONFIG) return 0;
+
+    Host_Restart();
+    return Config_GetVersion() == 0 && Integrity_GetStatus(INTEGRITY_CONFIG) == INTEGRITY_UNKNOWN;
+}
+
+/* S3 پر و مهر می‌شود؛ بعد از reset در برش‌های پس‌زمینه دوباره بررسی می‌شود */
+static int Scenario_IntegrityLogSeal(void)
+{
+    const uint32_t records = FLASH_MAP_LOG_SIZE0 / EVENTLOG_RECORD_SIZE;
+    const EventLogHeader_t *header = (const EventLogHeader_t *)FLASH_READ_PTR(FLASH_MAP_LOG_ADDR0);
+    IntegrityStats_t stats;
+
+    for (uint32_t i = 0; i < records; i++) {
+        EventLog_Append(EVENTLOG_MOTION, 0, i);
+        if (EventLog_NeedsErase()) {
+            Host_RunFor(TASK_STORAGE_PERIOD + 10);
+        }
+    }
+    EventLog_Flush();
+    if (header->sealedCrc == 0xFFFFFFFFUL || Integrity_GetStatus(INTEGRITY_LOG0) != INTEGRITY_OK) {
+        failReason = "not sealed";
+        return 0;
+    }
+
+    Host_Restart();
+    if (Integrity_GetStatus(INTEGRITY_LOG0) != INTEGRITY_UNKNOWN || Integrity_IsIdle()) {
+        failReason = "boot check pending";
+        return 0;
+    }
+    Host_RunFor(1000);
+    Integrity_GetStats(&stats);
+    /* S3 و سه جدول firmware */
+    if (Integrity_GetStatus(INTEGRITY_LOG0) != INTEGRITY_OK || stats.checks != 4 || stats.mismatches != 0
+        || Integrity_ThroughputKBps() == 0) {
+        failReason = "background check";
+        return 0;
+    }
+    return Host_Expect(SYSTEM_DISARMED, "System DISARMED");
+}
+
+/* دستگاه نو: جدول‌های تولیدشده با CRC ابزار تولید در اولین سکون بررسی می‌شوند */
+static int Scenario_IntegrityTables(void)
+{
+    IntegrityStats_t stats;
+
+    if (Integrity_GetStatus(INTEGRITY_CARDS) != INTEGRITY_UNKNOWN || Integrity_IsIdle()) {
+        failReason = "not watched";
+        return 0;
+    }
+    Host_RunFor(1000);
+    Integrity_GetStats(&stats);
+    if (Integrity_GetStatus(INTEGRITY_CARDS) != INTEGRITY_OK || Integrity_GetStatus(INTEGRITY_USERS) != INTEGRITY_OK
+        || Integrity_GetStatus(INTEGRITY_REVOKE) != INTEGRITY_OK || stats.checks != 3 || stats.mismatches != 0) {
+        failReason = "table CRC";
+        return 0;
+    }
+    return 1;
+}
+
+static const Scenario_t scenarios[] = {
+    {"arm with PIN",                Scenario_ArmWithPin},
+    {"wrong PIN",                   Scenario_WrongPin},
+    {"clear key",                   Scenario_ClearKey},
+    {"valid card disarms",          Scenario_CardDisarms},
+    {"7-byte UID card disarms",     Scenario_SevenByteCard},
+    {"invalid card alarm",          Scenario_InvalidCardAlarm},
+    {"revoked card alarm",          Scenario_RevokedCardAlarm},
+    {"motion alarm, PIN disarms",   Scenario_MotionAlarmThenPin},
+    {"disarmed ignores sensors",    Scenario_DisarmedIgnoresSensors},
+    {"motion during PIN entry",     Scenario_MotionDuringPinEntry},
+    {"6-digit PIN of user 2",       Scenario_LongPinUser},
+    {"prefix of a longer PIN",      Scenario_PrefixOfLongPin},
+    {"'=' verifies at once",        Scenario_EnterVerifiesNow},
+    {"event log records access",    Scenario_EventLogRecords},
+    {"event log survives reset",    Scenario_EventLogSurvivesReset},
+    {"event log rotates sectors",   Scenario_EventLogRotates},
+    {"event log burst keeps order", Scenario_EventLogBurst},
+    {"event log batches writes",    Scenario_EventLogBatches},
+    {"settings survive reset",      Scenario_SettingsSurviveReset},
+    {"eeprom compacts",             Scenario_EepromCompacts},
+    {"alarm counted once",          Scenario_AlarmCountedOnce},
+    {"config update flips slot",    Scenario_ConfigFlips},
+    {"config carries card database", Scenario_ConfigCards},
+    {"config update interrupted",   Scenario_ConfigInterrupted},
+    {"config commit checks CRC",    Scenario_ConfigBadCrc},
+    {"integrity: corrupted config", Scenario_IntegrityConfig},
+    {"integrity: sealed log sector",Scenario_IntegrityLogSeal},
+    {"integrity: firmware tables",  Scenario_IntegrityTables},
+};
+
+#define SCENARIO_COUNT  (sizeof(scenarios) / sizeof(scenarios[0]))
+
+int main(int argc, char **argv)
+{
+    uint32_t iterations = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 1;
+    uint32_t failures = 0;
+    uint64_t virtualUs = 0;
+    clock_t start = clock();
+
+    for (uint32_t it = 0; it < iterations; it++) {
+        for (size_t i = 0; i < SCENARIO_COUNT; i++) {
+            Host_Boot();
+            failReason = NULL;
+            if (!scenarios[i].run()) {
+                failures++;
+                if (failures <= 10) {
+                    printf("FAIL  %-28s (%s) state=%d lcd=\"%s\"\n", scenarios[i].name,
+                           failReason ? failReason : "check", (int)Security_GetState(), Mock_LcdLine(0));
+                }
+            } else if (it == 0) {
+                printf("ok    %s\n", scenarios[i].name);
+            }
+            virtualUs += Mock_Micros();
+        }
+    }
+
+    double wallMs = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+    printf("\n%lu scenarios, %lu failed\n", (unsigned long)(iterations * SCENARIO_COUNT), (unsigned long)failures);
+    printf("virtual time %.1f s, wall time %.1f ms\n", (double)virtualUs / 1e6, wallMs);
+
+    return failures ? 1 : 0;
+}
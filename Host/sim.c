@@ -0,0 +1,227 @@
+/* =================================================================
+ * شبیه‌ساز رویداد-گسسته - پیاده‌سازی
+ *
+ * حلقه اصلی: ورودی‌های سررسیده اعمال می‌شوند، سپس یک دور Scheduler_Run.
+ * افق پرش زمان (Mock_SetHorizon) زمان ورودی بعدی است؛ Scheduler_Idle
+ * بیلد host فقط وقتی همه ماژول‌ها بی‌کارند تا آن‌جا می‌پرد.
+ * حسگرها (برخلاف کیپد) وقفه ندارند و فقط با تسک دوره‌ای دیده می‌شوند؛
+ * پس بعد از هر ورودی تا یک دوره کامل تسک حسگرها پرشی انجام نمی‌شود.
+ *
+ * تأخیر: هر ورودی فعال‌کننده (فشردن کلید، شروع کارت، لبه PIR) منتظر
+ * می‌ماند تا Security_EventHandled رویداد همان کلاس را گزارش کند. ورودی‌هایی که هیچ رویدادی نساختند (مثلاً کلید وسط
+ * debounce رها شده) با رسیدن ورودی بعدی همان کلاس lost شمرده می‌شوند.
+ * ================================================================= */
+
+#include "sim.h"
+#include "scheduler.h"
+#include "security.h"
+#include "bench.h"
+
+typedef struct {
+    uint64_t time;
+    uint32_t seq;           /* ترتیب ثبت برای زمان‌های برابر */
+    SimEventType_t type;
+    char arg;
+} SimEvent_t;
+
+static const uint16_t cardPins[3] = {RFID_CARD1_Pin, RFID_CARD2_Pin, RFID_CARD3_Pin};
+
+static SimEvent_t heap[SIM_MAX_EVENTS];
+static uint16_t heapSize = 0;
+static uint32_t nextSeq = 0;
+static uint32_t stimuli = 0;
+static uint64_t noSkipUntil = 0;    /* تا این زمان پرش ممنوع است */
+
+static uint64_t pendingSince[SIM_CLASS_COUNT];     /* زمان ورودی در انتظار */
+static uint8_t pendingValid[SIM_CLASS_COUNT];
+static SimLatency_t latency[SIM_CLASS_COUNT];
+
+/* ================================================
+ * min-heap بر اساس (time، seq)
+ * ================================================ */
+static int Sim_Before(const SimEvent_t *a, const SimEvent_t *b)
+{
+    return (a->time < b->time) || (a->time == b->time && a->seq < b->seq);
+}
+
+static void Sim_Swap(uint16_t a, uint16_t b)
+{
+    SimEvent_t tmp = heap[a];
+    heap[a] = heap[b];
+    heap[b] = tmp;
+}
+
+static void Sim_Pop(SimEvent_t *event)
+{
+    *event = heap[0];
+    heap[0] = heap[--heapSize];
+
+    uint16_t i = 0;
+    for (;;) {
+        uint16_t left = 2 * i + 1;
+        uint16_t right = left + 1;
+        uint16_t smallest = i;
+        if (left < heapSize && Sim_Before(&heap[left], &heap[smallest])) smallest = left;
+        if (right < heapSize && Sim_Before(&heap[right], &heap[smallest])) smallest = right;
+        if (smallest == i) {
+            break;
+        }
+        Sim_Swap(i, smallest);
+        i = smallest;
+    }
+}
+
+void Sim_Init(void)
+{
+    heapSize = 0;
+    nextSeq = 0;
+    stimuli = 0;
+    noSkipUntil = 0;
+    for (int c = 0; c < SIM_CLASS_COUNT; c++) {
+        pendingValid[c] = 0;
+        latency[c].count = 0;
+        latency[c].minUs = UINT32_MAX;
+        latency[c].maxUs = 0;
+        latency[c].totalUs = 0;
+        latency[c].lost = 0;
+    }
+}
+
+uint8_t Sim_Schedule(uint64_t timeUs, SimEventType_t type, char arg)
+{
+    if (heapSize >= SIM_MAX_EVENTS) {
+        return 0;
+    }
+
+    uint16_t i = heapSize++;
+    heap[i].time = timeUs;
+    heap[i].seq = nextSeq++;
+    heap[i].type = type;
+    heap[i].arg = arg;
+
+    while (i > 0 && Sim_Before(&heap[i], &heap[(i - 1) / 2])) {
+        Sim_Swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+    return 1;
+}
+
+uint8_t Sim_Pending(void)
+{
+    return heapSize > 0;
+}
+
+/* ================================================
+ * اندازه‌گیری تأخیر
+ * ================================================ */
+static void Sim_StartMeasure(SimClass_t cls, uint64_t timeUs)
+{
+    static const BenchSource_t benchSource[SIM_CLASS_COUNT] = {
+        [SIM_CLASS_KEY]    = BENCH_SRC_KEY,
+        [SIM_CLASS_CARD]   = BENCH_SRC_CARD,
+        [SIM_CLASS_MOTION] = BENCH_SRC_PIR,
+    };
+
+    /* بنچمارک هم از لحظه دقیق ورودی می‌شمارد، نه از اولین مشاهده firmware */
+    Bench_StimulusAt(benchSource[cls], (uint32_t)(timeUs * MOCK_CPU_MHZ));
+
+    /* ورودی قبلی همین کلاس که هنوز رویدادی نساخته، lost است */
+    if (pendingValid[cls]) {
+        latency[cls].lost++;
+    }
+    pendingSince[cls] = timeUs;
+    pendingValid[cls] = 1;
+}
+
+void Security_EventHandled(const SecurityEvent_t *event)
+{
+    SimClass_t cls;
+
+    switch (event->type) {
+        case SEC_EVENT_KEY_DIGIT:
+        case SEC_EVENT_KEY_CLEAR:
+        case SEC_EVENT_KEY_ENTER:
+            cls = SIM_CLASS_KEY;
+            break;
+        case SEC_EVENT_CARD_VALID:
+        case SEC_EVENT_CARD_INVALID:
+            cls = SIM_CLASS_CARD;
+            break;
+        case SEC_EVENT_MOTION:
+            cls = SIM_CLASS_MOTION;
+            break;
+        default:
+            return; // رویداد داخلی
+    }
+
+    if (!pendingValid[cls]) {
+        return;
+    }
+    pendingValid[cls] = 0;
+
+    uint32_t us = (uint32_t)(Mock_Micros() - pendingSince[cls]);
+    SimLatency_t *l = &latency[cls];
+    l->count++;
+    l->totalUs += us;
+    if (us < l->minUs) l->minUs = us;
+    if (us > l->maxUs) l->maxUs = us;
+}
+
+const SimLatency_t* Sim_GetLatency(SimClass_t cls)
+{
+    return &latency[cls];
+}
+
+uint32_t Sim_GetStimuli(void)
+{
+    return stimuli;
+}
+
+/* ================================================
+ * حلقه اصلی
+ * ================================================ */
+static void Sim_Apply(const SimEvent_t *event)
+{
+    stimuli++;
+
+    switch (event->type) {
+        case SIM_KEY_DOWN:
+            Sim_StartMeasure(SIM_CLASS_KEY, event->time);
+            Mock_KeyDown(event->arg);
+            break;
+        case SIM_KEY_UP:
+            Mock_KeyUp(event->arg);
+            break;
+        case SIM_CARD_ON:
+            Sim_StartMeasure(SIM_CLASS_CARD, event->time);
+            Mock_SetInput(GPIOB, cardPins[event->arg - 1], GPIO_PIN_RESET);
+            break;
+        case SIM_CARD_OFF:
+            Mock_SetInput(GPIOB, cardPins[event->arg - 1], GPIO_PIN_SET);
+            break;
+        case SIM_PIR_ON:
+            Sim_StartMeasure(SIM_CLASS_MOTION, event->time);
+            Mock_SetInput(PIR_SENSOR_GPIO_Port, PIR_SENSOR_Pin, GPIO_PIN_SET);
+            break;
+        case SIM_PIR_OFF:
+            Mock_SetInput(PIR_SENSOR_GPIO_Port, PIR_SENSOR_Pin, GPIO_PIN_RESET);
+            break;
+    }
+}
+
+void Sim_RunUntil(uint64_t endUs)
+{
+    SimEvent_t event;
+
+    while (Mock_Micros() < endUs) {
+        while (heapSize > 0 && heap[0].time <= Mock_Micros()) {
+            Sim_Pop(&event);
+            Sim_Apply(&event);
+            noSkipUntil = Mock_Micros() + SIM_INPUT_SETTLE_US;
+        }
+
+        uint64_t next = (heapSize > 0 && heap[0].time < endUs) ? heap[0].time : endUs;
+        Mock_SetHorizon(Mock_Micros() < noSkipUntil ? Mock_Micros() : next);
+        Scheduler_Run();
+    }
+}
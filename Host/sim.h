@@ -0,0 +1,49 @@
+/* =================================================================
+ * شبیه‌ساز رویداد-گسسته روی ساعت مجازی
+ *
+ * - ورودی‌ها (کلید، کارت، PIR) با زمان مطلق (us) در یک heap قرار می‌گیرند
+ * - بین ورودی‌ها، اگر سیستم بی‌کار باشد زمان مستقیم به ورودی بعدی می‌پرد
+ * - تأخیر هر ورودی تا پردازش رویداد متناظرش در ماشین حالت ثبت می‌شود
+ * ================================================================= */
+
+#ifndef __SIM_H
+#define __SIM_H
+
+#include "main.h"
+#include "app.h"
+
+#define SIM_MAX_EVENTS      256
+#define SIM_INPUT_SETTLE_US ((TASK_SENSORS_PERIOD + 1) * 1000ULL)
+
+typedef enum {
+    SIM_KEY_DOWN,
+    SIM_KEY_UP,
+    SIM_CARD_ON,            /* arg = شماره کارت 1..3 */
+    SIM_CARD_OFF,
+    SIM_PIR_ON,
+    SIM_PIR_OFF
+} SimEventType_t;
+
+typedef enum {
+    SIM_CLASS_KEY,
+    SIM_CLASS_CARD,
+    SIM_CLASS_MOTION,
+    SIM_CLASS_COUNT
+} SimClass_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint64_t totalUs;
+    uint32_t lost;          /* ورودی‌هایی که رویدادی تولید نکردند */
+} SimLatency_t;
+
+void Sim_Init(void);
+uint8_t Sim_Schedule(uint64_t timeUs, SimEventType_t type, char arg);
+uint8_t Sim_Pending(void);
+void Sim_RunUntil(uint64_t endUs);
+const SimLatency_t* Sim_GetLatency(SimClass_t cls);
+uint32_t Sim_GetStimuli(void);
+
+#endif /* __SIM_H */
@@ -0,0 +1,230 @@
+/* =================================================================
+ * تولید جدول کاربران (Core/Src/users_table.c) از فهرست رمزها
+ *
+ * ورودی: هر خط "<شناسه> <رمز>"؛ خط خالی و # نادیده گرفته می‌شوند.
+ * salt ها و pepper از /dev/urandom، یا با seed تکرارپذیر (فقط برای تست).
+ * خروجی روی stdout. استفاده:
+ *   ./users_gen users.txt [seed] > ../Core/Src/users_table.c
+ * ================================================================= */
+
+#include "users.h"
+#include "hash.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define USERS_GEN_MAX   8192
+
+typedef struct {
+    uint16_t id;
+    char pin[USERS_PIN_MAX_LENGTH + 1];
+    uint16_t bucket;
+    UserRecord_t record;
+} GenUser_t;
+
+static GenUser_t users[USERS_GEN_MAX];
+static uint32_t userCount = 0;
+static uint8_t pepper[USERS_PEPPER_SIZE];
+static uint32_t rngState = 0;
+static FILE *urandom = NULL;
+
+static void Gen_Random(uint8_t *out, size_t length)
+{
+    if (urandom != NULL) {
+        if (fread(out, 1, length, urandom) == length) {
+            return;
+        }
+        fprintf(stderr, "users_gen: /dev/urandom read failed\n");
+        exit(1);
+    }
+    for (size_t i = 0; i < length; i++) {
+        rngState = rngState * 1664525U + 1013904223U;
+        out[i] = (uint8_t)(rngState >> 24);
+    }
+}
+
+static int Gen_Fail(const char *file, int line, const char *reason)
+{
+    fprintf(stderr, "%s:%d: %s\n", file, line, reason);
+    return 1;
+}
+
+static int Gen_Read(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char text[128];
+    int line = 0;
+
+    if (f == NULL) {
+        perror(path);
+        return 1;
+    }
+
+    while (fgets(text, sizeof(text), f) != NULL) {
+        unsigned long id;
+        char pin[32];
+
+        line++;
+        if (text[0] == '#' || sscanf(text, "%lu %31s", &id, pin) != 2) {
+            continue;
+        }
+
+        size_t length = strlen(pin);
+        if (length < USERS_PIN_MIN_LENGTH || length > USERS_PIN_MAX_LENGTH) {
+            return Gen_Fail(path, line, "PIN length out of range");
+        }
+        if (strspn(pin, "0123456789") != length) {
+            return Gen_Fail(path, line, "PIN must be digits only");
+        }
+        if (id >= USERS_INVALID_ID) {
+            return Gen_Fail(path, line, "user id out of range");
+        }
+        if (userCount >= USERS_GEN_MAX) {
+            return Gen_Fail(path, line, "too many users");
+        }
+        for (uint32_t i = 0; i < userCount; i++) {
+            if (users[i].id == id) {
+                return Gen_Fail(path, line, "duplicate user id");
+            }
+            if (strcmp(users[i].pin, pin) == 0) {
+                return Gen_Fail(path, line, "PIN already used by another user");
+            }
+        }
+
+        users[userCount].id = (uint16_t)id;
+        strcpy(users[userCount].pin, pin);
+        userCount++;
+    }
+
+    fclose(f);
+    return 0;
+}
+
+/* همان محاسبه Users_Verify */
+static void Gen_Hash(GenUser_t *u)
+{
+    uint8_t key[HASH_KEY_SIZE] = {0};
+
+    memcpy(key, pepper, USERS_PEPPER_SIZE);
+    u->bucket = (uint16_t)(Hash_SipHash(key, u->pin, USERS_PREFIX_LENGTH) % USERS_BUCKETS);
+
+    u->record.id = u->id;
+    u->record.reserved = 0;
+    Gen_Random(u->record.salt, USERS_SALT_SIZE);
+    memcpy(key, u->record.salt, USERS_SALT_SIZE);
+    memcpy(key + USERS_SALT_SIZE, pepper, USERS_PEPPER_SIZE);
+    u->record.hash = Hash_SipHash(key, u->pin, strlen(u->pin));
+}
+
+static int Gen_CompareBucket(const void *a, const void *b)
+{
+    const GenUser_t *ua = (const GenUser_t *)a;
+    const GenUser_t *ub = (const GenUser_t *)b;
+
+    if (ua->bucket != ub->bucket) {
+        return (ua->bucket < ub->bucket) ? -1 : 1;
+    }
+    return (ua->id < ub->id) ? -1 : (ua->id > ub->id);
+}
+
+static void Gen_Write(const char *source)
+{
+    uint16_t index[USERS_BUCKETS + 2] = {0};
+    uint32_t fullest = 0;
+    uint32_t crc;
+
+    for (uint32_t i = 0; i < userCount; i++) {
+        index[users[i].bucket + 1]++;
+    }
+    for (uint32_t b = 0; b < USERS_BUCKETS; b++) {
+        if (index[b + 1] > fullest) {
+            fullest = index[b + 1];
+        }
+        index[b + 1] += index[b];
+    }
+    crc = Hash_Crc32(HASH_CRC_INITIAL, pepper, USERS_PEPPER_SIZE);
+    crc = Hash_Crc32(crc, index, sizeof(index));
+    for (uint32_t i = 0; i < userCount; i++) {
+        UserRecord_t r;                         /* همان که چاپ می‌شود، با فاصله‌های صفر */
+        memset(&r, 0, sizeof(r));
+        r.id = users[i].record.id;
+        memcpy(r.salt, users[i].record.salt, USERS_SALT_SIZE);
+        r.hash = users[i].record.hash;
+        crc = Hash_Crc32(crc, &r, sizeof(r));
+    }
+
+    printf("/* =================================================================\n");
+    printf(" * جدول کاربران - تولید شده با Host/users_gen از %s؛ دستی ویرایش نشود\n", source);
+    printf(" * %lu کاربر، پرترین سطل %lu رکورد (سقف %d)\n",
+           (unsigned long)userCount, (unsigned long)fullest, USERS_BUCKET_MAX);
+    printf(" * ================================================================= */\n\n");
+    printf("#include \"users.h\"\n\n");
+
+    printf("INTEGRITY_ALIGNED const uint8_t usersPepper[USERS_PEPPER_SIZE] = {");
+    for (int i = 0; i < USERS_PEPPER_SIZE; i++) {
+        printf("%s0x%02X", i ? ", " : "", pepper[i]);
+    }
+    printf("};\n\n");
+
+    printf("INTEGRITY_ALIGNED const uint16_t usersIndex[USERS_BUCKETS + 2] = {");
+    for (uint32_t b = 0; b <= USERS_BUCKETS + 1; b++) {
+        printf("%s%s%u", b ? "," : "", (b % 16) ? " " : "\n    ", index[b]);
+    }
+    printf("\n};\n\n");
+
+    /* آرایه خالی در C مجاز نیست */
+    printf("const UserRecord_t usersRecords[] = {\n");
+    for (uint32_t i = 0; i < userCount; i++) {
+        const UserRecord_t *r = &users[i].record;
+        printf("    {%u, 0, {", r->id);
+        for (int s = 0; s < USERS_SALT_SIZE; s++) {
+            printf("%s0x%02X", s ? ", " : "", r->salt[s]);
+        }
+        printf("}, 0x%016llXULL},\n", (unsigned long long)r->hash);
+    }
+    if (userCount == 0) {
+        printf("    {USERS_INVALID_ID, 0, {0}, 0},\n");
+    }
+    printf("};\n\n");
+    printf("const uint16_t usersCount = %lu;\n\n", (unsigned long)userCount);
+    printf("static const IntegritySpan_t spans[3] = {\n");
+    printf("    {usersPepper, sizeof(usersPepper)},\n    {usersIndex, sizeof(usersIndex)},\n");
+    printf("    {usersRecords, %lu},\n};\n\n", (unsigned long)(userCount * sizeof(UserRecord_t)));
+    printf("const IntegrityImage_t usersTableCrc = {spans, 3, 0x%08lX};\n", (unsigned long)crc);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s users.txt [seed]\n", argv[0]);
+        return 2;
+    }
+    if (argc > 2) {
+        rngState = (uint32_t)strtoul(argv[2], NULL, 0);
+    } else if ((urandom = fopen("/dev/urandom", "rb")) == NULL) {
+        perror("/dev/urandom");
+        return 1;
+    }
+
+    if (Gen_Read(argv[1]) != 0) {
+        return 1;
+    }
+
+    Gen_Random(pepper, sizeof(pepper));
+    for (uint32_t i = 0; i < userCount; i++) {
+        Gen_Hash(&users[i]);
+    }
+    qsort(users, userCount, sizeof(users[0]), Gen_CompareBucket);
+
+    for (uint32_t i = 0, run = 0; i < userCount; i++) {
+        run = (i > 0 && users[i].bucket == users[i - 1].bucket) ? run + 1 : 1;
+        if (run > USERS_BUCKET_MAX) {
+            fprintf(stderr, "users_gen: bucket %u holds more than %d users; raise USERS_BUCKETS\n",
+                    users[i].bucket, USERS_BUCKET_MAX);
+            return 1;
+        }
+    }
+
+    Gen_Write(argv[1]);
+    return 0;
+}